@@ -10,6 +10,7 @@
 *       void    ds1307_get_current_time(RTC_time_t* time)
 *       void    ds1307_set_current_date(RTC_date_t* date)
 *       void    ds1307_get_current_date(RTC_date_t* date)
+*       void    ds1307_set_i2c_speed(uint32_t scl_speed)
 *
 * NOTES :
 *       For further information about functions refer to the corresponding header file.
@@ -195,6 +196,15 @@ void ds1307_get_current_date(RTC_date_t* date){
     date->date = bcd_to_bin(ds1307_read(DS1307_ADDR_DATE));
 }
 
+void ds1307_set_i2c_speed(uint32_t scl_speed){
+
+    /* The timings can only be written with the peripheral disabled */
+    I2C_Enable(DS1307_I2C, DISABLE);
+    ds1307_I2CHandle.I2C_Config.I2C_SCLSpeed = scl_speed;
+    I2C_Init(&ds1307_I2CHandle);
+    I2C_Enable(DS1307_I2C, ENABLE);
+}
+
 /*****************************************************************************************************/
 /*                                       Static Function Definitions                                 */
 /*****************************************************************************************************/
@@ -146,4 +146,18 @@ void ds1307_set_current_date(RTC_date_t* date);
  */
 void ds1307_get_current_date(RTC_date_t* date);
 
+/**
+ * @fn ds1307_set_i2c_speed
+ *
+ * @brief function to change the SCL frequency of the I2C bus after ds1307_init.
+ *
+ * @param[in] scl_speed is the new frequency, from @I2C_SCLSPEED.
+ *
+ * @return void
+ *
+ * @note the DS1307 is specified up to 100 kHz (DS1307_I2C_SPEED), the fast mode speeds are only
+ *       meant for measurements such as the benchmark (src/bench.c).
+ */
+void ds1307_set_i2c_speed(uint32_t scl_speed);
+
 #endif /* DS1307_H */
@@ -13,65 +13,52 @@
 *       void    hd44780_display_return_home(void)
 *       void    hd44780_set_cursor(uint8_t row, uint8_t column)
 *       void    hd44780_display_clear(void)
+*       void    hd44780_display_shift(uint8_t direction)
+*       void    hd44780_page_set_cursor(uint8_t page, uint8_t row, uint8_t column)
+*       void    hd44780_page_flip(uint8_t page)
+*       uint8_t hd44780_page_get_hidden(void)
+*       void    hd44780_marquee_load(uint8_t row, char* msg)
+*       uint8_t hd44780_is_busy(void)
 *
 * NOTES :
 *       For further information about functions refer to the corresponding header file.
+*       The bus signals are driven by the transport selected with HD44780_TRANSPORT (hd44780_bus.h).
 *
 **/
 
 #include "hd44780.h"
-#include "stm32f446xx.h"
-#include "gpio_driver.h"
+#include "hd44780_bus.h"
 #include <stdint.h>
-#include <string.h>
+
+/* DDRAM column shown in the first visible position, changed by the display shift commands */
+static uint8_t hd44780_shift_offset = 0;
 
 /*****************************************************************************************************/
 /*                                       Static Function Prototypes                                  */
 /*****************************************************************************************************/
 
 /**
- * @fn write_4_bits
+ * @fn hd44780_write_byte
  *
- * @brief function to write four bits in the data line of HD44780.
+ * @brief function to write a byte to the HD44780 as two nibbles.
  *
- * @param[in] value to be written in the data line.
+ * @param[in] rs is the value of the register select signal (0 command, 1 data).
+ * @param[in] value to be written.
  *
  * @return void.
  */
-static void write_4_bits(uint8_t value);
+static void hd44780_write_byte(uint8_t rs, uint8_t value);
 
 /**
- * @fn hd44780_enable
+ * @fn hd44780_write_shift
  *
- * @brief function to enable the HD44780 device.
+ * @brief function to queue a display shift command and track the shift offset.
  *
- * @param[in] void.
+ * @param[in] direction @HD44780_SHIFT.
  *
  * @return void.
  */
-static void hd44780_enable(void);
-
-/**
- * @fn mdelay
- *
- * @brief function to count a number of miliseconds.
- *
- * @param[in] cnt is the number of miliseconds.
- *
- * @return void.
- */
-static void mdelay(uint32_t cnt);
-
-/**
- * @fn udelay
- *
- * @brief function to count a number of microseconds.
- *
- * @param[in] cnt is the number of microseconds.
- *
- * @return void.
- */
-static void udelay(uint32_t cnt);
+static void hd44780_write_shift(uint8_t direction);
 
 /*****************************************************************************************************/
 /*                                       Public API Definitions                                      */
@@ -79,66 +66,25 @@ static void udelay(uint32_t cnt);
 
 void hd44780_init(void){
 
-    /* Configure the GPIO pins which are used for LCD connections */
-    GPIO_Handle_t hd44780_signal;
-
-    memset(&hd44780_signal, 0, sizeof(hd44780_signal));
-
-    hd44780_signal.pGPIOx = HD44780_GPIO_PORT;
-    hd44780_signal.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_OUT;
-    hd44780_signal.GPIO_PinConfig.GPIO_PinOPType = GPIO_OP_TYPE_PP;
-    hd44780_signal.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_NO_PULL;
-    hd44780_signal.GPIO_PinConfig.GPIO_PinSpeed = GPIO_SPEED_FAST;
-
-    hd44780_signal.GPIO_PinConfig.GPIO_PinNumber = HD44780_GPIO_RS;
-    GPIO_Init(&hd44780_signal);
-
-    hd44780_signal.GPIO_PinConfig.GPIO_PinNumber = HD44780_GPIO_RW;
-    GPIO_Init(&hd44780_signal);
-
-    hd44780_signal.GPIO_PinConfig.GPIO_PinNumber = HD44780_GPIO_EN;
-    GPIO_Init(&hd44780_signal);
-
-    hd44780_signal.GPIO_PinConfig.GPIO_PinNumber = HD44780_GPIO_D4;
-    GPIO_Init(&hd44780_signal);
-
-    hd44780_signal.GPIO_PinConfig.GPIO_PinNumber = HD44780_GPIO_D5;
-    GPIO_Init(&hd44780_signal);
-
-    hd44780_signal.GPIO_PinConfig.GPIO_PinNumber = HD44780_GPIO_D6;
-    GPIO_Init(&hd44780_signal);
-
-    hd44780_signal.GPIO_PinConfig.GPIO_PinNumber = HD44780_GPIO_D7;
-    GPIO_Init(&hd44780_signal);
-
-    /* Set pins to 0 */
-    GPIO_WriteToOutputPin(HD44780_GPIO_PORT, HD44780_GPIO_RS, GPIO_PIN_RESET);
-    GPIO_WriteToOutputPin(HD44780_GPIO_PORT, HD44780_GPIO_RW, GPIO_PIN_RESET);
-    GPIO_WriteToOutputPin(HD44780_GPIO_PORT, HD44780_GPIO_EN, GPIO_PIN_RESET);
-    GPIO_WriteToOutputPin(HD44780_GPIO_PORT, HD44780_GPIO_D4, GPIO_PIN_RESET);
-    GPIO_WriteToOutputPin(HD44780_GPIO_PORT, HD44780_GPIO_D5, GPIO_PIN_RESET);
-    GPIO_WriteToOutputPin(HD44780_GPIO_PORT, HD44780_GPIO_D6, GPIO_PIN_RESET);
-    GPIO_WriteToOutputPin(HD44780_GPIO_PORT, HD44780_GPIO_D7, GPIO_PIN_RESET);
+    /* Configure the peripherals which are used for LCD connections */
+    hd44780_bus_init();
 
     /* Do the HD44780 initialization */
-    mdelay(40);
-
-    /* Set RS to 0 for HD44780 command */
-    GPIO_WriteToOutputPin(HD44780_GPIO_PORT, HD44780_GPIO_RS, GPIO_PIN_RESET);
+    hd44780_bus_delay_us(40000);
 
-    /* Set RW to 0, Writing to HD44780 */
-    GPIO_WriteToOutputPin(HD44780_GPIO_PORT, HD44780_GPIO_RW, GPIO_PIN_RESET);
+    hd44780_bus_write_nibble(0, 0x03);
 
-    write_4_bits(0x03);
+    hd44780_bus_delay_us(5000);
 
-    mdelay(5);
+    hd44780_bus_write_nibble(0, 0x03);
 
-    write_4_bits(0x03);
+    hd44780_bus_delay_us(150);
 
-    udelay(150);
+    hd44780_bus_write_nibble(0, 0x03);
+    hd44780_bus_exec_wait();
 
-    write_4_bits(0x03);
-    write_4_bits(0x02);
+    hd44780_bus_write_nibble(0, 0x02);
+    hd44780_bus_exec_wait();
 
     /* Set command */
     hd44780_send_command(HD44780_CMD_4DL_2N_5X8F);
@@ -155,47 +101,41 @@ void hd44780_init(void){
 
 void hd44780_send_command(uint8_t cmd){
 
-    /* Set RS to 0 for HD44780 command */
-    GPIO_WriteToOutputPin(HD44780_GPIO_PORT, HD44780_GPIO_RS, GPIO_PIN_RESET);
+    /* RS to 0 for HD44780 command */
+    hd44780_write_byte(0, cmd);
 
-    /* Set RW to 0 for writing */
-    GPIO_WriteToOutputPin(HD44780_GPIO_PORT, HD44780_GPIO_RW, GPIO_PIN_RESET);
-
-    /* Send higher nibble */
-    write_4_bits(cmd >> 4);
-    /* Send lower nibble */
-    write_4_bits(cmd & 0x0F);
+    hd44780_bus_flush();
 }
 
 void hd44780_print_char(uint8_t data){
 
-    /* Set RS to 1 for HD44780 user data */
-    GPIO_WriteToOutputPin(HD44780_GPIO_PORT, HD44780_GPIO_RS, GPIO_PIN_SET);
-
-    /* Set RW to 0 for writing */
-    GPIO_WriteToOutputPin(HD44780_GPIO_PORT, HD44780_GPIO_RW, GPIO_PIN_RESET);
+    /* RS to 1 for HD44780 user data */
+    hd44780_write_byte(1, data);
 
-    /* Send higher nibble */
-    write_4_bits(data >> 4);
-    /* Send lower nibble */
-    write_4_bits(data & 0x0F);
+    hd44780_bus_flush();
 }
 
 void hd44780_print_string(char* msg){
 
     do{
-        hd44780_print_char((uint8_t)*msg++);
+        hd44780_write_byte(1, (uint8_t)*msg++);
     }
     while(*msg != '\0');
+
+    /* The whole string is queued before starting the transmission */
+    hd44780_bus_flush();
 }
 
 void hd44780_display_return_home(void){
 
-    /* Send display return to home command */
-    hd44780_send_command(HD44780_CMD_DIS_RETURN_HOME);
+    /* Send display return to home command, it also cancels the display shift */
+    hd44780_write_byte(0, HD44780_CMD_DIS_RETURN_HOME);
+    hd44780_shift_offset = 0;
 
     /* Wait */
-    mdelay(2);
+    hd44780_bus_delay_us(2000);
+
+    hd44780_bus_flush();
 }
 
 void hd44780_set_cursor(uint8_t row, uint8_t column){
@@ -219,45 +159,113 @@ void hd44780_set_cursor(uint8_t row, uint8_t column){
 
 void hd44780_display_clear(void){
 
-    /* Send display clear command */
-    hd44780_send_command(HD44780_CMD_DIS_CLEAR);
+    /* Send display clear command, it also cancels the display shift */
+    hd44780_write_byte(0, HD44780_CMD_DIS_CLEAR);
+    hd44780_shift_offset = 0;
 
     /* Wait */
-    mdelay(2);
+    hd44780_bus_delay_us(2000);
+
+    hd44780_bus_flush();
 }
 
-/*****************************************************************************************************/
-/*                                       Static Function Definitions                                 */
-/*****************************************************************************************************/
+void hd44780_display_shift(uint8_t direction){
 
-static void write_4_bits(uint8_t value){
+    hd44780_write_shift(direction);
 
-    GPIO_WriteToOutputPin(HD44780_GPIO_PORT, HD44780_GPIO_D4, ((value >> 0) & 0x1));
-    GPIO_WriteToOutputPin(HD44780_GPIO_PORT, HD44780_GPIO_D5, ((value >> 1) & 0x1));
-    GPIO_WriteToOutputPin(HD44780_GPIO_PORT, HD44780_GPIO_D6, ((value >> 2) & 0x1));
-    GPIO_WriteToOutputPin(HD44780_GPIO_PORT, HD44780_GPIO_D7, ((value >> 3) & 0x1));
+    hd44780_bus_flush();
+}
 
-    hd44780_enable();
+void hd44780_page_set_cursor(uint8_t page, uint8_t row, uint8_t column){
+
+    hd44780_set_cursor(row, (page * HD44780_COLUMNS) + column);
 }
 
-static void hd44780_enable(void){
+void hd44780_page_flip(uint8_t page){
+
+    uint8_t target = (page * HD44780_COLUMNS) % HD44780_DDRAM_COLUMNS;
+    uint8_t distance = 0;
+    uint8_t direction = HD44780_SHIFT_LEFT;
 
-    GPIO_WriteToOutputPin(HD44780_GPIO_PORT, HD44780_GPIO_EN, GPIO_PIN_SET);
-    udelay(10);
-    GPIO_WriteToOutputPin(HD44780_GPIO_PORT, HD44780_GPIO_EN, GPIO_PIN_RESET);
-    udelay(100);
+    /* Columns to move the visible window to the right */
+    distance = (target + HD44780_DDRAM_COLUMNS - hd44780_shift_offset) % HD44780_DDRAM_COLUMNS;
+
+    if(distance > (HD44780_DDRAM_COLUMNS / 2)){
+        distance = HD44780_DDRAM_COLUMNS - distance;
+        direction = HD44780_SHIFT_RIGHT;
+    }
+
+    while(distance--){
+        hd44780_write_shift(direction);
+    }
+
+    /* All the shift commands are queued before starting the transmission */
+    hd44780_bus_flush();
+}
+
+uint8_t hd44780_page_get_hidden(void){
+
+    uint8_t page = 0;
+    uint8_t visible = 0;
+    uint8_t distance = 0;
+    uint8_t nearest = HD44780_DDRAM_COLUMNS;
+
+    /* The visible page is the closest one to the window, either way around the 40 columns */
+    for(page = 0; page < HD44780_PAGES; page++){
+        distance = (hd44780_shift_offset + HD44780_DDRAM_COLUMNS - (page * HD44780_COLUMNS)) % HD44780_DDRAM_COLUMNS;
+        if(distance > (HD44780_DDRAM_COLUMNS / 2)){
+            distance = HD44780_DDRAM_COLUMNS - distance;
+        }
+        if(distance < nearest){
+            nearest = distance;
+            visible = page;
+        }
+    }
+
+    return (visible + 1) % HD44780_PAGES;
 }
 
-static void mdelay(uint32_t cnt){
+void hd44780_marquee_load(uint8_t row, char* msg){
+
+    uint8_t i = 0;
 
-    uint32_t i = 0;
+    hd44780_set_cursor(row, 1);
 
-    for(i = 0; i < (cnt * 1000); i++);
+    for(i = 0; i < HD44780_DDRAM_COLUMNS; i++){
+        hd44780_write_byte(1, (*msg != '\0') ? (uint8_t)*msg++ : ' ');
+    }
+
+    hd44780_bus_flush();
+}
+
+uint8_t hd44780_is_busy(void){
+
+    return hd44780_bus_busy();
 }
 
-static void udelay(uint32_t cnt){
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static void hd44780_write_byte(uint8_t rs, uint8_t value){
+
+    /* Send higher nibble */
+    hd44780_bus_write_nibble(rs, value >> 4);
+    /* Send lower nibble */
+    hd44780_bus_write_nibble(rs, value & 0x0F);
+
+    /* The instruction is executed from here */
+    hd44780_bus_exec_wait();
+}
 
-    uint32_t i = 0;
+static void hd44780_write_shift(uint8_t direction){
 
-    for(i = 0; i < cnt; i++);
+    if(direction == HD44780_SHIFT_LEFT){
+        hd44780_write_byte(0, HD44780_CMD_DIS_SHIFT_LEFT);
+        hd44780_shift_offset = (hd44780_shift_offset + 1) % HD44780_DDRAM_COLUMNS;
+    }
+    else{
+        hd44780_write_byte(0, HD44780_CMD_DIS_SHIFT_RIGHT);
+        hd44780_shift_offset = (hd44780_shift_offset + HD44780_DDRAM_COLUMNS - 1) % HD44780_DDRAM_COLUMNS;
+    }
 }
@@ -13,6 +13,12 @@
 *       void    hd44780_display_return_home(void)
 *       void    hd44780_set_cursor(uint8_t row, uint8_t column)
 *       void    hd44780_display_clear(void)
+*       void    hd44780_display_shift(uint8_t direction)
+*       void    hd44780_page_set_cursor(uint8_t page, uint8_t row, uint8_t column)
+*       void    hd44780_page_flip(uint8_t page)
+*       uint8_t hd44780_page_get_hidden(void)
+*       void    hd44780_marquee_load(uint8_t row, char* msg)
+*       uint8_t hd44780_is_busy(void)
 *
 **/
 
@@ -33,6 +39,41 @@
 #define HD44780_GPIO_D6                 GPIO_PIN_NO_5
 #define HD44780_GPIO_D7                 GPIO_PIN_NO_6
 
+/**
+ * @HD44780_TRANSPORT
+ * Transport used for driving the HD44780 bus signals.
+ */
+#define HD44780_TRANSPORT_GPIO          0   /* 4 bit parallel bus driven directly from GPIO pins */
+#define HD44780_TRANSPORT_SPI_595       1   /* 74HC595 shift register on SPI, streamed by DMA */
+
+#ifndef HD44780_TRANSPORT
+#define HD44780_TRANSPORT               HD44780_TRANSPORT_GPIO
+#endif
+
+/**
+ * Application configurable items for HD44780_TRANSPORT_SPI_595
+ */
+#define HD44780_SPI                     SPI1
+#define HD44780_SPI_GPIO_PORT           GPIOA
+#define HD44780_SPI_SCK_PIN             GPIO_PIN_NO_5   /* 74HC595 SRCLK */
+#define HD44780_SPI_MOSI_PIN            GPIO_PIN_NO_7   /* 74HC595 SER */
+#define HD44780_SPI_RCLK_PIN            GPIO_PIN_NO_8   /* 74HC595 RCLK, driven by TIM1_CH1 */
+#define HD44780_SPI_SLOT_US             10              /* Time between two 74HC595 latch pulses */
+#define HD44780_SPI_LATCH_US            4               /* Latch pulse offset inside a slot */
+#define HD44780_SPI_EXEC_US             40              /* Idle time after an instruction (37/43us) */
+#define HD44780_SPI_STREAM_LEN          256             /* 74HC595 states buffered per DMA transfer */
+#define HD44780_SPI_SCLK_HZ             4000000         /* Highest 74HC595 shift clock */
+
+/* 74HC595 output (Qx) wired to each HD44780 signal */
+#define HD44780_595_RS                  0
+#define HD44780_595_RW                  1
+#define HD44780_595_EN                  2
+#define HD44780_595_BL                  3   /* Backlight, kept on */
+#define HD44780_595_D4                  4
+#define HD44780_595_D5                  5
+#define HD44780_595_D6                  6
+#define HD44780_595_D7                  7
+
 /* HD44780 commands */
 #define HD44780_CMD_4DL_2N_5X8F         0x28 /* 4 bit data length, 2 lines */
 #define HD44780_CMD_DON_CURON           0x0E /* Display ON and cursor ON */
@@ -40,6 +81,20 @@
 #define HD44780_CMD_INCADD              0x06 /* Increment RAM address */
 #define HD44780_CMD_DIS_CLEAR           0x01 /* Display clear */
 #define HD44780_CMD_DIS_RETURN_HOME     0x02 /* Display return home */
+#define HD44780_CMD_DIS_SHIFT_LEFT      0x18 /* Shift the display one column to the left */
+#define HD44780_CMD_DIS_SHIFT_RIGHT     0x1C /* Shift the display one column to the right */
+
+/* Display geometry */
+#define HD44780_COLUMNS                 16  /* Visible columns per line */
+#define HD44780_DDRAM_COLUMNS           40  /* DDRAM cells per line */
+#define HD44780_PAGES                   (HD44780_DDRAM_COLUMNS / HD44780_COLUMNS)
+
+/**
+ * @HD44780_SHIFT
+ * Possible directions for hd44780_display_shift.
+ */
+#define HD44780_SHIFT_LEFT              0   /* Content moves left, the visible window moves right */
+#define HD44780_SHIFT_RIGHT             1   /* Content moves right, the visible window moves left */
 
 /*****************************************************************************************************/
 /*                                       APIs Supported                                              */
@@ -112,7 +167,8 @@ void hd44780_display_return_home(void);
  *
  * @return void.
  *
- * @note: this function is for a 2 x 16 characters display.
+ * @note: this function is for a 2 x 16 characters display. The column is a DDRAM column, values from
+ *        17 to 40 address the off-screen cells and are not affected by the display shift.
  */
 void hd44780_set_cursor(uint8_t row, uint8_t column);
 
@@ -127,4 +183,84 @@ void hd44780_set_cursor(uint8_t row, uint8_t column);
  */
 void hd44780_display_clear(void);
 
+/**
+ * @fn hd44780_display_shift
+ *
+ * @brief function to shift the display one column without changing the DDRAM content.
+ *
+ * @param[in] direction @HD44780_SHIFT.
+ *
+ * @return void.
+ *
+ * @note: both lines are shifted, the content wraps around the 40 DDRAM columns.
+ */
+void hd44780_display_shift(uint8_t direction);
+
+/**
+ * @fn hd44780_page_set_cursor
+ *
+ * @brief function to set the cursor inside a page of the DDRAM.
+ *
+ * @param[in] page is the page number (0 to HD44780_PAGES - 1), page n starts in DDRAM column n * 16.
+ * @param[in] row to indicate the number of row (1 to 2).
+ * @param[in] column to indicate the number of column inside the page (1 to 16).
+ *
+ * @return void.
+ */
+void hd44780_page_set_cursor(uint8_t page, uint8_t row, uint8_t column);
+
+/**
+ * @fn hd44780_page_flip
+ *
+ * @brief function to make a page visible using display shift commands.
+ *
+ * @param[in] page is the page number (0 to HD44780_PAGES - 1).
+ *
+ * @return void.
+ *
+ * @note: the shortest direction is used, so a flip takes at most 20 shift commands, and the page
+ *        content is never rewritten. The cost depends on the transport: the GPIO one blocks for
+ *        every nibble, about 222us per command (4.4ms for 20), the SPI_595 one queues all the
+ *        commands in one DMA transfer, 100us per command (2ms for 20), and returns at once.
+ */
+void hd44780_page_flip(uint8_t page);
+
+/**
+ * @fn hd44780_page_get_hidden
+ *
+ * @brief function to get a page which is not visible, to render it before flipping.
+ *
+ * @param[in] void.
+ *
+ * @return page number.
+ */
+uint8_t hd44780_page_get_hidden(void);
+
+/**
+ * @fn hd44780_marquee_load
+ *
+ * @brief function to write a text in the 40 DDRAM columns of a row for scrolling it.
+ *
+ * @param[in] row to indicate the number of row (1 to 2).
+ * @param[in] msg is the text, it is truncated or padded with spaces to 40 characters.
+ *
+ * @return void.
+ *
+ * @note: the text is scrolled with hd44780_display_shift, one command per step, without rewriting it.
+ */
+void hd44780_marquee_load(uint8_t row, char* msg);
+
+/**
+ * @fn hd44780_is_busy
+ *
+ * @brief function to know if the transport is still sending data to the HD44780.
+ *
+ * @param[in] void.
+ *
+ * @return 1 if a transmission is in progress, 0 otherwise.
+ *
+ * @note: the peripherals used by a busy transport must keep running, e.g. no Stop mode.
+ */
+uint8_t hd44780_is_busy(void);
+
 #endif /* HD44780_H */
@@ -0,0 +1,171 @@
+/*****************************************************************************************************
+* FILENAME :        hd44780_bus.h
+*
+* DESCRIPTION :
+*       Header file containing the prototypes of the transport layer used by the HD44780 module.
+*
+* PUBLIC FUNCTIONS :
+*       void    hd44780_bus_init(void)
+*       void    hd44780_bus_write_nibble(uint8_t rs, uint8_t value)
+*       void    hd44780_bus_delay_us(uint32_t cnt)
+*       void    hd44780_bus_flush(void)
+*       uint8_t hd44780_bus_busy(void)
+*       void    hd44780_bus_exec_wait(void)
+*       void    hd44780_udelay(uint32_t cnt)
+*       void    hd44780_spi_hw_init(void)
+*       void    hd44780_spi_hw_start(const uint8_t* states, uint16_t len)
+*       uint8_t hd44780_spi_hw_done(void)
+*       void    hd44780_spi_hw_stop(void)
+*
+* NOTES :
+*       Only one transport is built, selected with HD44780_TRANSPORT in hd44780.h. These functions are
+*       internal to the HD44780 module, application code must use the hd44780_* APIs.
+*
+*       The hd44780_spi_hw_* functions are the peripheral accesses of the SPI transport, the host
+*       build (GPIO_SIM) replaces them with host/hd44780_spi_sim.c.
+*
+**/
+
+#ifndef HD44780_BUS_H
+#define HD44780_BUS_H
+
+#include <stdint.h>
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn hd44780_bus_init
+ *
+ * @brief function to initialize the peripherals used for driving the HD44780 signals.
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+void hd44780_bus_init(void);
+
+/**
+ * @fn hd44780_bus_write_nibble
+ *
+ * @brief function to write four bits in the data line of HD44780 and pulse the enable signal.
+ *
+ * @param[in] rs is the value of the register select signal (0 command, 1 data).
+ * @param[in] value to be written in the data line.
+ *
+ * @return void
+ */
+void hd44780_bus_write_nibble(uint8_t rs, uint8_t value);
+
+/**
+ * @fn hd44780_bus_delay_us
+ *
+ * @brief function to keep the HD44780 bus idle for a number of microseconds.
+ *
+ * @param[in] cnt is the number of microseconds.
+ *
+ * @return void
+ *
+ * @note the wait is ordered with the bus traffic, it may be queued instead of blocking.
+ */
+void hd44780_bus_delay_us(uint32_t cnt);
+
+/**
+ * @fn hd44780_bus_flush
+ *
+ * @brief function to start the transmission of any queued bus traffic.
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+void hd44780_bus_flush(void);
+
+/**
+ * @fn hd44780_bus_busy
+ *
+ * @brief function to know if there is bus traffic still being transmitted.
+ *
+ * @param[in] void
+ *
+ * @return 1 if a transmission is in progress, 0 otherwise.
+ */
+uint8_t hd44780_bus_busy(void);
+
+/**
+ * @fn hd44780_bus_exec_wait
+ *
+ * @brief function to keep the HD44780 bus idle for the execution time of the instruction just sent.
+ *
+ * @param[in] void
+ *
+ * @return void
+ *
+ * @note it is called after the last nibble of every instruction, clear display and return home need
+ *       an extra hd44780_bus_delay_us.
+ */
+void hd44780_bus_exec_wait(void);
+
+/**
+ * @fn hd44780_udelay
+ *
+ * @brief function to busy wait between bus signal changes of the GPIO transport.
+ *
+ * @param[in] cnt is the number of microseconds, timed by the DWT cycle counter at HCLK.
+ *
+ * @return void
+ *
+ * @note weak symbol run from SRAM, a host simulation can override it for advancing its simulated
+ *       time. The HCLK frequency is read once by hd44780_bus_init.
+ */
+void hd44780_udelay(uint32_t cnt);
+
+/**
+ * @fn hd44780_spi_hw_init
+ *
+ * @brief function to configure the pins, SPI, DMA stream and timer of the SPI transport.
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+void hd44780_spi_hw_init(void);
+
+/**
+ * @fn hd44780_spi_hw_start
+ *
+ * @brief function to start sending 74HC595 states, one per slot.
+ *
+ * @param[in] states is the first state, the buffer must stay untouched until the transfer ends.
+ * @param[in] len is the number of states.
+ *
+ * @return void
+ *
+ * @note DMA2_Stream5_Handler is called when the last state has been written.
+ */
+void hd44780_spi_hw_start(const uint8_t* states, uint16_t len);
+
+/**
+ * @fn hd44780_spi_hw_done
+ *
+ * @brief function to poll the end of the transfer, for when the DMA interrupt cannot preempt.
+ *
+ * @param[in] void
+ *
+ * @return 1 if the last state has been written, 0 otherwise.
+ */
+uint8_t hd44780_spi_hw_done(void);
+
+/**
+ * @fn hd44780_spi_hw_stop
+ *
+ * @brief function to clear the transfer flags and stop the slot timer.
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+void hd44780_spi_hw_stop(void);
+
+#endif /* HD44780_BUS_H */
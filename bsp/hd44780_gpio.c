@@ -0,0 +1,169 @@
+/*****************************************************************************************************
+* FILENAME :        hd44780_gpio.c
+*
+* DESCRIPTION :
+*       File containing the HD44780 transport which drives the 4 bit parallel bus from GPIO pins.
+*
+* PUBLIC FUNCTIONS :
+*       void    hd44780_bus_init(void)
+*       void    hd44780_bus_write_nibble(uint8_t rs, uint8_t value)
+*       void    hd44780_bus_delay_us(uint32_t cnt)
+*       void    hd44780_bus_flush(void)
+*       uint8_t hd44780_bus_busy(void)
+*       void    hd44780_bus_exec_wait(void)
+*       void    hd44780_udelay(uint32_t cnt)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+*       The nibble writer and its delay loop run from SRAM (__RAMFUNC), so the bus timing does not
+*       depend on the flash wait states, and the HCLK cycles per microsecond of the delay loop are
+*       computed once by hd44780_bus_init. The nibble writer uses the inline GPIO fast path: RS, RW
+*       and D4 to D7 change together in one BSRR store, then EN is pulsed.
+*
+**/
+
+#include "hd44780.h"
+
+#if HD44780_TRANSPORT == HD44780_TRANSPORT_GPIO
+
+#include "hd44780_bus.h"
+#include "stm32f446xx.h"
+#include "gpio_driver.h"
+#include "rcc_driver.h"
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Pin descriptors of the bus signals.
+ */
+#define HD44780_PIN_EN      GPIO_PIN(HD44780_GPIO_PORT, HD44780_GPIO_EN)
+#define HD44780_PINS_DATA   GPIO_PINS(HD44780_GPIO_PORT, (1 << HD44780_GPIO_RS) | (1 << HD44780_GPIO_RW) | \
+                                      (1 << HD44780_GPIO_D4) | (1 << HD44780_GPIO_D5) |                   \
+                                      (1 << HD44780_GPIO_D6) | (1 << HD44780_GPIO_D7))
+
+/* HCLK cycles per microsecond for hd44780_udelay, HSI until hd44780_bus_init */
+static uint32_t hd44780_cycles_us = RCC_HSI_VALUE / 1000000U;
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn hd44780_enable
+ *
+ * @brief function to enable the HD44780 device.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ */
+__RAMFUNC static void hd44780_enable(void);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void hd44780_bus_init(void){
+
+    /* Configure the GPIO pins which are used for LCD connections */
+    GPIO_Handle_t hd44780_signal;
+
+    memset(&hd44780_signal, 0, sizeof(hd44780_signal));
+
+    hd44780_signal.pGPIOx = HD44780_GPIO_PORT;
+    hd44780_signal.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_OUT;
+    hd44780_signal.GPIO_PinConfig.GPIO_PinOPType = GPIO_OP_TYPE_PP;
+    hd44780_signal.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_NO_PULL;
+    hd44780_signal.GPIO_PinConfig.GPIO_PinSpeed = GPIO_SPEED_FAST;
+
+    hd44780_signal.GPIO_PinConfig.GPIO_PinNumber = HD44780_GPIO_RS;
+    GPIO_Init(&hd44780_signal);
+
+    hd44780_signal.GPIO_PinConfig.GPIO_PinNumber = HD44780_GPIO_RW;
+    GPIO_Init(&hd44780_signal);
+
+    hd44780_signal.GPIO_PinConfig.GPIO_PinNumber = HD44780_GPIO_EN;
+    GPIO_Init(&hd44780_signal);
+
+    hd44780_signal.GPIO_PinConfig.GPIO_PinNumber = HD44780_GPIO_D4;
+    GPIO_Init(&hd44780_signal);
+
+    hd44780_signal.GPIO_PinConfig.GPIO_PinNumber = HD44780_GPIO_D5;
+    GPIO_Init(&hd44780_signal);
+
+    hd44780_signal.GPIO_PinConfig.GPIO_PinNumber = HD44780_GPIO_D6;
+    GPIO_Init(&hd44780_signal);
+
+    hd44780_signal.GPIO_PinConfig.GPIO_PinNumber = HD44780_GPIO_D7;
+    GPIO_Init(&hd44780_signal);
+
+    /* Set pins to 0 */
+    GPIO_PinReset(HD44780_PIN_EN);
+    GPIO_PinReset(HD44780_PINS_DATA);
+
+    /* HCLK is final here, sysclk_init runs before main and after every Stop mode wakeup */
+    hd44780_cycles_us = RCC_GetHCLKValue() / 1000000U;
+}
+
+__RAMFUNC void hd44780_bus_write_nibble(uint8_t rs, uint8_t value){
+
+    uint16_t level = 0;
+
+    /* RS, 0 for HD44780 command and 1 for HD44780 user data, RW stays 0 for writing */
+    level |= rs ? (1 << HD44780_GPIO_RS) : 0;
+    level |= (value & 0x1) ? (1 << HD44780_GPIO_D4) : 0;
+    level |= (value & 0x2) ? (1 << HD44780_GPIO_D5) : 0;
+    level |= (value & 0x4) ? (1 << HD44780_GPIO_D6) : 0;
+    level |= (value & 0x8) ? (1 << HD44780_GPIO_D7) : 0;
+
+    /* Control and data lines are set in one store, before EN rises */
+    GPIO_PinsWrite(HD44780_PINS_DATA, level);
+
+    hd44780_enable();
+}
+
+void hd44780_bus_delay_us(uint32_t cnt){
+
+    hd44780_udelay(cnt);
+}
+
+void hd44780_bus_flush(void){
+
+    /* Nothing is queued, every nibble is written synchronously */
+}
+
+uint8_t hd44780_bus_busy(void){
+
+    return 0;
+}
+
+void hd44780_bus_exec_wait(void){
+
+    /* Nothing to add, hd44780_enable waits longer than the execution time after every nibble */
+}
+
+__attribute__((weak)) __RAMFUNC void hd44780_udelay(uint32_t cnt){
+
+    uint32_t start = *DWT_CYCCNT;
+    uint32_t cycles = cnt * hd44780_cycles_us;
+
+    /* The cycle counter is started by Reset_Handler */
+    while((*DWT_CYCCNT - start) < cycles);
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+__RAMFUNC static void hd44780_enable(void){
+
+    /* Address setup time (tAS, 40 ns) from RS and RW to EN rising */
+    hd44780_udelay(1);
+    GPIO_PinSet(HD44780_PIN_EN);
+    hd44780_udelay(10);
+    GPIO_PinReset(HD44780_PIN_EN);
+    hd44780_udelay(100);
+}
+
+#endif /* HD44780_TRANSPORT == HD44780_TRANSPORT_GPIO */
@@ -0,0 +1,448 @@
+/*****************************************************************************************************
+* FILENAME :        hd44780_spi.c
+*
+* DESCRIPTION :
+*       File containing the HD44780 transport which drives the bus through a 74HC595 shift register
+*       connected to the SPI peripheral, with the bus traffic streamed by DMA.
+*
+* PUBLIC FUNCTIONS :
+*       void    hd44780_bus_init(void)
+*       void    hd44780_bus_write_nibble(uint8_t rs, uint8_t value)
+*       void    hd44780_bus_delay_us(uint32_t cnt)
+*       void    hd44780_bus_flush(void)
+*       uint8_t hd44780_bus_busy(void)
+*       void    hd44780_bus_exec_wait(void)
+*       void    hd44780_spi_hw_init(void)
+*       void    hd44780_spi_hw_start(const uint8_t* states, uint16_t len)
+*       uint8_t hd44780_spi_hw_done(void)
+*       void    hd44780_spi_hw_stop(void)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+*       Every byte sent to the 74HC595 is one state of the HD44780 bus (a "slot"). TIM1 paces the
+*       slots: each update event requests DMA2 stream 5 (channel 6, TIM1_UP) to write the next state
+*       to the SPI data register, and TIM1_CH1 (PWM mode 2) raises RCLK once the byte has been
+*       shifted out, latching it into the 74HC595 outputs.
+*
+*       A nibble takes three slots: the data with EN low, so RS is set up one slot before EN rises
+*       (tAS), the data with EN high, and the data with EN low again, so EN falls with the data
+*       stable. The HD44780 starts executing an instruction at the falling edge of its second nibble,
+*       then hd44780_bus_exec_wait queues HD44780_SPI_EXEC_US of idle slots, and clear and return
+*       home also get the longer wait queued by hd44780.c. With HD44780_SPI_SLOT_US = 10 a byte
+*       takes 100us.
+*
+*       States are queued in two buffers: one is being sent by DMA while the other is being filled.
+*       The DMA transfer complete interrupt chains the next buffer, so a whole frame is sent without
+*       CPU intervention.
+*
+*       The peripherals are only accessed by the hd44780_spi_hw_* functions. With GPIO_SIM defined
+*       (host build) they are not built here, host/hd44780_spi_sim.c plays the slots against the
+*       HD44780 emulator instead.
+*
+**/
+
+#include "hd44780.h"
+
+#if HD44780_TRANSPORT == HD44780_TRANSPORT_SPI_595
+
+#include "hd44780_bus.h"
+#include "stm32f446xx.h"
+#include "gpio_driver.h"
+#include "spi_driver.h"
+#include "rcc_driver.h"
+#include <stdint.h>
+#include <string.h>
+
+#define HD44780_DMA_STREAM      5
+#define HD44780_DMA_CHANNEL     6
+#define HD44780_DMA_FLAGS       ((1 << DMA_ISR_FEIF5) | (1 << DMA_ISR_DMEIF5) | (1 << DMA_ISR_TEIF5) | \
+                                 (1 << DMA_ISR_HTIF5) | (1 << DMA_ISR_TCIF5))
+
+SPI_Handle_t hd44780_SPIHandle;
+
+/* One extra slot per buffer for the trailing state appended by stream_kick() */
+static uint8_t stream_buf[2][HD44780_SPI_STREAM_LEN + 1];
+static volatile uint16_t stream_len[2];
+static volatile uint8_t fill_idx = 0;
+static volatile uint8_t dma_busy = 0;
+static uint8_t bus_state = (1 << HD44780_595_BL);
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+#ifndef GPIO_SIM
+/**
+ * @fn hd44780_spi_pin_cfg
+ *
+ * @brief helper function to configure the GPIO pins for SPI and TIM peripherals.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ */
+static void hd44780_spi_pin_cfg(void);
+
+/**
+ * @fn hd44780_spi_cfg
+ *
+ * @brief helper function to configure the SPI peripheral.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ */
+static void hd44780_spi_cfg(void);
+
+/**
+ * @fn hd44780_spi_sclk_div
+ *
+ * @brief helper function to get the lowest SPI prescaler keeping SCLK up to HD44780_SPI_SCLK_HZ.
+ *
+ * @param[in] void.
+ *
+ * @return possible values from @SPI_SCLKSPEED.
+ */
+static uint8_t hd44780_spi_sclk_div(void);
+
+/**
+ * @fn hd44780_dma_cfg
+ *
+ * @brief helper function to configure the DMA stream which feeds the SPI peripheral.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ */
+static void hd44780_dma_cfg(void);
+
+/**
+ * @fn hd44780_tim_cfg
+ *
+ * @brief helper function to configure the timer which paces the slots and drives RCLK.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ */
+static void hd44780_tim_cfg(void);
+#endif /* GPIO_SIM */
+
+/**
+ * @fn stream_put
+ *
+ * @brief function to queue one 74HC595 state.
+ *
+ * @param[in] state is the value of the 74HC595 outputs.
+ *
+ * @return void.
+ *
+ * @note it waits for a free buffer if both buffers are in use.
+ */
+static void stream_put(uint8_t state);
+
+/**
+ * @fn stream_kick
+ *
+ * @brief function to start the DMA transfer of the buffer being filled, if DMA is idle.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ *
+ * @note must be called with interrupts masked or from the DMA interrupt.
+ */
+static void stream_kick(void);
+
+/**
+ * @fn stream_complete
+ *
+ * @brief function to stop the slot timer when a DMA transfer ends and chain the next buffer.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ *
+ * @note must be called with interrupts masked or from the DMA interrupt.
+ */
+static void stream_complete(void);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void hd44780_bus_init(void){
+
+    hd44780_spi_hw_init();
+
+    /* Start from a known state, EN low */
+    stream_put(bus_state);
+    hd44780_bus_flush();
+}
+
+void hd44780_bus_write_nibble(uint8_t rs, uint8_t value){
+
+    uint8_t state = (1 << HD44780_595_BL);
+
+    state |= (uint8_t)((rs & 0x1) << HD44780_595_RS);
+    state |= (uint8_t)(((value >> 0) & 0x1) << HD44780_595_D4);
+    state |= (uint8_t)(((value >> 1) & 0x1) << HD44780_595_D5);
+    state |= (uint8_t)(((value >> 2) & 0x1) << HD44780_595_D6);
+    state |= (uint8_t)(((value >> 3) & 0x1) << HD44780_595_D7);
+
+    /* RS and data are set up one slot before EN rises, and still stable when it falls */
+    stream_put(state);
+    stream_put(state | (1 << HD44780_595_EN));
+    stream_put(state);
+}
+
+void hd44780_bus_delay_us(uint32_t cnt){
+
+    uint32_t slots = (cnt + HD44780_SPI_SLOT_US - 1) / HD44780_SPI_SLOT_US;
+
+    /* Hold the current state on the bus */
+    while(slots--){
+        stream_put(bus_state);
+    }
+}
+
+void hd44780_bus_flush(void){
+
+    uint32_t primask = irq_lock();
+
+    stream_kick();
+
+    irq_unlock(primask);
+}
+
+uint8_t hd44780_bus_busy(void){
+
+    return dma_busy;
+}
+
+void hd44780_bus_exec_wait(void){
+
+    /* The instruction runs from the last EN falling edge, nothing may be latched until it ends */
+    hd44780_bus_delay_us(HD44780_SPI_EXEC_US);
+}
+
+#ifndef GPIO_SIM
+void hd44780_spi_hw_init(void){
+
+    hd44780_spi_pin_cfg();
+
+    hd44780_spi_cfg();
+
+    hd44780_dma_cfg();
+
+    hd44780_tim_cfg();
+}
+
+void hd44780_spi_hw_start(const uint8_t* states, uint16_t len){
+
+    DMA_Stream_RegDef_t* pStream = &DMA2->S[HD44780_DMA_STREAM];
+
+    pStream->M0AR = (uint32_t)states;
+    pStream->NDTR = len;
+    DMA2->HIFCR = HD44780_DMA_FLAGS;
+    pStream->CR |= (1 << DMA_SXCR_EN);
+
+    /* First state is requested right now by UG, next ones at every update */
+    TIM1->CNT = 0;
+    TIM1->EGR = (1 << TIM_EGR_UG);
+    TIM1->CR1 |= (1 << TIM_CR1_CEN);
+}
+
+uint8_t hd44780_spi_hw_done(void){
+
+    return (DMA2->HISR & (1 << DMA_ISR_TCIF5)) ? 1 : 0;
+}
+
+void hd44780_spi_hw_stop(void){
+
+    DMA2->HIFCR = HD44780_DMA_FLAGS;
+
+    TIM1->CR1 &= ~(1 << TIM_CR1_CEN);
+}
+#endif /* GPIO_SIM */
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+#ifndef GPIO_SIM
+static void hd44780_spi_pin_cfg(void){
+
+    GPIO_Handle_t spi_pin;
+
+    memset(&spi_pin, 0, sizeof(spi_pin));
+
+    spi_pin.pGPIOx = HD44780_SPI_GPIO_PORT;
+    spi_pin.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_ALTFN;
+    spi_pin.GPIO_PinConfig.GPIO_PinOPType = GPIO_OP_TYPE_PP;
+    spi_pin.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_NO_PULL;
+    spi_pin.GPIO_PinConfig.GPIO_PinSpeed = GPIO_SPEED_FAST;
+
+    /* SPI1 SCK and MOSI */
+    spi_pin.GPIO_PinConfig.GPIO_PinAltFunMode = 5;
+    spi_pin.GPIO_PinConfig.GPIO_PinNumber = HD44780_SPI_SCK_PIN;
+    GPIO_Init(&spi_pin);
+
+    spi_pin.GPIO_PinConfig.GPIO_PinNumber = HD44780_SPI_MOSI_PIN;
+    GPIO_Init(&spi_pin);
+
+    /* TIM1_CH1 as 74HC595 latch */
+    spi_pin.GPIO_PinConfig.GPIO_PinAltFunMode = 1;
+    spi_pin.GPIO_PinConfig.GPIO_PinNumber = HD44780_SPI_RCLK_PIN;
+    GPIO_Init(&spi_pin);
+}
+
+static void hd44780_spi_cfg(void){
+
+    hd44780_SPIHandle.pSPIx = HD44780_SPI;
+    hd44780_SPIHandle.SPIConfig.SPI_DeviceMode = SPI_DEVICE_MODE_MASTER;
+    hd44780_SPIHandle.SPIConfig.SPI_BusConfig = SPI_BUS_CONFIG_FD;
+    hd44780_SPIHandle.SPIConfig.SPI_SclkSpeed = hd44780_spi_sclk_div();
+    hd44780_SPIHandle.SPIConfig.SPI_DFF = SPI_DFF_8BITS;
+    hd44780_SPIHandle.SPIConfig.SPI_CPOL = SPI_CPOL_LOW;
+    hd44780_SPIHandle.SPIConfig.SPI_CPHA = SPI_CPHA_LOW;
+    hd44780_SPIHandle.SPIConfig.SPI_SSM = SPI_SSM_EN;
+
+    SPI_Init(&hd44780_SPIHandle);
+
+    /* No NSS pin is used, keep the internal NSS high for avoiding MODF error */
+    SPI_SSICfg(HD44780_SPI, ENABLE);
+
+    SPI_Enable(HD44780_SPI, ENABLE);
+}
+
+static uint8_t hd44780_spi_sclk_div(void){
+
+    uint32_t sclk = RCC_GetPCLK2Value() / 2;
+    uint8_t div = SPI_SCLK_SPEED_DIV2;
+
+    /* A byte must be shifted out before the latch pulse, HD44780_SPI_LATCH_US after the slot start */
+    while((sclk > HD44780_SPI_SCLK_HZ) && (div < SPI_SCLK_SPEED_DIV256)){
+        sclk /= 2;
+        div++;
+    }
+
+    return div;
+}
+
+static void hd44780_dma_cfg(void){
+
+    DMA_Stream_RegDef_t* pStream = &DMA2->S[HD44780_DMA_STREAM];
+
+    DMA2_PCLK_EN();
+
+    pStream->CR &= ~(1 << DMA_SXCR_EN);
+    while(pStream->CR & (1 << DMA_SXCR_EN));
+
+    /* Memory to peripheral, byte size, memory increment, interrupt on complete and error */
+    pStream->CR = (HD44780_DMA_CHANNEL << DMA_SXCR_CHSEL) |
+                  (1 << DMA_SXCR_DIR) |
+                  (1 << DMA_SXCR_MINC) |
+                  (1 << DMA_SXCR_TCIE) |
+                  (1 << DMA_SXCR_TEIE);
+    pStream->PAR = (uint32_t)&HD44780_SPI->DR;
+
+    DMA2->HIFCR = HD44780_DMA_FLAGS;
+
+    /* Enable the DMA2 stream 5 interrupt in NVIC */
+    *NVIC_ISER2 |= (1 << (IRQ_NO_DMA2_STREAM5 % 64));
+}
+
+static void hd44780_tim_cfg(void){
+
+    uint32_t tim_mhz = RCC_GetTIMCLK2Value() / 1000000UL;
+
+    TIM1_PCLK_EN();
+
+    TIM1->CR1 = 0;
+    TIM1->PSC = 0;
+    TIM1->ARR = (tim_mhz * HD44780_SPI_SLOT_US) - 1;
+    TIM1->CCR1 = tim_mhz * HD44780_SPI_LATCH_US;
+
+    /* PWM mode 2: RCLK low until CCR1, rising edge latches the 74HC595 */
+    TIM1->CCMR1 = (0x7 << TIM_CCMR1_OC1M) | (1 << TIM_CCMR1_OC1PE);
+    TIM1->CCER = (1 << TIM_CCER_CC1E);
+    TIM1->BDTR = (1 << TIM_BDTR_MOE);
+
+    /* Load the prescaler and reload values before enabling DMA requests */
+    TIM1->EGR = (1 << TIM_EGR_UG);
+    TIM1->SR = 0;
+
+    TIM1->DIER = (1 << TIM_DIER_UDE);
+}
+
+#endif /* GPIO_SIM */
+
+static void stream_put(uint8_t state){
+
+    uint32_t primask = 0;
+
+    for(;;){
+        primask = irq_lock();
+        if(stream_len[fill_idx] < HD44780_SPI_STREAM_LEN){
+            stream_buf[fill_idx][stream_len[fill_idx]++] = state;
+            irq_unlock(primask);
+            break;
+        }
+        /* Buffer full, send it or wait for the running transfer */
+        stream_kick();
+        irq_unlock(primask);
+
+        while(stream_len[fill_idx] >= HD44780_SPI_STREAM_LEN){
+            /* The DMA interrupt cannot preempt if we are called from an exception of same priority */
+            primask = irq_lock();
+            if(hd44780_spi_hw_done()){
+                stream_complete();
+            }
+            irq_unlock(primask);
+        }
+    }
+
+    bus_state = state;
+}
+
+static void stream_kick(void){
+
+    uint8_t idx = fill_idx;
+
+    if(dma_busy || (stream_len[idx] == 0)){
+        return;
+    }
+
+    /* The transfer complete interrupt fires when the last state is written to SPI, one slot before
+       it is latched. The trailing state keeps the timer running until that happens */
+    stream_buf[idx][stream_len[idx]] = bus_state;
+
+    dma_busy = 1;
+    fill_idx = idx ^ 1;
+    stream_len[fill_idx] = 0;
+
+    hd44780_spi_hw_start(stream_buf[idx], stream_len[idx] + 1);
+}
+
+static void stream_complete(void){
+
+    hd44780_spi_hw_stop();
+
+    dma_busy = 0;
+
+    /* Chain the states queued during the transfer */
+    stream_kick();
+}
+
+/*****************************************************************************************************/
+/*                                       Interrupt Handlers                                          */
+/*****************************************************************************************************/
+
+void DMA2_Stream5_Handler(void){
+
+    stream_complete();
+}
+
+#endif /* HD44780_TRANSPORT == HD44780_TRANSPORT_SPI_595 */
@@ -0,0 +1,262 @@
+/*****************************************************************************************************
+* FILENAME :        uart_console.c
+*
+* DESCRIPTION :
+*       File containing the USART2 console with a DMA drained transmit ring buffer.
+*
+* PUBLIC FUNCTIONS :
+*       void        uart_console_init(void)
+*       uint32_t    uart_console_write(const char* buf, uint32_t len)
+*       uint8_t     uart_console_is_busy(void)
+*       uint32_t    uart_console_get_dropped(void)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+*       The ring buffer is a src/spsc.h one: uart_console_write is the producer and the DMA is the
+*       consumer. A DMA transfer sends the contiguous data returned by spsc_peek, and the transfer
+*       complete interrupt releases it with spsc_skip and chains the next transfer. The writes stay
+*       serialized with interrupts masked, so callers from several contexts make a single producer.
+*       A write is copied in chunks of UART_CONSOLE_WRITE_CHUNK bytes with interrupts masked for
+*       each chunk only, so a long line does not delay the other interrupts by more than one chunk.
+*
+**/
+
+#include "uart_console.h"
+#include "stm32f446xx.h"
+#include "gpio_driver.h"
+#include "usart_driver.h"
+#include "spsc.h"
+#include <stdint.h>
+#include <string.h>
+
+#define UART_CONSOLE_GPIO_PORT      GPIOA
+#define UART_CONSOLE_TX_PIN         GPIO_PIN_NO_2
+#define UART_CONSOLE_DMA_STREAM     6
+#define UART_CONSOLE_DMA_CHANNEL    4
+#define UART_CONSOLE_DMA_FLAGS      ((1 << DMA_ISR_FEIF6) | (1 << DMA_ISR_DMEIF6) | (1 << DMA_ISR_TEIF6) | \
+                                     (1 << DMA_ISR_HTIF6) | (1 << DMA_ISR_TCIF6))
+#define UART_CONSOLE_WRITE_CHUNK    32      /* Bytes copied per masked section */
+
+USART_Handle_t uart_console_USARTHandle;
+
+SPSC_DEFINE(console_ring, char, UART_CONSOLE_BUFFER_SIZE);
+static volatile uint32_t dma_len = 0;
+static volatile uint8_t console_ready = 0;
+static uint32_t console_dropped = 0;
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn uart_console_pin_cfg
+ *
+ * @brief helper function to configure the USART2 TX pin.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ */
+static void uart_console_pin_cfg(void);
+
+/**
+ * @fn uart_console_dma_cfg
+ *
+ * @brief helper function to configure the DMA stream which feeds the USART peripheral.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ */
+static void uart_console_dma_cfg(void);
+
+/**
+ * @fn ring_kick
+ *
+ * @brief function to start the DMA transfer of the queued data, if DMA is idle.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ *
+ * @note must be called with interrupts masked or from the DMA interrupt.
+ */
+static void ring_kick(void);
+
+/**
+ * @fn ring_complete
+ *
+ * @brief function to release the data sent by a DMA transfer and chain the next one.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ *
+ * @note must be called with interrupts masked or from the DMA interrupt.
+ */
+static void ring_complete(void);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void uart_console_init(void){
+
+    uint32_t primask = 0;
+
+    /* Wait for the running transfer, the baud rate cannot change in the middle of a byte */
+    while(uart_console_is_busy());
+    console_ready = 0;
+
+    uart_console_pin_cfg();
+
+    uart_console_USARTHandle.pUSARTx = USART2;
+    uart_console_USARTHandle.USART_Config.USART_Mode = USART_MODE_ONLY_TX;
+    uart_console_USARTHandle.USART_Config.USART_Baud = UART_CONSOLE_BAUD;
+    uart_console_USARTHandle.USART_Config.USART_NoOfStopBits = USART_STOPBITS_1;
+    uart_console_USARTHandle.USART_Config.USART_WordLength = USART_WORDLEN_8BITS;
+    uart_console_USARTHandle.USART_Config.USART_ParityControl = USART_PARITY_DISABLE;
+    uart_console_USARTHandle.USART_Config.USART_HWFlowControl = USART_HW_FLOW_CTRL_NONE;
+
+    USART_Init(&uart_console_USARTHandle);
+
+    USART2->CR3 |= (1 << USART_CR3_DMAT);
+
+    uart_console_dma_cfg();
+
+    USART_Enable(USART2, ENABLE);
+
+    /* Send the data queued before init */
+    primask = irq_lock();
+    console_ready = 1;
+    ring_kick();
+    irq_unlock(primask);
+}
+
+uint32_t uart_console_write(const char* buf, uint32_t len){
+
+    uint32_t primask = 0;
+    uint32_t queued = 0;
+    uint32_t chunk = 0;
+    uint32_t pushed = 0;
+
+    do{
+        chunk = ((len - queued) > UART_CONSOLE_WRITE_CHUNK) ? UART_CONSOLE_WRITE_CHUNK : (len - queued);
+
+        primask = irq_lock();
+        pushed = spsc_push(&console_ring, &buf[queued], chunk);
+        queued += pushed;
+        if(pushed < chunk){
+            /* Full, the rest of the write is dropped */
+            console_dropped += len - queued;
+        }
+        ring_kick();
+        irq_unlock(primask);
+    }while((pushed == chunk) && (queued < len));
+
+    return queued;
+}
+
+uint8_t uart_console_is_busy(void){
+
+    if(!console_ready){
+        return 0;
+    }
+
+    /* TC is cleared when a transfer starts and set when the last stop bit is sent */
+    return (dma_len || !(USART2->SR & (1 << USART_SR_TC))) ? 1 : 0;
+}
+
+uint32_t uart_console_get_dropped(void){
+
+    return console_dropped;
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static void uart_console_pin_cfg(void){
+
+    GPIO_Handle_t usart_pin;
+
+    memset(&usart_pin, 0, sizeof(usart_pin));
+
+    usart_pin.pGPIOx = UART_CONSOLE_GPIO_PORT;
+    usart_pin.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_ALTFN;
+    usart_pin.GPIO_PinConfig.GPIO_PinOPType = GPIO_OP_TYPE_PP;
+    usart_pin.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_PIN_PU;
+    usart_pin.GPIO_PinConfig.GPIO_PinSpeed = GPIO_SPEED_FAST;
+    usart_pin.GPIO_PinConfig.GPIO_PinAltFunMode = 7;
+    usart_pin.GPIO_PinConfig.GPIO_PinNumber = UART_CONSOLE_TX_PIN;
+    GPIO_Init(&usart_pin);
+}
+
+static void uart_console_dma_cfg(void){
+
+    DMA_Stream_RegDef_t* pStream = &DMA1->S[UART_CONSOLE_DMA_STREAM];
+
+    DMA1_PCLK_EN();
+
+    pStream->CR &= ~(1 << DMA_SXCR_EN);
+    while(pStream->CR & (1 << DMA_SXCR_EN));
+
+    /* Memory to peripheral, byte size, memory increment, interrupt on complete and error */
+    pStream->CR = (UART_CONSOLE_DMA_CHANNEL << DMA_SXCR_CHSEL) |
+                  (1 << DMA_SXCR_DIR) |
+                  (1 << DMA_SXCR_MINC) |
+                  (1 << DMA_SXCR_TCIE) |
+                  (1 << DMA_SXCR_TEIE);
+    pStream->PAR = (uint32_t)&USART2->DR;
+
+    DMA1->HIFCR = UART_CONSOLE_DMA_FLAGS;
+
+    /* Enable the DMA1 stream 6 interrupt in NVIC */
+    *NVIC_ISER0 |= (1 << IRQ_NO_DMA1_STREAM6);
+}
+
+static void ring_kick(void){
+
+    DMA_Stream_RegDef_t* pStream = &DMA1->S[UART_CONSOLE_DMA_STREAM];
+    void* data = NULL;
+    uint32_t len = 0;
+
+    if(!console_ready || dma_len){
+        return;
+    }
+
+    /* Up to the end of the buffer, the rest goes in the next transfer */
+    len = spsc_peek(&console_ring, &data);
+    if(len == 0){
+        return;
+    }
+
+    pStream->M0AR = (uint32_t)data;
+    pStream->NDTR = len;
+    DMA1->HIFCR = UART_CONSOLE_DMA_FLAGS;
+    USART2->SR &= ~(1 << USART_SR_TC);
+    pStream->CR |= (1 << DMA_SXCR_EN);
+
+    dma_len = len;
+}
+
+static void ring_complete(void){
+
+    DMA1->HIFCR = UART_CONSOLE_DMA_FLAGS;
+
+    spsc_skip(&console_ring, dma_len);
+    dma_len = 0;
+
+    /* Chain the data queued during the transfer */
+    ring_kick();
+}
+
+/*****************************************************************************************************/
+/*                                       Interrupt Handlers                                          */
+/*****************************************************************************************************/
+
+void DMA1_Stream6_Handler(void){
+
+    ring_complete();
+}
@@ -0,0 +1,89 @@
+/*****************************************************************************************************
+* FILENAME :        uart_console.h
+*
+* DESCRIPTION :
+*       Header file containing the prototypes of the APIs for the USART2 console, which is wired to
+*       the ST-LINK virtual COM port of the NUCLEO board.
+*
+* PUBLIC FUNCTIONS :
+*       void        uart_console_init(void)
+*       uint32_t    uart_console_write(const char* buf, uint32_t len)
+*       uint8_t     uart_console_is_busy(void)
+*       uint32_t    uart_console_get_dropped(void)
+*
+* NOTES :
+*       The output is queued into a ring buffer which is drained by DMA1 stream 6 (channel 4,
+*       USART2_TX), so uart_console_write never waits for the line. When the ring buffer is full the
+*       output is trimmed and the dropped bytes are counted. Data written before uart_console_init is
+*       kept and sent at init.
+*
+*       Pins: PA2 USART2 TX (AF7), 8N1 at UART_CONSOLE_BAUD. The baud rate divider is computed from
+*       the APB1 clock at init, call uart_console_init again if the clock changes.
+*
+**/
+
+#ifndef UART_CONSOLE_H
+#define UART_CONSOLE_H
+
+#include <stdint.h>
+
+/**
+ * Application configurable items
+ */
+#define UART_CONSOLE_BAUD           115200
+#define UART_CONSOLE_BUFFER_SIZE    1024    /* Power of 2 */
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn uart_console_init
+ *
+ * @brief function to configure the pin, USART2 and the DMA stream, and send the queued data.
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+void uart_console_init(void);
+
+/**
+ * @fn uart_console_write
+ *
+ * @brief function to queue data to be sent.
+ *
+ * @param[in] buf is the data to be sent.
+ * @param[in] len is the number of bytes.
+ *
+ * @return number of bytes queued, the rest is dropped.
+ *
+ * @note it never waits for the line and it can be called from interrupt handlers. Interrupts are
+ *       masked for each chunk of UART_CONSOLE_WRITE_CHUNK bytes only, so a write from a handler
+ *       can land between two chunks of a longer one.
+ */
+uint32_t uart_console_write(const char* buf, uint32_t len);
+
+/**
+ * @fn uart_console_is_busy
+ *
+ * @brief function to know if data is still being sent.
+ *
+ * @param[in] void
+ *
+ * @return 1 if a DMA transfer is running or the last byte is being shifted out, 0 otherwise.
+ */
+uint8_t uart_console_is_busy(void);
+
+/**
+ * @fn uart_console_get_dropped
+ *
+ * @brief function to get the number of bytes dropped because the ring buffer was full.
+ *
+ * @param[in] void
+ *
+ * @return number of dropped bytes.
+ */
+uint32_t uart_console_get_dropped(void);
+
+#endif /* UART_CONSOLE_H */
@@ -0,0 +1,71 @@
+/*****************************************************************************************************
+* FILENAME :        bustrace.c
+*
+* DESCRIPTION :
+*       File containing the bus activity tracer.
+*
+* PUBLIC FUNCTIONS :
+*       void        bustrace_init(uint32_t clock_hz)
+*       void        bustrace_record(uint8_t type, uint8_t bus, uint16_t value)
+*       uint32_t    bustrace_now(void)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+**/
+
+#include "bustrace.h"
+#include "stm32f446xx.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#if BUSTRACE_ENABLE
+
+_Static_assert((BUSTRACE_RECORDS & (BUSTRACE_RECORDS - 1)) == 0, "BUSTRACE_RECORDS must be a power of 2");
+
+bustrace_t bustrace;
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void bustrace_init(uint32_t clock_hz){
+
+    uint32_t i = 0;
+
+    bustrace.clock_hz = clock_hz;
+    bustrace.size = BUSTRACE_RECORDS;
+    bustrace.count = 0;
+    for(i = 0; i < BUSTRACE_RECORDS; i++){
+        bustrace.records[i].type = 0;
+    }
+
+    /* Written last, so a dump never shows a valid identifier with a stale header */
+    for(i = 0; i < BUSTRACE_ID_LEN; i++){
+        bustrace.id[i] = BUSTRACE_ID[i];
+    }
+}
+
+void bustrace_record(uint8_t type, uint8_t bus, uint16_t value){
+
+    bustrace_record_t* record = NULL;
+    uint32_t slot = 0;
+
+    if(bustrace.size == 0){
+        return;
+    }
+
+    slot = __atomic_fetch_add(&bustrace.count, 1, __ATOMIC_RELAXED) & (BUSTRACE_RECORDS - 1);
+    record = &bustrace.records[slot];
+    record->time = bustrace_now();
+    record->bus = bus;
+    record->value = value;
+    record->type = type;
+}
+
+__attribute__((weak)) uint32_t bustrace_now(void){
+
+    return *DWT_CYCCNT;
+}
+
+#endif /* BUSTRACE_ENABLE */
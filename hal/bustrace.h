@@ -0,0 +1,137 @@
+/*****************************************************************************************************
+* FILENAME :        bustrace.h
+*
+* DESCRIPTION :
+*       Header file containing the bus activity tracer: the GPIO and I2C drivers (and their host
+*       stand-ins) timestamp every output change and every I2C start, byte and stop into a RAM ring
+*       buffer, which host/bustrace_vcd converts into a VCD file for a waveform viewer.
+*
+* PUBLIC FUNCTIONS :
+*       void        bustrace_init(uint32_t clock_hz)
+*       void        bustrace_record(uint8_t type, uint8_t bus, uint16_t value)
+*       uint32_t    bustrace_now(void)
+*
+* NOTES :
+*       BUSTRACE_ENABLE 0 (default) removes every hook from the drivers. It can be set from the command
+*       line (-DBUSTRACE_ENABLE=1), the host build enables it.
+*
+*       The buffer keeps the last BUSTRACE_RECORDS events, the oldest ones are overwritten. On the
+*       target it is read from a RAM dump:
+*           halt
+*           dump_image ram.bin 0x20000000 0x20000
+*       and converted with: bustrace_vcd ram.bin > bus.vcd
+*
+*       The timestamps are DWT cycle counter values (bustrace_now, clock_hz given to bustrace_init),
+*       the host stand-ins replace bustrace_now with their simulated clock. The counter stops in Stop
+*       mode (see idle.h), so the time spent there is missing from the trace. A record takes its slot
+*       with an atomic increment, so no interrupt lock is needed; an ISR may write its record with
+*       a timestamp earlier than the one of the record it preempted, the converter sorts them.
+*
+**/
+
+#ifndef BUSTRACE_H
+#define BUSTRACE_H
+
+#include <stdint.h>
+
+/**
+ * Application configurable items
+ */
+#ifndef BUSTRACE_ENABLE
+#define BUSTRACE_ENABLE         0       /* 1 records the GPIO and I2C activity */
+#endif
+#define BUSTRACE_RECORDS        1024    /* Ring buffer size in records, power of 2 */
+
+/**
+ * @BUSTRACE_TYPE
+ * Record types.
+ */
+#define BUSTRACE_GPIO           1       /* bus: port (0 = A), value: output data register after the write */
+#define BUSTRACE_I2C_START      2       /* bus: I2C number, value: address byte (address << 1 | read) */
+#define BUSTRACE_I2C_BYTE       3       /* bus: I2C number, value: data byte */
+#define BUSTRACE_I2C_STOP       4       /* bus: I2C number, value: 0 */
+
+/**
+ * Control block identifier, searched by host/bustrace_vcd.
+ */
+#define BUSTRACE_ID             "BUSTRACE"
+#define BUSTRACE_ID_LEN         8
+
+/**
+ * Trace record, 8 bytes.
+ */
+typedef struct
+{
+    uint32_t time;                  /* Timestamp, clock_hz ticks */
+    uint8_t type;                   /* From @BUSTRACE_TYPE, 0 for an empty slot */
+    uint8_t bus;                    /* Port or bus number */
+    uint16_t value;                 /* Port level or byte */
+}bustrace_record_t;
+
+/**
+ * Control block, read by the host converter from a RAM dump or a file.
+ */
+typedef struct
+{
+    char id[BUSTRACE_ID_LEN];       /* BUSTRACE_ID, set by bustrace_init */
+    uint32_t clock_hz;              /* Timestamp frequency */
+    uint32_t size;                  /* Number of records, BUSTRACE_RECORDS */
+    volatile uint32_t count;        /* Records written since bustrace_init, slot count % size is next */
+    bustrace_record_t records[BUSTRACE_RECORDS];
+}bustrace_t;
+
+extern bustrace_t bustrace;
+
+/**
+ * Driver hooks.
+ */
+#if BUSTRACE_ENABLE
+#define BUSTRACE(type, bus, value)  bustrace_record((type), (uint8_t)(bus), (uint16_t)(value))
+#else
+#define BUSTRACE(type, bus, value)  do{}while(0)
+#endif
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn bustrace_init
+ *
+ * @brief function to clear the buffer and start recording.
+ *
+ * @param[in] clock_hz is the frequency of the timestamps (HCLK on the target).
+ *
+ * @return void
+ */
+void bustrace_init(uint32_t clock_hz);
+
+/**
+ * @fn bustrace_record
+ *
+ * @brief function to add a record, it is called by the driver hooks.
+ *
+ * @param[in] type from @BUSTRACE_TYPE.
+ * @param[in] bus is the port or bus number.
+ * @param[in] value is the port level or byte.
+ *
+ * @return void
+ *
+ * @note it never waits and it can be called from interrupt handlers. Nothing is recorded before
+ *       bustrace_init.
+ */
+void bustrace_record(uint8_t type, uint8_t bus, uint16_t value);
+
+/**
+ * @fn bustrace_now
+ *
+ * @brief function to get the timestamp of a record, weak (the DWT cycle counter), replaced by the
+ *        host stand-ins.
+ *
+ * @param[in] void
+ *
+ * @return timestamp.
+ */
+uint32_t bustrace_now(void);
+
+#endif /* BUSTRACE_H */
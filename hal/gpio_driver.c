@@ -0,0 +1,265 @@
+/*****************************************************************************************************
+* FILENAME :        gpio_driver.c
+*
+* DESCRIPTION :
+*       File containing the GPIO driver.
+*
+* PUBLIC FUNCTIONS :
+*       void        GPIO_Init(GPIO_Handle_t* pGPIOHandle)
+*       void        GPIO_DeInit(GPIO_RegDef_t* pGPIOx)
+*       void        GPIO_PerClkCtrl(GPIO_RegDef_t* pGPIOx, uint8_t en_or_di)
+*       uint8_t     GPIO_ReadFromInputPin(GPIO_RegDef_t* pGPIOx, uint8_t pin_number)
+*       uint16_t    GPIO_ReadFromInputPort(GPIO_RegDef_t* pGPIOx)
+*       void        GPIO_WriteToOutputPin(GPIO_RegDef_t* pGPIOx, uint8_t pin_number, uint8_t value)
+*       void        GPIO_WriteToOutputPort(GPIO_RegDef_t* pGPIOx, uint16_t value)
+*       void        GPIO_ToggleOutputPin(GPIO_RegDef_t* pGPIOx, uint8_t pin_number)
+*       void        GPIO_IRQConfig(uint8_t IRQNumber, uint8_t en_or_di)
+*       void        GPIO_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority)
+*       void        GPIO_IRQHandling(uint8_t pin_number)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+**/
+
+#include "gpio_driver.h"
+#include "stm32f446xx.h"
+#include <stdint.h>
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void GPIO_Init(GPIO_Handle_t* pGPIOHandle){
+
+    uint32_t temp = 0;
+    uint8_t pin = pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber;
+    uint8_t temp1, temp2, portcode;
+
+    /* Enable the peripheral clock */
+    GPIO_PerClkCtrl(pGPIOHandle->pGPIOx, ENABLE);
+
+    /* Configure the mode of GPIO pin */
+    if(pGPIOHandle->GPIO_PinConfig.GPIO_PinMode <= GPIO_MODE_ANALOG){
+        temp = (pGPIOHandle->GPIO_PinConfig.GPIO_PinMode << (2*pin));
+        pGPIOHandle->pGPIOx->MODER &= ~(0x3 << (2*pin));
+        pGPIOHandle->pGPIOx->MODER |= temp;
+    }
+    else{
+        /* Configure the edge trigger */
+        if(pGPIOHandle->GPIO_PinConfig.GPIO_PinMode == GPIO_MODE_IT_FT){
+            EXTI->FTSR |= (1 << pin);
+            EXTI->RTSR &= ~(1 << pin);
+        }
+        else if(pGPIOHandle->GPIO_PinConfig.GPIO_PinMode == GPIO_MODE_IT_RT){
+            EXTI->RTSR |= (1 << pin);
+            EXTI->FTSR &= ~(1 << pin);
+        }
+        else if(pGPIOHandle->GPIO_PinConfig.GPIO_PinMode == GPIO_MODE_IT_RFT){
+            EXTI->RTSR |= (1 << pin);
+            EXTI->FTSR |= (1 << pin);
+        }
+
+        /* Configure the GPIO port selection in SYSCFG_EXTICR */
+        temp1 = pin / 4;
+        temp2 = pin % 4;
+        portcode = GPIO_BASEADDR_TO_CODE(pGPIOHandle->pGPIOx);
+        SYSCFG_PCLK_EN();
+        SYSCFG->EXTICR[temp1] &= ~(0xF << (temp2*4));
+        SYSCFG->EXTICR[temp1] |= (portcode << (temp2*4));
+
+        /* Enable the EXTI interrupt delivery using IMR */
+        EXTI->IMR |= (1 << pin);
+    }
+
+    /* Configure the speed */
+    temp = (pGPIOHandle->GPIO_PinConfig.GPIO_PinSpeed << (2*pin));
+    pGPIOHandle->pGPIOx->OSPEEDER &= ~(0x3 << (2*pin));
+    pGPIOHandle->pGPIOx->OSPEEDER |= temp;
+
+    /* Configure the pull-up / pull-down settings */
+    temp = (pGPIOHandle->GPIO_PinConfig.GPIO_PinPuPdControl << (2*pin));
+    pGPIOHandle->pGPIOx->PUPDR &= ~(0x3 << (2*pin));
+    pGPIOHandle->pGPIOx->PUPDR |= temp;
+
+    /* Configure the output type */
+    temp = (pGPIOHandle->GPIO_PinConfig.GPIO_PinOPType << pin);
+    pGPIOHandle->pGPIOx->OTYPER &= ~(0x1 << pin);
+    pGPIOHandle->pGPIOx->OTYPER |= temp;
+
+    /* Configure the alternate functionality */
+    if(pGPIOHandle->GPIO_PinConfig.GPIO_PinMode == GPIO_MODE_ALTFN){
+        temp1 = pin / 8;
+        temp2 = pin % 8;
+        pGPIOHandle->pGPIOx->AFR[temp1] &= ~(0xF << (4*temp2));
+        pGPIOHandle->pGPIOx->AFR[temp1] |= (pGPIOHandle->GPIO_PinConfig.GPIO_PinAltFunMode << (4*temp2));
+    }
+}
+
+void GPIO_DeInit(GPIO_RegDef_t* pGPIOx){
+
+    if(pGPIOx == GPIOA){
+        GPIOA_REG_RESET();
+    }
+    else if(pGPIOx == GPIOB){
+        GPIOB_REG_RESET();
+    }
+    else if(pGPIOx == GPIOC){
+        GPIOC_REG_RESET();
+    }
+    else if(pGPIOx == GPIOD){
+        GPIOD_REG_RESET();
+    }
+    else if(pGPIOx == GPIOE){
+        GPIOE_REG_RESET();
+    }
+    else if(pGPIOx == GPIOF){
+        GPIOF_REG_RESET();
+    }
+    else if(pGPIOx == GPIOG){
+        GPIOG_REG_RESET();
+    }
+    else if(pGPIOx == GPIOH){
+        GPIOH_REG_RESET();
+    }
+}
+
+void GPIO_PerClkCtrl(GPIO_RegDef_t* pGPIOx, uint8_t en_or_di){
+
+    if(en_or_di == ENABLE){
+        if(pGPIOx == GPIOA){
+            GPIOA_PCLK_EN();
+        }
+        else if(pGPIOx == GPIOB){
+            GPIOB_PCLK_EN();
+        }
+        else if(pGPIOx == GPIOC){
+            GPIOC_PCLK_EN();
+        }
+        else if(pGPIOx == GPIOD){
+            GPIOD_PCLK_EN();
+        }
+        else if(pGPIOx == GPIOE){
+            GPIOE_PCLK_EN();
+        }
+        else if(pGPIOx == GPIOF){
+            GPIOF_PCLK_EN();
+        }
+        else if(pGPIOx == GPIOG){
+            GPIOG_PCLK_EN();
+        }
+        else if(pGPIOx == GPIOH){
+            GPIOH_PCLK_EN();
+        }
+    }
+    else{
+        if(pGPIOx == GPIOA){
+            GPIOA_PCLK_DI();
+        }
+        else if(pGPIOx == GPIOB){
+            GPIOB_PCLK_DI();
+        }
+        else if(pGPIOx == GPIOC){
+            GPIOC_PCLK_DI();
+        }
+        else if(pGPIOx == GPIOD){
+            GPIOD_PCLK_DI();
+        }
+        else if(pGPIOx == GPIOE){
+            GPIOE_PCLK_DI();
+        }
+        else if(pGPIOx == GPIOF){
+            GPIOF_PCLK_DI();
+        }
+        else if(pGPIOx == GPIOG){
+            GPIOG_PCLK_DI();
+        }
+        else if(pGPIOx == GPIOH){
+            GPIOH_PCLK_DI();
+        }
+    }
+}
+
+uint8_t GPIO_ReadFromInputPin(GPIO_RegDef_t* pGPIOx, uint8_t pin_number){
+
+    uint8_t value;
+
+    value = (uint8_t)((pGPIOx->IDR >> pin_number) & 0x00000001);
+
+    return value;
+}
+
+uint16_t GPIO_ReadFromInputPort(GPIO_RegDef_t* pGPIOx){
+
+    uint16_t value;
+
+    value = (uint16_t)pGPIOx->IDR;
+
+    return value;
+}
+
+void GPIO_WriteToOutputPin(GPIO_RegDef_t* pGPIOx, uint8_t pin_number, uint8_t value){
+
+    if(value == GPIO_PIN_SET){
+        pGPIOx->ODR |= (1 << pin_number);
+    }
+    else{
+        pGPIOx->ODR &= ~(1 << pin_number);
+    }
+    GPIO_TRACE(pGPIOx);
+}
+
+void GPIO_WriteToOutputPort(GPIO_RegDef_t* pGPIOx, uint16_t value){
+
+    pGPIOx->ODR = value;
+    GPIO_TRACE(pGPIOx);
+}
+
+void GPIO_ToggleOutputPin(GPIO_RegDef_t* pGPIOx, uint8_t pin_number){
+
+    pGPIOx->ODR ^= (1 << pin_number);
+    GPIO_TRACE(pGPIOx);
+}
+
+void GPIO_IRQConfig(uint8_t IRQNumber, uint8_t en_or_di){
+
+    if(en_or_di == ENABLE){
+        if(IRQNumber <= 31){
+            *NVIC_ISER0 |= (1 << IRQNumber);
+        }
+        else if(IRQNumber > 31 && IRQNumber < 64){
+            *NVIC_ISER1 |= (1 << (IRQNumber % 32));
+        }
+        else if(IRQNumber >= 64 && IRQNumber < 96){
+            *NVIC_ISER2 |= (1 << (IRQNumber % 64));
+        }
+    }
+    else{
+        if(IRQNumber <= 31){
+            *NVIC_ICER0 |= (1 << IRQNumber);
+        }
+        else if(IRQNumber > 31 && IRQNumber < 64){
+            *NVIC_ICER1 |= (1 << (IRQNumber % 32));
+        }
+        else if(IRQNumber >= 64 && IRQNumber < 96){
+            *NVIC_ICER2 |= (1 << (IRQNumber % 64));
+        }
+    }
+}
+
+void GPIO_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority){
+
+    uint8_t iprx = IRQNumber / 4;
+    uint8_t iprx_section = IRQNumber % 4;
+    uint8_t shift_amount = (8 * iprx_section) + (8 - NO_PR_BITS_IMPLEMENTED);
+
+    *(NVIC_PR_BASEADDR + iprx) |= (IRQPriority << shift_amount);
+}
+
+void GPIO_IRQHandling(uint8_t pin_number){
+
+    /* Clear the EXTI PR register corresponding to the pin number */
+    if(EXTI->PR & (1 << pin_number)){
+        EXTI->PR |= (1 << pin_number);
+    }
+}
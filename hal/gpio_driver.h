@@ -16,6 +16,24 @@
 *       void        GPIO_IRQConfig(uint8_t IRQNumber, uint8_t en_or_di)
 *       void        GPIO_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority)
 *       void        GPIO_IRQHandling(uint8_t pin_number)
+*       void        GPIO_PinSet(GPIO_Pin_t pin)
+*       void        GPIO_PinReset(GPIO_Pin_t pin)
+*       void        GPIO_PinWrite(GPIO_Pin_t pin, uint8_t value)
+*       void        GPIO_PinToggle(GPIO_Pin_t pin)
+*       uint8_t     GPIO_PinRead(GPIO_Pin_t pin)
+*       void        GPIO_PinsWrite(GPIO_Pin_t pins, uint16_t value)
+*
+* NOTES :
+*       The GPIO_Pin* functions are the inline fast path for pins already configured with GPIO_Init.
+*       A pin is described by a GPIO_Pin_t built from constants (GPIO_PIN / GPIO_PINS), so every
+*       write compiles to a single store to BSRR, without a call or a read-modify-write of ODR, and
+*       several pins of the same port are written at once with GPIO_PinsWrite. The writes are atomic,
+*       no interrupt lock is needed when an ISR drives other pins of the same port.
+*
+*       With GPIO_SIM defined (host build) the register accesses are routed to gpio_sim.c.
+*
+*       With BUSTRACE_ENABLE (bustrace.h) every output write is recorded with the new level of the
+*       port, which costs an ODR read and a call per write.
 *
 **/
 
@@ -24,6 +42,7 @@
 
 #include <stdint.h>
 #include "stm32f446xx.h"
+#include "bustrace.h"
 
 /**
  * @GPIO_PIN_NO
@@ -104,6 +123,49 @@ typedef struct
     GPIO_PinConfig_t GPIO_PinConfig;    /* GPIO pin configuration settings */
 }GPIO_Handle_t;
 
+/**
+ * Descriptor of one or several pins of a GPIO port, for the inline fast path.
+ */
+typedef struct
+{
+    GPIO_RegDef_t* pGPIOx;              /* Base address of the GPIO port */
+    uint16_t mask;                      /* Bit mask of the pins, bit n is pin n */
+}GPIO_Pin_t;
+
+/**
+ * @GPIO_PIN_DESC
+ * Build a pin descriptor, port and pins must be constants (e.g. GPIO_PIN(GPIOC, GPIO_PIN_NO_8)).
+ */
+#define GPIO_PIN(port, pin_number)  ((GPIO_Pin_t){(port), (uint16_t)(1U << (pin_number))})
+#define GPIO_PINS(port, mask)       ((GPIO_Pin_t){(port), (uint16_t)(mask)})
+
+/**
+ * Register accesses of the inline fast path.
+ */
+#ifndef GPIO_SIM
+#define GPIO_FAST_BSRR(pGPIOx, value)   ((pGPIOx)->BSRR = (value))
+#define GPIO_FAST_ODR(pGPIOx)           ((pGPIOx)->ODR)
+#define GPIO_FAST_IDR(pGPIOx)           ((pGPIOx)->IDR)
+#else
+void gpio_sim_write_bsrr(GPIO_RegDef_t* pGPIOx, uint32_t value);
+uint32_t gpio_sim_read_odr(GPIO_RegDef_t* pGPIOx);
+uint32_t gpio_sim_read_idr(GPIO_RegDef_t* pGPIOx);
+#define GPIO_FAST_BSRR(pGPIOx, value)   gpio_sim_write_bsrr((pGPIOx), (value))
+#define GPIO_FAST_ODR(pGPIOx)           gpio_sim_read_odr(pGPIOx)
+#define GPIO_FAST_IDR(pGPIOx)           gpio_sim_read_idr(pGPIOx)
+#endif
+
+#define GPIO_INLINE     static inline __attribute__((always_inline))
+
+/**
+ * Record the output level of a port after a write (bustrace.h), gpio_sim.c records its own writes.
+ */
+#if BUSTRACE_ENABLE && !defined(GPIO_SIM)
+#define GPIO_TRACE(pGPIOx)      BUSTRACE(BUSTRACE_GPIO, GPIO_BASEADDR_TO_CODE(pGPIOx), GPIO_FAST_ODR(pGPIOx))
+#else
+#define GPIO_TRACE(pGPIOx)      do{}while(0)
+#endif
+
 /*****************************************************************************************************/
 /*                                       APIs Supported                                              */
 /*****************************************************************************************************/
@@ -237,4 +299,104 @@ void GPIO_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority);
  */
 void GPIO_IRQHandling(uint8_t pin_number);
 
+/*****************************************************************************************************/
+/*                                       Inline Fast Path                                            */
+/*****************************************************************************************************/
+
+/**
+ * @fn GPIO_PinSet
+ *
+ * @brief function to drive high the pins of a descriptor, one BSRR store.
+ *
+ * @param[in] pin descriptor of the pins, from @GPIO_PIN_DESC.
+ *
+ * @return void.
+ */
+GPIO_INLINE void GPIO_PinSet(GPIO_Pin_t pin){
+
+    GPIO_FAST_BSRR(pin.pGPIOx, pin.mask);
+    GPIO_TRACE(pin.pGPIOx);
+}
+
+/**
+ * @fn GPIO_PinReset
+ *
+ * @brief function to drive low the pins of a descriptor, one BSRR store.
+ *
+ * @param[in] pin descriptor of the pins, from @GPIO_PIN_DESC.
+ *
+ * @return void.
+ */
+GPIO_INLINE void GPIO_PinReset(GPIO_Pin_t pin){
+
+    GPIO_FAST_BSRR(pin.pGPIOx, (uint32_t)pin.mask << 16);
+    GPIO_TRACE(pin.pGPIOx);
+}
+
+/**
+ * @fn GPIO_PinWrite
+ *
+ * @brief function to drive all the pins of a descriptor to the same level, one BSRR store.
+ *
+ * @param[in] pin descriptor of the pins, from @GPIO_PIN_DESC.
+ * @param[in] value GPIO_PIN_SET or GPIO_PIN_RESET.
+ *
+ * @return void.
+ */
+GPIO_INLINE void GPIO_PinWrite(GPIO_Pin_t pin, uint8_t value){
+
+    GPIO_FAST_BSRR(pin.pGPIOx, value ? (uint32_t)pin.mask : ((uint32_t)pin.mask << 16));
+    GPIO_TRACE(pin.pGPIOx);
+}
+
+/**
+ * @fn GPIO_PinToggle
+ *
+ * @brief function to toggle the pins of a descriptor, one ODR read and one BSRR store.
+ *
+ * @param[in] pin descriptor of the pins, from @GPIO_PIN_DESC.
+ *
+ * @return void.
+ *
+ * @note: a pin changed by an ISR between the read and the store is not affected, but the toggle
+ *        itself uses the level read before the ISR.
+ */
+GPIO_INLINE void GPIO_PinToggle(GPIO_Pin_t pin){
+
+    uint32_t odr = GPIO_FAST_ODR(pin.pGPIOx);
+
+    GPIO_FAST_BSRR(pin.pGPIOx, ((odr & pin.mask) << 16) | (~odr & pin.mask));
+    GPIO_TRACE(pin.pGPIOx);
+}
+
+/**
+ * @fn GPIO_PinRead
+ *
+ * @brief function to read the input level of the pins of a descriptor.
+ *
+ * @param[in] pin descriptor of the pins, from @GPIO_PIN_DESC.
+ *
+ * @return 1 if any pin of the descriptor is high, 0 otherwise.
+ */
+GPIO_INLINE uint8_t GPIO_PinRead(GPIO_Pin_t pin){
+
+    return (GPIO_FAST_IDR(pin.pGPIOx) & pin.mask) ? 1 : 0;
+}
+
+/**
+ * @fn GPIO_PinsWrite
+ *
+ * @brief function to write several pins of the same port at once, one BSRR store.
+ *
+ * @param[in] pins descriptor of the pins, from @GPIO_PIN_DESC.
+ * @param[in] value level of every pin, bit n is pin n, the bits out of the descriptor are ignored.
+ *
+ * @return void.
+ */
+GPIO_INLINE void GPIO_PinsWrite(GPIO_Pin_t pins, uint16_t value){
+
+    GPIO_FAST_BSRR(pins.pGPIOx, ((uint32_t)(pins.mask & ~value) << 16) | (pins.mask & value));
+    GPIO_TRACE(pins.pGPIOx);
+}
+
 #endif
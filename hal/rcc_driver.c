@@ -0,0 +1,410 @@
+/*****************************************************************************************************
+* FILENAME :        rcc_driver.c
+*
+* DESCRIPTION :
+*       File containing the RCC driver: clock tree configuration and clock frequencies.
+*
+* PUBLIC FUNCTIONS :
+*       uint8_t     RCC_ClockConfig(const RCC_Config_t* pRCCConfig)
+*       uint8_t     RCC_ClockRestore(const RCC_Config_t* pRCCConfig)
+*       uint32_t    RCC_GetSYSCLKValue(void)
+*       uint32_t    RCC_GetHCLKValue(void)
+*       uint32_t    RCC_GetPCLK1Value(void)
+*       uint32_t    RCC_GetPCLK2Value(void)
+*       uint32_t    RCC_GetTIMCLK1Value(void)
+*       uint32_t    RCC_GetTIMCLK2Value(void)
+*       uint32_t    RCC_GetPLLOutputClock(void)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+*       This file replaces rcc_driver.o of the former prebuilt libstm32f446xx.a, whose
+*       RCC_GetPLLOutputClock always returned 0 (so the I2C timings and the USART baud rate were
+*       wrong with the PLL as system clock).
+*
+*       Nothing here may use .data or .bss, RCC_ClockConfig is called before they are initialized.
+*
+**/
+
+#include "rcc_driver.h"
+#include "stm32f446xx.h"
+#include <stdint.h>
+
+#define RCC_READY_TIMEOUT   100000  /* Polling iterations, several ms at 16 MHz */
+#define RCC_VCO_IN_MIN      1000000U
+#define RCC_VCO_IN_MAX      2000000U
+#define RCC_VCO_OUT_MIN     100000000U
+#define RCC_VCO_OUT_MAX     432000000U
+
+static const uint16_t AHB_PreScaler[8] = {2, 4, 8, 16, 64, 128, 256, 512};
+static const uint8_t APB_PreScaler[4] = {2, 4, 8, 16};
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn rcc_wait
+ *
+ * @brief helper function to wait for a register bit to reach a level.
+ *
+ * @param[in] reg is the register.
+ * @param[in] bit is the bit position.
+ * @param[in] level is the expected value of the bit (0 or 1).
+ *
+ * @return 0 if the level is reached, 1 on timeout.
+ */
+static uint8_t rcc_wait(volatile uint32_t* reg, uint8_t bit, uint8_t level);
+
+/**
+ * @fn rcc_ahb_div
+ *
+ * @brief helper function to decode the AHB prescaler.
+ *
+ * @param[in] hpre is the HPRE field value, from @RCC_AHB_PRESCALER.
+ *
+ * @return division factor.
+ */
+static uint32_t rcc_ahb_div(uint8_t hpre);
+
+/**
+ * @fn rcc_apb_div
+ *
+ * @brief helper function to decode an APB prescaler.
+ *
+ * @param[in] ppre is the PPREx field value, from @RCC_APB_PRESCALER.
+ *
+ * @return division factor.
+ */
+static uint32_t rcc_apb_div(uint8_t ppre);
+
+/**
+ * @fn rcc_get_vco_clock
+ *
+ * @brief helper function to get the VCO output frequency of the main PLL.
+ *
+ * @param[in] void.
+ *
+ * @return frequency in Hz, 0 if PLLM is not valid.
+ */
+static uint32_t rcc_get_vco_clock(void);
+
+/**
+ * @fn rcc_set_flash_latency
+ *
+ * @brief helper function to set the flash wait states and wait until they are applied.
+ *
+ * @param[in] latency is the number of wait states.
+ *
+ * @return void.
+ */
+static void rcc_set_flash_latency(uint32_t latency);
+
+/**
+ * @fn rcc_art_enable
+ *
+ * @brief helper function to reset and enable the ART accelerator caches and the prefetch.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ */
+static void rcc_art_enable(void);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+uint8_t RCC_ClockConfig(const RCC_Config_t* pRCCConfig){
+
+    uint8_t use_hse = 0;
+    uint32_t src = RCC_HSI_VALUE;
+    uint32_t vco_in = 0;
+    uint32_t vco_out = 0;
+    uint32_t sysclk = 0;
+    uint32_t hclk = 0;
+    uint32_t latency = 0;
+
+    /* Compute and check the resulting frequencies before touching anything */
+    if(pRCCConfig->RCC_ClkSource == RCC_CLK_SOURCE_PLL){
+        use_hse = (pRCCConfig->RCC_PLLSource == RCC_CLK_SOURCE_HSE) ? 1 : 0;
+        src = use_hse ? RCC_HSE_VALUE : RCC_HSI_VALUE;
+
+        if((pRCCConfig->RCC_PLLM < 2) || (pRCCConfig->RCC_PLLM > 63) ||
+           (pRCCConfig->RCC_PLLN < 50) || (pRCCConfig->RCC_PLLN > 432) ||
+           (pRCCConfig->RCC_PLLP < 2) || (pRCCConfig->RCC_PLLP > 8) || (pRCCConfig->RCC_PLLP & 1) ||
+           (pRCCConfig->RCC_PLLQ < 2) || (pRCCConfig->RCC_PLLQ > 15)){
+            return RCC_ERR_CONFIG;
+        }
+
+        vco_in = src / pRCCConfig->RCC_PLLM;
+        vco_out = vco_in * pRCCConfig->RCC_PLLN;
+        if((vco_in < RCC_VCO_IN_MIN) || (vco_in > RCC_VCO_IN_MAX) ||
+           (vco_out < RCC_VCO_OUT_MIN) || (vco_out > RCC_VCO_OUT_MAX)){
+            return RCC_ERR_CONFIG;
+        }
+        sysclk = vco_out / pRCCConfig->RCC_PLLP;
+    }
+    else if(pRCCConfig->RCC_ClkSource == RCC_CLK_SOURCE_HSE){
+        use_hse = 1;
+        sysclk = RCC_HSE_VALUE;
+    }
+    else{
+        sysclk = RCC_HSI_VALUE;
+    }
+
+    hclk = sysclk / rcc_ahb_div(pRCCConfig->RCC_AHBPrescaler);
+    if((sysclk > RCC_SYSCLK_MAX) ||
+       ((hclk / rcc_apb_div(pRCCConfig->RCC_APB1Prescaler)) > RCC_PCLK1_MAX) ||
+       ((hclk / rcc_apb_div(pRCCConfig->RCC_APB2Prescaler)) > RCC_PCLK2_MAX)){
+        return RCC_ERR_CONFIG;
+    }
+    latency = (hclk - 1) / RCC_FLASH_WS_HZ;
+
+    /* Run from HSI while the oscillators and the PLL are changed, the wait states are kept */
+    RCC->CR |= (1 << RCC_CR_HSION);
+    rcc_wait(&RCC->CR, RCC_CR_HSIRDY, 1);
+    RCC->CFGR &= ~(0x3 << RCC_CFGR_SW);
+    while(((RCC->CFGR >> RCC_CFGR_SWS) & 0x3) != RCC_CLK_SOURCE_HSI);
+
+    RCC->CR &= ~(1 << RCC_CR_PLLON);
+    rcc_wait(&RCC->CR, RCC_CR_PLLRDY, 0);
+
+    /* HSEBYP can only be written with HSE off */
+    RCC->CR &= ~(1 << RCC_CR_HSEON);
+    rcc_wait(&RCC->CR, RCC_CR_HSERDY, 0);
+    if(use_hse){
+        if(pRCCConfig->RCC_HSEBypass == ENABLE){
+            RCC->CR |= (1 << RCC_CR_HSEBYP);
+        }
+        else{
+            RCC->CR &= ~(1 << RCC_CR_HSEBYP);
+        }
+        RCC->CR |= (1 << RCC_CR_HSEON);
+        if(rcc_wait(&RCC->CR, RCC_CR_HSERDY, 1)){
+            RCC->CR &= ~(1 << RCC_CR_HSEON);
+            return RCC_ERR_HSE;
+        }
+    }
+
+    /* Voltage scale 1, it can only be written with the PLL off and it applies once the PLL is on */
+    PWR_PCLK_EN();
+    PWR->CR |= (0x3 << PWR_CR_VOS);
+
+    if(pRCCConfig->RCC_ClkSource == RCC_CLK_SOURCE_PLL){
+        RCC->PLLCFGR = (RCC->PLLCFGR & (0x7 << RCC_PLLCFGR_PLLR)) |
+                       ((uint32_t)pRCCConfig->RCC_PLLM << RCC_PLLCFGR_PLLM) |
+                       ((uint32_t)pRCCConfig->RCC_PLLN << RCC_PLLCFGR_PLLN) |
+                       ((uint32_t)((pRCCConfig->RCC_PLLP / 2) - 1) << RCC_PLLCFGR_PLLP) |
+                       ((uint32_t)use_hse << RCC_PLLCFGR_PLLSRC) |
+                       ((uint32_t)pRCCConfig->RCC_PLLQ << RCC_PLLCFGR_PLLQ);
+        RCC->CR |= (1 << RCC_CR_PLLON);
+    }
+
+    /* Over-drive is enabled while the PLL locks, HCLK above 168 MHz needs it */
+    if(hclk > RCC_SYSCLK_NO_OD_MAX){
+        PWR->CR |= (1 << PWR_CR_ODEN);
+        if(rcc_wait(&PWR->CSR, PWR_CSR_ODRDY, 1)){
+            return RCC_ERR_OVERDRIVE;
+        }
+        PWR->CR |= (1 << PWR_CR_ODSWEN);
+        if(rcc_wait(&PWR->CSR, PWR_CSR_ODSWRDY, 1)){
+            return RCC_ERR_OVERDRIVE;
+        }
+    }
+    else{
+        PWR->CR &= ~((1 << PWR_CR_ODEN) | (1 << PWR_CR_ODSWEN));
+    }
+
+    if(pRCCConfig->RCC_ClkSource == RCC_CLK_SOURCE_PLL){
+        if(rcc_wait(&RCC->CR, RCC_CR_PLLRDY, 1)){
+            RCC->CR &= ~(1 << RCC_CR_PLLON);
+            return RCC_ERR_PLL;
+        }
+    }
+
+    /* More wait states before raising the clock */
+    if(latency > ((FLASH->ACR >> FLASH_ACR_LATENCY) & 0xF)){
+        rcc_set_flash_latency(latency);
+    }
+    rcc_art_enable();
+
+    /* APB prescalers at their maximum during the switch, so the APB limits are never exceeded */
+    RCC->CFGR = (RCC->CFGR & ~((0xF << RCC_CFGR_HPRE) | (0x7 << RCC_CFGR_PPRE1) | (0x7 << RCC_CFGR_PPRE2))) |
+                ((uint32_t)pRCCConfig->RCC_AHBPrescaler << RCC_CFGR_HPRE) |
+                (RCC_APB_DIV16 << RCC_CFGR_PPRE1) |
+                (RCC_APB_DIV16 << RCC_CFGR_PPRE2);
+
+    RCC->CFGR |= ((uint32_t)pRCCConfig->RCC_ClkSource << RCC_CFGR_SW);
+    while(((RCC->CFGR >> RCC_CFGR_SWS) & 0x3) != pRCCConfig->RCC_ClkSource);
+
+    RCC->CFGR = (RCC->CFGR & ~((0x7 << RCC_CFGR_PPRE1) | (0x7 << RCC_CFGR_PPRE2))) |
+                ((uint32_t)pRCCConfig->RCC_APB1Prescaler << RCC_CFGR_PPRE1) |
+                ((uint32_t)pRCCConfig->RCC_APB2Prescaler << RCC_CFGR_PPRE2);
+
+    /* Fewer wait states once the clock is lowered */
+    if(latency < ((FLASH->ACR >> FLASH_ACR_LATENCY) & 0xF)){
+        rcc_set_flash_latency(latency);
+    }
+
+    return RCC_OK;
+}
+
+uint8_t RCC_ClockRestore(const RCC_Config_t* pRCCConfig){
+
+    uint32_t hclk = 0;
+
+    if(pRCCConfig->RCC_ClkSource == RCC_CLK_SOURCE_HSI){
+        return RCC_OK;
+    }
+
+    /* HSEBYP, PLLCFGR, the prescalers and the wait states are kept in Stop mode */
+    if((pRCCConfig->RCC_ClkSource == RCC_CLK_SOURCE_HSE) || (pRCCConfig->RCC_PLLSource == RCC_CLK_SOURCE_HSE)){
+        RCC->CR |= (1 << RCC_CR_HSEON);
+        if(rcc_wait(&RCC->CR, RCC_CR_HSERDY, 1)){
+            RCC->CR &= ~(1 << RCC_CR_HSEON);
+            return RCC_ERR_HSE;
+        }
+    }
+
+    if(pRCCConfig->RCC_ClkSource == RCC_CLK_SOURCE_PLL){
+        RCC->CR |= (1 << RCC_CR_PLLON);
+
+        /* Over-drive is switched off by Stop mode, it is enabled again while the PLL locks */
+        hclk = RCC_GetPLLOutputClock() / rcc_ahb_div(pRCCConfig->RCC_AHBPrescaler);
+        if(hclk > RCC_SYSCLK_NO_OD_MAX){
+            PWR->CR |= (1 << PWR_CR_ODEN);
+            if(rcc_wait(&PWR->CSR, PWR_CSR_ODRDY, 1)){
+                return RCC_ERR_OVERDRIVE;
+            }
+            PWR->CR |= (1 << PWR_CR_ODSWEN);
+            if(rcc_wait(&PWR->CSR, PWR_CSR_ODSWRDY, 1)){
+                return RCC_ERR_OVERDRIVE;
+            }
+        }
+
+        if(rcc_wait(&RCC->CR, RCC_CR_PLLRDY, 1)){
+            RCC->CR &= ~(1 << RCC_CR_PLLON);
+            return RCC_ERR_PLL;
+        }
+    }
+
+    RCC->CFGR = (RCC->CFGR & ~(0x3 << RCC_CFGR_SW)) | ((uint32_t)pRCCConfig->RCC_ClkSource << RCC_CFGR_SW);
+    while(((RCC->CFGR >> RCC_CFGR_SWS) & 0x3) != pRCCConfig->RCC_ClkSource);
+
+    return RCC_OK;
+}
+
+uint32_t RCC_GetSYSCLKValue(void){
+
+    uint32_t sysclk = 0;
+
+    switch((RCC->CFGR >> RCC_CFGR_SWS) & 0x3){
+        case RCC_CLK_SOURCE_HSI:
+            sysclk = RCC_HSI_VALUE;
+            break;
+        case RCC_CLK_SOURCE_HSE:
+            sysclk = RCC_HSE_VALUE;
+            break;
+        case RCC_CLK_SOURCE_PLL:
+            sysclk = RCC_GetPLLOutputClock();
+            break;
+        default:
+            /* PLL R output */
+            sysclk = rcc_get_vco_clock() / ((RCC->PLLCFGR >> RCC_PLLCFGR_PLLR) & 0x7);
+            break;
+    }
+
+    return sysclk;
+}
+
+uint32_t RCC_GetHCLKValue(void){
+
+    return RCC_GetSYSCLKValue() / rcc_ahb_div((RCC->CFGR >> RCC_CFGR_HPRE) & 0xF);
+}
+
+uint32_t RCC_GetPCLK1Value(void){
+
+    return RCC_GetHCLKValue() / rcc_apb_div((RCC->CFGR >> RCC_CFGR_PPRE1) & 0x7);
+}
+
+uint32_t RCC_GetPCLK2Value(void){
+
+    return RCC_GetHCLKValue() / rcc_apb_div((RCC->CFGR >> RCC_CFGR_PPRE2) & 0x7);
+}
+
+uint32_t RCC_GetTIMCLK1Value(void){
+
+    uint32_t pclk1 = RCC_GetPCLK1Value();
+
+    return (((RCC->CFGR >> RCC_CFGR_PPRE1) & 0x7) < RCC_APB_DIV2) ? pclk1 : (2 * pclk1);
+}
+
+uint32_t RCC_GetTIMCLK2Value(void){
+
+    uint32_t pclk2 = RCC_GetPCLK2Value();
+
+    return (((RCC->CFGR >> RCC_CFGR_PPRE2) & 0x7) < RCC_APB_DIV2) ? pclk2 : (2 * pclk2);
+}
+
+uint32_t RCC_GetPLLOutputClock(void){
+
+    uint32_t pllp = (((RCC->PLLCFGR >> RCC_PLLCFGR_PLLP) & 0x3) + 1) * 2;
+
+    return rcc_get_vco_clock() / pllp;
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static uint8_t rcc_wait(volatile uint32_t* reg, uint8_t bit, uint8_t level){
+
+    uint32_t timeout = RCC_READY_TIMEOUT;
+
+    while((((*reg >> bit) & 0x1) != level) && timeout){
+        timeout--;
+    }
+
+    return (((*reg >> bit) & 0x1) == level) ? 0 : 1;
+}
+
+static uint32_t rcc_ahb_div(uint8_t hpre){
+
+    return (hpre < RCC_AHB_DIV2) ? 1 : AHB_PreScaler[hpre - RCC_AHB_DIV2];
+}
+
+static uint32_t rcc_apb_div(uint8_t ppre){
+
+    return (ppre < RCC_APB_DIV2) ? 1 : APB_PreScaler[ppre - RCC_APB_DIV2];
+}
+
+static uint32_t rcc_get_vco_clock(void){
+
+    uint32_t src = (RCC->PLLCFGR & (1 << RCC_PLLCFGR_PLLSRC)) ? RCC_HSE_VALUE : RCC_HSI_VALUE;
+    uint32_t pllm = (RCC->PLLCFGR >> RCC_PLLCFGR_PLLM) & 0x3F;
+    uint32_t plln = (RCC->PLLCFGR >> RCC_PLLCFGR_PLLN) & 0x1FF;
+
+    if(pllm < 2){
+        return 0;
+    }
+
+    return (src / pllm) * plln;
+}
+
+static void rcc_set_flash_latency(uint32_t latency){
+
+    FLASH->ACR = (FLASH->ACR & ~(0xF << FLASH_ACR_LATENCY)) | (latency << FLASH_ACR_LATENCY);
+
+    /* The new value must be read back before the clock changes */
+    while(((FLASH->ACR >> FLASH_ACR_LATENCY) & 0xF) != latency);
+}
+
+static void rcc_art_enable(void){
+
+    /* The caches can only be reset while they are disabled */
+    FLASH->ACR &= ~((1 << FLASH_ACR_ICEN) | (1 << FLASH_ACR_DCEN));
+    FLASH->ACR |= (1 << FLASH_ACR_ICRST) | (1 << FLASH_ACR_DCRST);
+    FLASH->ACR &= ~((1 << FLASH_ACR_ICRST) | (1 << FLASH_ACR_DCRST));
+    FLASH->ACR |= (1 << FLASH_ACR_PRFTEN) | (1 << FLASH_ACR_ICEN) | (1 << FLASH_ACR_DCEN);
+}
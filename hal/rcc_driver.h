@@ -0,0 +1,218 @@
+/*****************************************************************************************************
+* FILENAME :        rcc_driver.h
+*
+* DESCRIPTION :
+*       Header file containing the prototypes of the APIs for configuring the clock tree and getting
+*       the resulting clock frequencies.
+*
+* PUBLIC FUNCTIONS :
+*       uint8_t     RCC_ClockConfig(const RCC_Config_t* pRCCConfig)
+*       uint8_t     RCC_ClockRestore(const RCC_Config_t* pRCCConfig)
+*       uint32_t    RCC_GetSYSCLKValue(void)
+*       uint32_t    RCC_GetHCLKValue(void)
+*       uint32_t    RCC_GetPCLK1Value(void)
+*       uint32_t    RCC_GetPCLK2Value(void)
+*       uint32_t    RCC_GetTIMCLK1Value(void)
+*       uint32_t    RCC_GetTIMCLK2Value(void)
+*       uint32_t    RCC_GetPLLOutputClock(void)
+*
+* NOTES :
+*       The frequencies are computed from the RCC registers, so they are always the ones of the
+*       running clock tree. The I2C and USART drivers take their timings from RCC_GetPCLKxValue, so
+*       those peripherals must be initialized again if the clock tree changes.
+*
+**/
+
+#ifndef RCC_DRIVER_H
+#define RCC_DRIVER_H
+
+#include <stdint.h>
+#include "stm32f446xx.h"
+
+/**
+ * Oscillator frequencies.
+ */
+#define RCC_HSI_VALUE               16000000U
+#define RCC_HSE_VALUE               8000000U    /* NUCLEO-F446RE: MCO of the ST-LINK */
+
+/**
+ * Limits of the clock tree, voltage scale 1 with over-drive and VDD 2.7V to 3.6V.
+ */
+#define RCC_SYSCLK_MAX              180000000U
+#define RCC_SYSCLK_NO_OD_MAX        168000000U  /* Highest HCLK without over-drive */
+#define RCC_PCLK1_MAX               45000000U
+#define RCC_PCLK2_MAX               90000000U
+#define RCC_FLASH_WS_HZ             30000000U   /* HCLK range covered by every flash wait state */
+
+/**
+ * @RCC_CLK_SOURCE
+ * RCC possible clock sources.
+ */
+#define RCC_CLK_SOURCE_HSI          0
+#define RCC_CLK_SOURCE_HSE          1
+#define RCC_CLK_SOURCE_PLL          2
+
+/**
+ * @RCC_AHB_PRESCALER
+ * RCC possible AHB prescaler values, HCLK = SYSCLK / prescaler.
+ */
+#define RCC_AHB_DIV1                0
+#define RCC_AHB_DIV2                8
+#define RCC_AHB_DIV4                9
+#define RCC_AHB_DIV8                10
+#define RCC_AHB_DIV16               11
+#define RCC_AHB_DIV64               12
+#define RCC_AHB_DIV128              13
+#define RCC_AHB_DIV256              14
+#define RCC_AHB_DIV512              15
+
+/**
+ * @RCC_APB_PRESCALER
+ * RCC possible APB prescaler values, PCLKx = HCLK / prescaler.
+ */
+#define RCC_APB_DIV1                0
+#define RCC_APB_DIV2                4
+#define RCC_APB_DIV4                5
+#define RCC_APB_DIV8                6
+#define RCC_APB_DIV16               7
+
+/**
+ * @RCC_STATUS
+ * RCC possible results of the clock configuration.
+ */
+#define RCC_OK                      0
+#define RCC_ERR_CONFIG              1   /* Frequencies out of the limits, nothing is changed */
+#define RCC_ERR_HSE                 2   /* HSE not ready, the system clock is HSI */
+#define RCC_ERR_PLL                 3   /* PLL not locked, the system clock is HSI */
+#define RCC_ERR_OVERDRIVE           4   /* Over-drive not ready, the system clock is HSI */
+
+/**
+ * Configuration structure for the clock tree.
+ */
+typedef struct
+{
+    uint8_t RCC_ClkSource;          /* System clock, possible values from @RCC_CLK_SOURCE */
+    uint8_t RCC_PLLSource;          /* RCC_CLK_SOURCE_HSI or RCC_CLK_SOURCE_HSE */
+    uint8_t RCC_HSEBypass;          /* ENABLE for an external clock on OSC_IN, DISABLE for a crystal */
+    uint8_t RCC_PLLM;               /* 2 to 63, VCO input = PLL source / PLLM, 1 to 2 MHz */
+    uint16_t RCC_PLLN;              /* 50 to 432, VCO output = VCO input * PLLN, 100 to 432 MHz */
+    uint8_t RCC_PLLP;               /* 2, 4, 6 or 8, PLL output = VCO output / PLLP */
+    uint8_t RCC_PLLQ;               /* 2 to 15, 48 MHz domain = VCO output / PLLQ */
+    uint8_t RCC_AHBPrescaler;       /* Possible values from @RCC_AHB_PRESCALER */
+    uint8_t RCC_APB1Prescaler;      /* Possible values from @RCC_APB_PRESCALER */
+    uint8_t RCC_APB2Prescaler;      /* Possible values from @RCC_APB_PRESCALER */
+}RCC_Config_t;
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn RCC_ClockConfig
+ *
+ * @brief function to configure the clock tree: oscillators, PLL, voltage scale and over-drive, flash
+ *        wait states, ART accelerator (prefetch, instruction and data caches) and bus prescalers.
+ *
+ * @param[in] pRCCConfig configuration structure for the clock tree.
+ *
+ * @return possible values from @RCC_STATUS.
+ *
+ * @note it uses neither .data nor .bss, so it can be called by Reset_Handler before they are
+ *       initialized.
+ */
+uint8_t RCC_ClockConfig(const RCC_Config_t* pRCCConfig);
+
+/**
+ * @fn RCC_ClockRestore
+ *
+ * @brief function to switch back to a clock tree set up by RCC_ClockConfig after Stop mode, which
+ *        leaves HSI as system clock with HSE, the PLL and over-drive off: only the oscillator and the
+ *        PLL of the configuration are started again.
+ *
+ * @param[in] pRCCConfig configuration structure last applied by RCC_ClockConfig.
+ *
+ * @return possible values from @RCC_STATUS.
+ *
+ * @note the PLL factors, the prescalers, the voltage scale and the flash wait states are the ones
+ *       kept by the registers, they are not written again.
+ */
+uint8_t RCC_ClockRestore(const RCC_Config_t* pRCCConfig);
+
+/**
+ * @fn RCC_GetSYSCLKValue
+ *
+ * @brief function to get the system clock frequency.
+ *
+ * @param[in] void
+ *
+ * @return frequency in Hz.
+ */
+uint32_t RCC_GetSYSCLKValue(void);
+
+/**
+ * @fn RCC_GetHCLKValue
+ *
+ * @brief function to get the AHB clock frequency, which is the core, SysTick and DWT clock.
+ *
+ * @param[in] void
+ *
+ * @return frequency in Hz.
+ */
+uint32_t RCC_GetHCLKValue(void);
+
+/**
+ * @fn RCC_GetPCLK1Value
+ *
+ * @brief function to get the APB1 peripheral clock frequency.
+ *
+ * @param[in] void
+ *
+ * @return frequency in Hz.
+ */
+uint32_t RCC_GetPCLK1Value(void);
+
+/**
+ * @fn RCC_GetPCLK2Value
+ *
+ * @brief function to get the APB2 peripheral clock frequency.
+ *
+ * @param[in] void
+ *
+ * @return frequency in Hz.
+ */
+uint32_t RCC_GetPCLK2Value(void);
+
+/**
+ * @fn RCC_GetTIMCLK1Value
+ *
+ * @brief function to get the clock frequency of the timers on APB1.
+ *
+ * @param[in] void
+ *
+ * @return frequency in Hz, twice PCLK1 if the APB1 prescaler is not 1.
+ */
+uint32_t RCC_GetTIMCLK1Value(void);
+
+/**
+ * @fn RCC_GetTIMCLK2Value
+ *
+ * @brief function to get the clock frequency of the timers on APB2.
+ *
+ * @param[in] void
+ *
+ * @return frequency in Hz, twice PCLK2 if the APB2 prescaler is not 1.
+ */
+uint32_t RCC_GetTIMCLK2Value(void);
+
+/**
+ * @fn RCC_GetPLLOutputClock
+ *
+ * @brief function to get the frequency of the main PLL P output.
+ *
+ * @param[in] void
+ *
+ * @return frequency in Hz.
+ */
+uint32_t RCC_GetPLLOutputClock(void);
+
+#endif /* RCC_DRIVER_H */
@@ -0,0 +1,432 @@
+/*****************************************************************************************************
+* FILENAME :        spi_driver.c
+*
+* DESCRIPTION :
+*       File containing the SPI driver.
+*
+* PUBLIC FUNCTIONS :
+*       void    SPI_Init(SPI_Handle_t* pSPIHandle)
+*       void    SPI_DeInit(SPI_RegDef_t* pSPIx)
+*       void    SPI_PerClkCtrl(SPI_RegDef_t* pSPIx, uint8_t en_or_di)
+*       void    SPI_SendData(SPI_RegDef_t* pSPIx, uint8_t* pTxBuffer, uint32_t len)
+*       void    SPI_ReceiveData(SPI_RegDef_t* pSPIx, uint8_t* pRxBuffer, uint32_t len)
+*       uint8_t SPI_SendDataIT(SPI_Handle_t* pSPIHandle, uint8_t* pTxBuffer, uint32_t len)
+*       uint8_t SPI_ReceiveDataIT(SPI_Handle_t* pSPIHandle, uint8_t* pRxBuffer, uint32_t len)
+*       void    SPI_IRQConfig(uint8_t IRQNumber, uint8_t en_or_di)
+*       void    SPI_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority)
+*       void    SPI_IRQHandling(SPI_Handle_t* pSPIHandle)
+*       void    SPI_Enable(SPI_RegDef_t* pSPIx, uint8_t en_or_di)
+*       void    SPI_SSICfg(SPI_RegDef_t* pSPIx, uint8_t en_or_di)
+*       void    SPI_SSOECfg(SPI_RegDef_t* pSPIx, uint8_t en_or_di)
+*       uint8_t SPI_GetFlagStatus(SPI_RegDef_t* pSPIx, uint32_t flagname)
+*       void    SPI_ClearOVRFlag(SPI_RegDef_t* pSPIx)
+*       void    SPI_CloseTx(SPI_Handle_t* pSPIHandle)
+*       void    SPI_CloseRx(SPI_Handle_t* pSPIHandle)
+*       void    SPI_ApplicationEventCallback(SPI_Handle_t* pSPIHandle, uint8_t app_event)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+**/
+
+#include "spi_driver.h"
+#include "stm32f446xx.h"
+#include <stdint.h>
+#include <stddef.h>
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn spi_txe_interrupt_handle
+ *
+ * @brief function to send the next data frame of a SPI_SendDataIT transfer.
+ *
+ * @param[in] pSPIHandle handle structure for the SPI peripheral.
+ *
+ * @return void
+ */
+static void spi_txe_interrupt_handle(SPI_Handle_t* pSPIHandle);
+
+/**
+ * @fn spi_rxne_interrupt_handle
+ *
+ * @brief function to store the next data frame of a SPI_ReceiveDataIT transfer.
+ *
+ * @param[in] pSPIHandle handle structure for the SPI peripheral.
+ *
+ * @return void
+ */
+static void spi_rxne_interrupt_handle(SPI_Handle_t* pSPIHandle);
+
+/**
+ * @fn spi_ovr_err_interrupt_handle
+ *
+ * @brief function to clear the overrun flag and inform the application.
+ *
+ * @param[in] pSPIHandle handle structure for the SPI peripheral.
+ *
+ * @return void
+ */
+static void spi_ovr_err_interrupt_handle(SPI_Handle_t* pSPIHandle);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void SPI_Init(SPI_Handle_t* pSPIHandle){
+
+    uint32_t temp = 0;
+
+    /* Enable the peripheral clock */
+    SPI_PerClkCtrl(pSPIHandle->pSPIx, ENABLE);
+
+    /* Configure the device mode */
+    temp |= pSPIHandle->SPIConfig.SPI_DeviceMode << SPI_CR1_MSTR;
+
+    /* Configure the bus */
+    if(pSPIHandle->SPIConfig.SPI_BusConfig == SPI_BUS_CONFIG_FD){
+        /* Bidirectional mode should be cleared */
+        temp &= ~(1 << SPI_CR1_BIDI_MODE);
+    }
+    else if(pSPIHandle->SPIConfig.SPI_BusConfig == SPI_BUS_CONFIG_HD){
+        /* Bidirectional mode should be set */
+        temp |= (1 << SPI_CR1_BIDI_MODE);
+    }
+    else if(pSPIHandle->SPIConfig.SPI_BusConfig == SPI_BUS_CONFIG_SIMPLEX_RXONLY){
+        /* Bidirectional mode should be cleared and RXONLY bit must be set */
+        temp &= ~(1 << SPI_CR1_BIDI_MODE);
+        temp |= (1 << SPI_CR1_RXONLY);
+    }
+
+    /* Configure the SPI serial clock speed (baud rate) */
+    temp |= pSPIHandle->SPIConfig.SPI_SclkSpeed << SPI_CR1_BR;
+
+    /* Configure the DFF */
+    temp |= pSPIHandle->SPIConfig.SPI_DFF << SPI_CR1_DFF;
+
+    /* Configure the CPOL */
+    temp |= pSPIHandle->SPIConfig.SPI_CPOL << SPI_CR1_CPOL;
+
+    /* Configure the CPHA */
+    temp |= pSPIHandle->SPIConfig.SPI_CPHA << SPI_CR1_CPHA;
+
+    /* Configure the SSM */
+    temp |= pSPIHandle->SPIConfig.SPI_SSM << SPI_CR1_SSM;
+
+    pSPIHandle->pSPIx->CR1 = temp;
+}
+
+void SPI_DeInit(SPI_RegDef_t* pSPIx){
+
+    if(pSPIx == SPI1){
+        SPI1_REG_RESET();
+    }
+    else if(pSPIx == SPI2){
+        SPI2_REG_RESET();
+    }
+    else if(pSPIx == SPI3){
+        SPI3_REG_RESET();
+    }
+    else if(pSPIx == SPI4){
+        SPI4_REG_RESET();
+    }
+}
+
+void SPI_PerClkCtrl(SPI_RegDef_t* pSPIx, uint8_t en_or_di){
+
+    if(en_or_di == ENABLE){
+        if(pSPIx == SPI1){
+            SPI1_PCLK_EN();
+        }
+        else if(pSPIx == SPI2){
+            SPI2_PCLK_EN();
+        }
+        else if(pSPIx == SPI3){
+            SPI3_PCLK_EN();
+        }
+        else if(pSPIx == SPI4){
+            SPI4_PCLK_EN();
+        }
+    }
+    else{
+        if(pSPIx == SPI1){
+            SPI1_PCLK_DI();
+        }
+        else if(pSPIx == SPI2){
+            SPI2_PCLK_DI();
+        }
+        else if(pSPIx == SPI3){
+            SPI3_PCLK_DI();
+        }
+        else if(pSPIx == SPI4){
+            SPI4_PCLK_DI();
+        }
+    }
+}
+
+void SPI_SendData(SPI_RegDef_t* pSPIx, uint8_t* pTxBuffer, uint32_t len){
+
+    while(len > 0){
+        /* Wait until TXE is set */
+        while(SPI_GetFlagStatus(pSPIx, SPI_FLAG_TXE) == FLAG_RESET);
+
+        if(pSPIx->CR1 & (1 << SPI_CR1_DFF)){
+            /* 16 bit DFF */
+            pSPIx->DR = *((uint16_t*)pTxBuffer);
+            len = (len > 1) ? (len - 2) : 0;
+            pTxBuffer += 2;
+        }
+        else{
+            /* 8 bit DFF */
+            pSPIx->DR = *pTxBuffer;
+            len--;
+            pTxBuffer++;
+        }
+    }
+}
+
+void SPI_ReceiveData(SPI_RegDef_t* pSPIx, uint8_t* pRxBuffer, uint32_t len){
+
+    while(len > 0){
+        /* Wait until RXNE is set */
+        while(SPI_GetFlagStatus(pSPIx, SPI_FLAG_RXNE) == FLAG_RESET);
+
+        if(pSPIx->CR1 & (1 << SPI_CR1_DFF)){
+            /* 16 bit DFF */
+            *((uint16_t*)pRxBuffer) = (uint16_t)pSPIx->DR;
+            len = (len > 1) ? (len - 2) : 0;
+            pRxBuffer += 2;
+        }
+        else{
+            /* 8 bit DFF */
+            *pRxBuffer = (uint8_t)pSPIx->DR;
+            len--;
+            pRxBuffer++;
+        }
+    }
+}
+
+uint8_t SPI_SendDataIT(SPI_Handle_t* pSPIHandle, uint8_t* pTxBuffer, uint32_t len){
+
+    uint8_t state = pSPIHandle->TxState;
+
+    if(state != SPI_BUSY_IN_TX){
+        /* Save the Tx buffer address and len information in some global variables */
+        pSPIHandle->pTxBuffer = pTxBuffer;
+        pSPIHandle->TxLen = len;
+        /* Mark the SPI state as busy in transmission */
+        pSPIHandle->TxState = SPI_BUSY_IN_TX;
+        /* Enable the TXEIE control bit to get interrupt whenever TXE flag is set in SR */
+        pSPIHandle->pSPIx->CR2 |= (1 << SPI_CR2_TXEIE);
+    }
+
+    return state;
+}
+
+uint8_t SPI_ReceiveDataIT(SPI_Handle_t* pSPIHandle, uint8_t* pRxBuffer, uint32_t len){
+
+    uint8_t state = pSPIHandle->RxState;
+
+    if(state != SPI_BUSY_IN_RX){
+        /* Save the Rx buffer address and len information in some global variables */
+        pSPIHandle->pRxBuffer = pRxBuffer;
+        pSPIHandle->RxLen = len;
+        /* Mark the SPI state as busy in reception */
+        pSPIHandle->RxState = SPI_BUSY_IN_RX;
+        /* Enable the RXNEIE control bit to get interrupt whenever RXNE flag is set in SR */
+        pSPIHandle->pSPIx->CR2 |= (1 << SPI_CR2_RXNEIE);
+    }
+
+    return state;
+}
+
+void SPI_IRQConfig(uint8_t IRQNumber, uint8_t en_or_di){
+
+    if(en_or_di == ENABLE){
+        if(IRQNumber <= 31){
+            *NVIC_ISER0 |= (1 << IRQNumber);
+        }
+        else if(IRQNumber > 31 && IRQNumber < 64){
+            *NVIC_ISER1 |= (1 << (IRQNumber % 32));
+        }
+        else if(IRQNumber >= 64 && IRQNumber < 96){
+            *NVIC_ISER2 |= (1 << (IRQNumber % 64));
+        }
+    }
+    else{
+        if(IRQNumber <= 31){
+            *NVIC_ICER0 |= (1 << IRQNumber);
+        }
+        else if(IRQNumber > 31 && IRQNumber < 64){
+            *NVIC_ICER1 |= (1 << (IRQNumber % 32));
+        }
+        else if(IRQNumber >= 64 && IRQNumber < 96){
+            *NVIC_ICER2 |= (1 << (IRQNumber % 64));
+        }
+    }
+}
+
+void SPI_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority){
+
+    uint8_t iprx = IRQNumber / 4;
+    uint8_t iprx_section = IRQNumber % 4;
+    uint8_t shift_amount = (8 * iprx_section) + (8 - NO_PR_BITS_IMPLEMENTED);
+
+    *(NVIC_PR_BASEADDR + iprx) |= (IRQPriority << shift_amount);
+}
+
+void SPI_IRQHandling(SPI_Handle_t* pSPIHandle){
+
+    uint8_t temp1, temp2;
+
+    /* Check for TXE */
+    temp1 = pSPIHandle->pSPIx->SR & (1 << SPI_SR_TXE);
+    temp2 = pSPIHandle->pSPIx->CR2 & (1 << SPI_CR2_TXEIE);
+    if(temp1 && temp2){
+        spi_txe_interrupt_handle(pSPIHandle);
+    }
+
+    /* Check for RXNE */
+    temp1 = pSPIHandle->pSPIx->SR & (1 << SPI_SR_RXNE);
+    temp2 = pSPIHandle->pSPIx->CR2 & (1 << SPI_CR2_RXNEIE);
+    if(temp1 && temp2){
+        spi_rxne_interrupt_handle(pSPIHandle);
+    }
+
+    /* Check for overrun error */
+    temp1 = pSPIHandle->pSPIx->SR & (1 << SPI_SR_OVR);
+    temp2 = pSPIHandle->pSPIx->CR2 & (1 << SPI_CR2_ERRIE);
+    if(temp1 && temp2){
+        spi_ovr_err_interrupt_handle(pSPIHandle);
+    }
+}
+
+void SPI_Enable(SPI_RegDef_t* pSPIx, uint8_t en_or_di){
+
+    if(en_or_di == ENABLE){
+        pSPIx->CR1 |= (1 << SPI_CR1_SPE);
+    }
+    else{
+        pSPIx->CR1 &= ~(1 << SPI_CR1_SPE);
+    }
+}
+
+void SPI_SSICfg(SPI_RegDef_t* pSPIx, uint8_t en_or_di){
+
+    if(en_or_di == ENABLE){
+        pSPIx->CR1 |= (1 << SPI_CR1_SSI);
+    }
+    else{
+        pSPIx->CR1 &= ~(1 << SPI_CR1_SSI);
+    }
+}
+
+void SPI_SSOECfg(SPI_RegDef_t* pSPIx, uint8_t en_or_di){
+
+    if(en_or_di == ENABLE){
+        pSPIx->CR2 |= (1 << SPI_CR2_SSOE);
+    }
+    else{
+        pSPIx->CR2 &= ~(1 << SPI_CR2_SSOE);
+    }
+}
+
+uint8_t SPI_GetFlagStatus(SPI_RegDef_t* pSPIx, uint32_t flagname){
+
+    if(pSPIx->SR & flagname){
+        return FLAG_SET;
+    }
+
+    return FLAG_RESET;
+}
+
+void SPI_ClearOVRFlag(SPI_RegDef_t* pSPIx){
+
+    uint8_t temp;
+
+    temp = pSPIx->DR;
+    temp = pSPIx->SR;
+    (void)temp;
+}
+
+void SPI_CloseTx(SPI_Handle_t* pSPIHandle){
+
+    pSPIHandle->pSPIx->CR2 &= ~(1 << SPI_CR2_TXEIE);
+    pSPIHandle->pTxBuffer = NULL;
+    pSPIHandle->TxLen = 0;
+    pSPIHandle->TxState = SPI_READY;
+}
+
+void SPI_CloseRx(SPI_Handle_t* pSPIHandle){
+
+    pSPIHandle->pSPIx->CR2 &= ~(1 << SPI_CR2_RXNEIE);
+    pSPIHandle->pRxBuffer = NULL;
+    pSPIHandle->RxLen = 0;
+    pSPIHandle->RxState = SPI_READY;
+}
+
+__attribute__((weak)) void SPI_ApplicationEventCallback(SPI_Handle_t* pSPIHandle, uint8_t app_event){
+
+    /* This is a weak implementation, the application may override this function */
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static void spi_txe_interrupt_handle(SPI_Handle_t* pSPIHandle){
+
+    if(pSPIHandle->pSPIx->CR1 & (1 << SPI_CR1_DFF)){
+        /* 16 bit DFF */
+        pSPIHandle->pSPIx->DR = *((uint16_t*)pSPIHandle->pTxBuffer);
+        pSPIHandle->TxLen = (pSPIHandle->TxLen > 1) ? (pSPIHandle->TxLen - 2) : 0;
+        pSPIHandle->pTxBuffer += 2;
+    }
+    else{
+        /* 8 bit DFF */
+        pSPIHandle->pSPIx->DR = *(pSPIHandle->pTxBuffer);
+        pSPIHandle->TxLen--;
+        pSPIHandle->pTxBuffer++;
+    }
+
+    if(!pSPIHandle->TxLen){
+        /* TxLen is zero, close the SPI transmission and inform the application */
+        SPI_CloseTx(pSPIHandle);
+        SPI_ApplicationEventCallback(pSPIHandle, SPI_EVENT_TX_CMPLT);
+    }
+}
+
+static void spi_rxne_interrupt_handle(SPI_Handle_t* pSPIHandle){
+
+    if(pSPIHandle->pSPIx->CR1 & (1 << SPI_CR1_DFF)){
+        /* 16 bit DFF */
+        *((uint16_t*)pSPIHandle->pRxBuffer) = (uint16_t)pSPIHandle->pSPIx->DR;
+        pSPIHandle->RxLen = (pSPIHandle->RxLen > 1) ? (pSPIHandle->RxLen - 2) : 0;
+        pSPIHandle->pRxBuffer += 2;
+    }
+    else{
+        /* 8 bit DFF */
+        *(pSPIHandle->pRxBuffer) = (uint8_t)pSPIHandle->pSPIx->DR;
+        pSPIHandle->RxLen--;
+        pSPIHandle->pRxBuffer++;
+    }
+
+    if(!pSPIHandle->RxLen){
+        /* RxLen is zero, close the SPI reception and inform the application */
+        SPI_CloseRx(pSPIHandle);
+        SPI_ApplicationEventCallback(pSPIHandle, SPI_EVENT_RX_CMPLT);
+    }
+}
+
+static void spi_ovr_err_interrupt_handle(SPI_Handle_t* pSPIHandle){
+
+    /* Clear the OVR flag, if the transmission is ongoing the application clears it */
+    if(pSPIHandle->TxState != SPI_BUSY_IN_TX){
+        SPI_ClearOVRFlag(pSPIHandle->pSPIx);
+    }
+
+    /* Inform the application */
+    SPI_ApplicationEventCallback(pSPIHandle, SPI_EVENT_OVR_ERR);
+}
@@ -0,0 +1,367 @@
+/*****************************************************************************************************
+* FILENAME :        spi_driver.h
+*
+* DESCRIPTION :
+*       Header file containing the prototypes of the APIs for configuring the SPI peripheral.
+*
+* PUBLIC FUNCTIONS :
+*       void    SPI_Init(SPI_Handle_t* pSPIHandle)
+*       void    SPI_DeInit(SPI_RegDef_t* pSPIx)
+*       void    SPI_PerClkCtrl(SPI_RegDef_t* pSPIx, uint8_t en_or_di)
+*       void    SPI_SendData(SPI_RegDef_t* pSPIx, uint8_t* pTxBuffer, uint32_t len)
+*       void    SPI_ReceiveData(SPI_RegDef_t* pSPIx, uint8_t* pRxBuffer, uint32_t len)
+*       uint8_t SPI_SendDataIT(SPI_Handle_t* pSPIHandle, uint8_t* pTxBuffer, uint32_t len)
+*       uint8_t SPI_ReceiveDataIT(SPI_Handle_t* pSPIHandle, uint8_t* pRxBuffer, uint32_t len)
+*       void    SPI_IRQConfig(uint8_t IRQNumber, uint8_t en_or_di)
+*       void    SPI_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority)
+*       void    SPI_IRQHandling(SPI_Handle_t* pSPIHandle)
+*       void    SPI_Enable(SPI_RegDef_t* pSPIx, uint8_t en_or_di)
+*       void    SPI_SSICfg(SPI_RegDef_t* pSPIx, uint8_t en_or_di)
+*       void    SPI_SSOECfg(SPI_RegDef_t* pSPIx, uint8_t en_or_di)
+*       uint8_t SPI_GetFlagStatus(SPI_RegDef_t* pSPIx, uint32_t flagname)
+*       void    SPI_ClearOVRFlag(SPI_RegDef_t* pSPIx)
+*       void    SPI_CloseTx(SPI_Handle_t* pSPIHandle)
+*       void    SPI_CloseRx(SPI_Handle_t* pSPIHandle)
+*       void    SPI_ApplicationEventCallback(SPI_Handle_t* pSPIHandle, uint8_t app_event)
+*
+**/
+
+#ifndef SPI_DRIVER_H
+#define SPI_DRIVER_H
+
+#include <stdint.h>
+#include "stm32f446xx.h"
+
+/**
+ * @SPI_DEVICEMODE
+ * SPI possible device modes.
+ */
+#define SPI_DEVICE_MODE_SLAVE       0
+#define SPI_DEVICE_MODE_MASTER      1
+
+/**
+ * @SPI_BUSCONFIG
+ * SPI possible bus configurations.
+ */
+#define SPI_BUS_CONFIG_FD               1   /* Full duplex */
+#define SPI_BUS_CONFIG_HD               2   /* Half duplex */
+#define SPI_BUS_CONFIG_SIMPLEX_RXONLY   3   /* Simplex receive only */
+
+/**
+ * @SPI_SCLKSPEED
+ * SPI possible clock speed (peripheral clock divider).
+ */
+#define SPI_SCLK_SPEED_DIV2         0
+#define SPI_SCLK_SPEED_DIV4         1
+#define SPI_SCLK_SPEED_DIV8         2
+#define SPI_SCLK_SPEED_DIV16        3
+#define SPI_SCLK_SPEED_DIV32        4
+#define SPI_SCLK_SPEED_DIV64        5
+#define SPI_SCLK_SPEED_DIV128       6
+#define SPI_SCLK_SPEED_DIV256       7
+
+/**
+ * @SPI_DFF
+ * SPI possible data frame format.
+ */
+#define SPI_DFF_8BITS               0
+#define SPI_DFF_16BITS              1
+
+/**
+ * @SPI_CPOL
+ * SPI possible clock polarity.
+ */
+#define SPI_CPOL_LOW                0
+#define SPI_CPOL_HIGH               1
+
+/**
+ * @SPI_CPHA
+ * SPI possible clock phase.
+ */
+#define SPI_CPHA_LOW                0
+#define SPI_CPHA_HIGH               1
+
+/**
+ * @SPI_SSM
+ * SPI possible software slave management.
+ */
+#define SPI_SSM_DI                  0
+#define SPI_SSM_EN                  1
+
+/**
+ * @SPI_APP_STATE
+ * SPI possible application states.
+ */
+#define SPI_READY                   0
+#define SPI_BUSY_IN_RX              1
+#define SPI_BUSY_IN_TX              2
+
+/**
+ * SPI possible application events.
+ */
+#define SPI_EVENT_TX_CMPLT          1
+#define SPI_EVENT_RX_CMPLT          2
+#define SPI_EVENT_OVR_ERR           3
+#define SPI_EVENT_CRC_ERR           4
+
+/**
+ * SPI related status flags definitions.
+ */
+#define SPI_FLAG_RXNE       (1 << SPI_SR_RXNE)
+#define SPI_FLAG_TXE        (1 << SPI_SR_TXE)
+#define SPI_FLAG_BSY        (1 << SPI_SR_BSY)
+
+/**
+ * Configuration structure for SPI peripheral.
+ */
+typedef struct
+{
+    uint8_t SPI_DeviceMode;         /* Possible values from @SPI_DEVICEMODE */
+    uint8_t SPI_BusConfig;          /* Possible values from @SPI_BUSCONFIG */
+    uint8_t SPI_SclkSpeed;          /* Possible values from @SPI_SCLKSPEED */
+    uint8_t SPI_DFF;                /* Possible values from @SPI_DFF */
+    uint8_t SPI_CPOL;               /* Possible values from @SPI_CPOL */
+    uint8_t SPI_CPHA;               /* Possible values from @SPI_CPHA */
+    uint8_t SPI_SSM;                /* Possible values from @SPI_SSM */
+}SPI_Config_t;
+
+/**
+ * Handle structure for SPIx peripheral.
+ */
+typedef struct
+{
+    SPI_RegDef_t* pSPIx;        /* Base address of the SPIx peripheral */
+    SPI_Config_t SPIConfig;     /* SPIx peripheral configuration settings */
+    uint8_t* pTxBuffer;         /* To store the app. Tx buffer address */
+    uint8_t* pRxBuffer;         /* To store the app. Rx buffer address */
+    uint32_t TxLen;             /* To store Tx len */
+    uint32_t RxLen;             /* To store Rx len */
+    uint8_t TxState;            /* To store Tx state, possible values from @SPI_APP_STATE */
+    uint8_t RxState;            /* To store Rx state, possible values from @SPI_APP_STATE */
+}SPI_Handle_t;
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn SPI_Init
+ *
+ * @brief function to initialize SPI peripheral.
+ *
+ * @param[in] pSPIHandle handle structure for the SPI peripheral.
+ *
+ * @return void
+ */
+void SPI_Init(SPI_Handle_t* pSPIHandle);
+
+/**
+ *@fn SPI_DeInit
+ *
+ * @brief function to reset all register of a SPI peripheral.
+ *
+ * @param[in] pSPIx the base address of the SPIx peripheral.
+ *
+ * @return void
+ */
+void SPI_DeInit(SPI_RegDef_t* pSPIx);
+
+/**
+ * @fn SPI_PerClkCtrl
+ *
+ * @brief function to control the peripheral clock of the SPI peripheral.
+ *
+ * @param[in] pSPIx the base address of the SPIx peripheral.
+ * @param[in] en_or_di for enable or disable.
+ *
+ * @return void
+ */
+void SPI_PerClkCtrl(SPI_RegDef_t* pSPIx, uint8_t en_or_di);
+
+/**
+ * @fn SPI_SendData
+ *
+ * @brief function to send data through SPI peripheral.
+ *
+ * @param[in] pSPIx the base address of the SPIx peripheral.
+ * @param[in] pTxBuffer buffer with data to be transmitted.
+ * @param[in] len length of the transmission buffer.
+ *
+ * @return void
+ *
+ * @note blocking call.
+ */
+void SPI_SendData(SPI_RegDef_t* pSPIx, uint8_t* pTxBuffer, uint32_t len);
+
+/**
+ * @fn SPI_ReceiveData
+ *
+ * @brief function to receive data through SPI peripheral.
+ *
+ * @param[in] pSPIx the base address of the SPIx peripheral.
+ * @param[out] pRxBuffer buffer to store the received data.
+ * @param[in] len length of the reception buffer.
+ *
+ * @return void
+ *
+ * @note blocking call.
+ */
+void SPI_ReceiveData(SPI_RegDef_t* pSPIx, uint8_t* pRxBuffer, uint32_t len);
+
+/**
+ * @fn SPI_SendDataIT
+ *
+ * @brief function to send data through SPI peripheral in interrupt mode.
+ *
+ * @param[in] pSPIHandle handle structure for the SPI peripheral.
+ * @param[in] pTxBuffer buffer with data to be transmitted.
+ * @param[in] len length of the transmission buffer.
+ *
+ * @return Tx state, possible values from @SPI_APP_STATE.
+ */
+uint8_t SPI_SendDataIT(SPI_Handle_t* pSPIHandle, uint8_t* pTxBuffer, uint32_t len);
+
+/**
+ * @fn SPI_ReceiveDataIT
+ *
+ * @brief function to receive data through SPI peripheral in interrupt mode.
+ *
+ * @param[in] pSPIHandle handle structure for the SPI peripheral.
+ * @param[out] pRxBuffer buffer to store the received data.
+ * @param[in] len length of the reception buffer.
+ *
+ * @return Rx state, possible values from @SPI_APP_STATE.
+ */
+uint8_t SPI_ReceiveDataIT(SPI_Handle_t* pSPIHandle, uint8_t* pRxBuffer, uint32_t len);
+
+/**
+ * @fn SPI_IRQConfig
+ *
+ * @brief function to configure the IRQ number of the SPI peripheral.
+ *
+ * @param[in] IRQNumber number of the interrupt.
+ * @param[in] en_or_di for enable or disable.
+ *
+ * @return void.
+ */
+void SPI_IRQConfig(uint8_t IRQNumber, uint8_t en_or_di);
+
+/**
+ * @fn SPI_IRQPriorityConfig
+ *
+ * @brief function to configure the priority of the SPI interrupt.
+ *
+ * @param[in] IRQNumber number of the interrupt.
+ * @param[in] IRQPriority priority of the interrupt.
+ *
+ * @return void.
+ */
+void SPI_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority);
+
+/**
+ * @fn SPI_IRQHandling
+ *
+ * @brief function to handle the interrupt of the SPI peripheral.
+ *
+ * @param[in] pSPIHandle handle structure for the SPI peripheral.
+ *
+ * @return void.
+ */
+void SPI_IRQHandling(SPI_Handle_t* pSPIHandle);
+
+/**
+ * @fn SPI_Enable
+ *
+ * @brief function to enable the SPI peripheral.
+ *
+ * @param[in] pSPIx the base address of the SPIx peripheral.
+ * @param[in] en_or_di for enable or disable.
+ *
+ * @return void.
+ */
+void SPI_Enable(SPI_RegDef_t* pSPIx, uint8_t en_or_di);
+
+/**
+ * @fn SPI_SSICfg
+ *
+ * @brief function to set the SSI bit of the SPI peripheral.
+ *
+ * @param[in] pSPIx the base address of the SPIx peripheral.
+ * @param[in] en_or_di for enable or disable.
+ *
+ * @return void.
+ *
+ * @note only meaningful when software slave management is enabled.
+ */
+void SPI_SSICfg(SPI_RegDef_t* pSPIx, uint8_t en_or_di);
+
+/**
+ * @fn SPI_SSOECfg
+ *
+ * @brief function to set the SSOE bit of the SPI peripheral.
+ *
+ * @param[in] pSPIx the base address of the SPIx peripheral.
+ * @param[in] en_or_di for enable or disable.
+ *
+ * @return void.
+ */
+void SPI_SSOECfg(SPI_RegDef_t* pSPIx, uint8_t en_or_di);
+
+/**
+ * @fn SPI_GetFlagStatus
+ *
+ * @brief function returns the status of a given flag.
+ *
+ * @param[in] pSPIx the base address of the SPIx peripheral.
+ * @param[in] flagname the name of the flag.
+ *
+ * @return flag status: FLAG_SET or FLAG_RESET.
+ */
+uint8_t SPI_GetFlagStatus(SPI_RegDef_t* pSPIx, uint32_t flagname);
+
+/**
+ * @fn SPI_ClearOVRFlag
+ *
+ * @brief function to clear the overrun flag of the SPI peripheral.
+ *
+ * @param[in] pSPIx the base address of the SPIx peripheral.
+ *
+ * @return void.
+ */
+void SPI_ClearOVRFlag(SPI_RegDef_t* pSPIx);
+
+/**
+ * @fn SPI_CloseTx
+ *
+ * @brief function to close transmission of data.
+ *
+ * @param[in] pSPIHandle handle structure for the SPI peripheral.
+ *
+ * @return void.
+ */
+void SPI_CloseTx(SPI_Handle_t* pSPIHandle);
+
+/**
+ * @fn SPI_CloseRx
+ *
+ * @brief function to close reception of data.
+ *
+ * @param[in] pSPIHandle handle structure for the SPI peripheral.
+ *
+ * @return void.
+ */
+void SPI_CloseRx(SPI_Handle_t* pSPIHandle);
+
+/**
+ * @fn SPI_ApplicationEventCallback
+ *
+ * @brief function for application callback.
+ *
+ * @param[in] pSPIHandle handle structure to SPI peripheral.
+ * @param[in] app_event application event.
+ *
+ * @return void.
+ */
+void SPI_ApplicationEventCallback(SPI_Handle_t* pSPIHandle, uint8_t app_event);
+
+#endif /* SPI_DRIVER_H */
@@ -26,6 +26,47 @@
 #define FLAG_SET            SET
 #define FLAG_RESET          RESET
 
+/**
+ * Function executed from SRAM: placed in .ramfunc, which Reset_Handler copies from flash. Flash and
+ * SRAM are out of the BL range, calls from other files go through veneers added by the linker.
+ */
+#ifdef __arm__
+#define __RAMFUNC           __attribute__((section(".ramfunc"), long_call, noinline))
+#else
+#define __RAMFUNC
+#endif
+
+/**
+ * Short critical sections: irq_lock masks the interrupts (PRIMASK) and returns the previous mask,
+ * irq_unlock restores it, so the sections can be nested and entered from a handler. The host builds
+ * have no interrupts and both do nothing.
+ */
+#ifdef __arm__
+static inline uint32_t irq_lock(void){
+
+    uint32_t primask = 0;
+
+    __asm volatile ("mrs %0, primask\n\tcpsid i" : "=r" (primask) : : "memory");
+
+    return primask;
+}
+
+static inline void irq_unlock(uint32_t primask){
+
+    __asm volatile ("msr primask, %0" : : "r" (primask) : "memory");
+}
+#else
+static inline uint32_t irq_lock(void){
+
+    return 0;
+}
+
+static inline void irq_unlock(uint32_t primask){
+
+    (void)primask;
+}
+#endif
+
 /*****************************************************************************************************/
 /*                          ARM Cortex M4 Processor Specific Setails                                 */
 /*****************************************************************************************************/
@@ -56,6 +97,71 @@
  */
 #define NO_PR_BITS_IMPLEMENTED      4
 
+/**
+ * ARM Cortex M4 processor DWT cycle counter register addresses.
+ */
+#define DEMCR           ((volatile uint32_t*)0xE000EDFC)
+#define DWT_CTRL        ((volatile uint32_t*)0xE0001000)
+#ifndef GPIO_SIM
+#define DWT_CYCCNT      ((volatile uint32_t*)0xE0001004)
+#else
+#include "dwt_sim.h"
+#endif
+
+#define DEMCR_TRCENA            24
+#define DWT_CTRL_CYCCNTENA      0
+
+/**
+ * ARM Cortex M4 processor SysTick register addresses.
+ */
+#define SYST_CSR        ((volatile uint32_t*)0xE000E010)
+#define SYST_RVR        ((volatile uint32_t*)0xE000E014)
+#define SYST_CVR        ((volatile uint32_t*)0xE000E018)
+
+#define SYST_CSR_ENABLE         0
+#define SYST_CSR_TICKINT        1
+#define SYST_CSR_CLKSOURCE      2
+#define SYST_CSR_COUNTFLAG      16
+
+/**
+ * ARM Cortex M4 processor SCB register addresses.
+ */
+#define SCB_ICSR        ((volatile uint32_t*)0xE000ED04)
+#define SCB_SCR         ((volatile uint32_t*)0xE000ED10)
+#define SCB_SHCSR       ((volatile uint32_t*)0xE000ED24)
+#define SCB_CFSR        ((volatile uint32_t*)0xE000ED28)
+#define SCB_MMFAR       ((volatile uint32_t*)0xE000ED34)
+
+#define SCB_ICSR_PENDSTCLR      25
+#define SCB_ICSR_PENDSTSET      26
+#define SCB_SCR_SLEEPDEEP       2
+#define SCB_SHCSR_MEMFAULTENA   16
+
+/**
+ * ARM Cortex M4 processor MPU register addresses.
+ */
+#define MPU_TYPE        ((volatile uint32_t*)0xE000ED90)
+#define MPU_CTRL        ((volatile uint32_t*)0xE000ED94)
+#define MPU_RNR         ((volatile uint32_t*)0xE000ED98)
+#define MPU_RBAR        ((volatile uint32_t*)0xE000ED9C)
+#define MPU_RASR        ((volatile uint32_t*)0xE000EDA0)
+
+#define MPU_CTRL_ENABLE         0
+#define MPU_CTRL_HFNMIENA       1
+#define MPU_CTRL_PRIVDEFENA     2
+#define MPU_RASR_ENABLE         0
+#define MPU_RASR_SIZE           1
+#define MPU_RASR_AP             24
+#define MPU_RASR_XN             28
+
+/**
+ * Debug MCU configuration register address.
+ */
+#define DBGMCU_CR       ((volatile uint32_t*)0xE0042004)
+
+#define DBGMCU_CR_DBG_SLEEP     0
+#define DBGMCU_CR_DBG_STOP      1
+
 /*****************************************************************************************************/
 /*                          Memory and Bus Base Address Definition                                   */
 /*****************************************************************************************************/
@@ -309,6 +415,109 @@ typedef struct
     volatile uint32_t GTPR;         /* USART guard time and prescaler reg   Address offset 0x18 */
 }USART_RegDef_t;
 
+/**
+ * Peripheral register definition structure for a DMA stream.
+ */
+typedef struct
+{
+    volatile uint32_t CR;           /* DMA stream x configuration register      Address offset 0x00 */
+    volatile uint32_t NDTR;         /* DMA stream x number of data register     Address offset 0x04 */
+    volatile uint32_t PAR;          /* DMA stream x peripheral address register Address offset 0x08 */
+    volatile uint32_t M0AR;         /* DMA stream x memory 0 address register   Address offset 0x0C */
+    volatile uint32_t M1AR;         /* DMA stream x memory 1 address register   Address offset 0x10 */
+    volatile uint32_t FCR;          /* DMA stream x FIFO control register       Address offset 0x14 */
+}DMA_Stream_RegDef_t;
+
+/**
+ * Peripheral register definition structure for DMA.
+ */
+typedef struct
+{
+    volatile uint32_t LISR;         /* DMA low interrupt status register        Address offset 0x00 */
+    volatile uint32_t HISR;         /* DMA high interrupt status register       Address offset 0x04 */
+    volatile uint32_t LIFCR;        /* DMA low interrupt flag clear register    Address offset 0x08 */
+    volatile uint32_t HIFCR;        /* DMA high interrupt flag clear register   Address offset 0x0C */
+    DMA_Stream_RegDef_t S[8];       /* DMA stream 0 to 7 registers              Address offset 0x10 */
+}DMA_RegDef_t;
+
+/**
+ * Peripheral register definition structure for TIM.
+ */
+typedef struct
+{
+    volatile uint32_t CR1;          /* TIM control register 1               Address offset 0x00 */
+    volatile uint32_t CR2;          /* TIM control register 2               Address offset 0x04 */
+    volatile uint32_t SMCR;         /* TIM slave mode control register      Address offset 0x08 */
+    volatile uint32_t DIER;         /* TIM DMA/interrupt enable register    Address offset 0x0C */
+    volatile uint32_t SR;           /* TIM status register                  Address offset 0x10 */
+    volatile uint32_t EGR;          /* TIM event generation register        Address offset 0x14 */
+    volatile uint32_t CCMR1;        /* TIM capture/compare mode register 1  Address offset 0x18 */
+    volatile uint32_t CCMR2;        /* TIM capture/compare mode register 2  Address offset 0x1C */
+    volatile uint32_t CCER;         /* TIM capture/compare enable register  Address offset 0x20 */
+    volatile uint32_t CNT;          /* TIM counter                          Address offset 0x24 */
+    volatile uint32_t PSC;          /* TIM prescaler                        Address offset 0x28 */
+    volatile uint32_t ARR;          /* TIM auto-reload register             Address offset 0x2C */
+    volatile uint32_t RCR;          /* TIM repetition counter register      Address offset 0x30 */
+    volatile uint32_t CCR1;         /* TIM capture/compare register 1       Address offset 0x34 */
+    volatile uint32_t CCR2;         /* TIM capture/compare register 2       Address offset 0x38 */
+    volatile uint32_t CCR3;         /* TIM capture/compare register 3       Address offset 0x3C */
+    volatile uint32_t CCR4;         /* TIM capture/compare register 4       Address offset 0x40 */
+    volatile uint32_t BDTR;         /* TIM break and dead-time register     Address offset 0x44 */
+    volatile uint32_t DCR;          /* TIM DMA control register             Address offset 0x48 */
+    volatile uint32_t DMAR;         /* TIM DMA address for full transfer    Address offset 0x4C */
+    volatile uint32_t OR;           /* TIM option register (TIM2 and TIM5)  Address offset 0x50 */
+}TIM_RegDef_t;
+
+/**
+ * Peripheral register definition structure for PWR.
+ */
+typedef struct
+{
+    volatile uint32_t CR;           /* PWR power control register           Address offset 0x00 */
+    volatile uint32_t CSR;          /* PWR power control/status register    Address offset 0x04 */
+}PWR_RegDef_t;
+
+/**
+ * Peripheral register definition structure for the flash interface.
+ */
+typedef struct
+{
+    volatile uint32_t ACR;          /* FLASH access control register        Address offset 0x00 */
+    volatile uint32_t KEYR;         /* FLASH key register                   Address offset 0x04 */
+    volatile uint32_t OPTKEYR;      /* FLASH option key register            Address offset 0x08 */
+    volatile uint32_t SR;           /* FLASH status register                Address offset 0x0C */
+    volatile uint32_t CR;           /* FLASH control register               Address offset 0x10 */
+    volatile uint32_t OPTCR;        /* FLASH option control register        Address offset 0x14 */
+}FLASH_RegDef_t;
+
+/**
+ * Peripheral register definition structure for RTC.
+ */
+typedef struct
+{
+    volatile uint32_t TR;           /* RTC time register                    Address offset 0x00 */
+    volatile uint32_t DR;           /* RTC date register                    Address offset 0x04 */
+    volatile uint32_t CR;           /* RTC control register                 Address offset 0x08 */
+    volatile uint32_t ISR;          /* RTC initialization and status reg    Address offset 0x0C */
+    volatile uint32_t PRER;         /* RTC prescaler register               Address offset 0x10 */
+    volatile uint32_t WUTR;         /* RTC wakeup timer register            Address offset 0x14 */
+    volatile uint32_t CALIBR;       /* RTC calibration register             Address offset 0x18 */
+    volatile uint32_t ALRMAR;       /* RTC alarm A register                 Address offset 0x1C */
+    volatile uint32_t ALRMBR;       /* RTC alarm B register                 Address offset 0x20 */
+    volatile uint32_t WPR;          /* RTC write protection register        Address offset 0x24 */
+    volatile uint32_t SSR;          /* RTC sub second register              Address offset 0x28 */
+    volatile uint32_t SHIFTR;       /* RTC shift control register           Address offset 0x2C */
+    volatile uint32_t TSTR;         /* RTC time stamp time register         Address offset 0x30 */
+    volatile uint32_t TSDR;         /* RTC time stamp date register         Address offset 0x34 */
+    volatile uint32_t TSSSR;        /* RTC timestamp sub second register    Address offset 0x38 */
+    volatile uint32_t CALR;         /* RTC calibration register             Address offset 0x3C */
+    volatile uint32_t TAFCR;        /* RTC tamper and alternate function    Address offset 0x40 */
+    volatile uint32_t ALRMASSR;     /* RTC alarm A sub second register      Address offset 0x44 */
+    volatile uint32_t ALRMBSSR;     /* RTC alarm B sub second register      Address offset 0x48 */
+    uint32_t RESERVED0;             /* Reserved                             Address offset 0x4C */
+    volatile uint32_t BKPR[20];     /* RTC backup registers                 Address offset 0x50 */
+}RTC_RegDef_t;
+
 /*****************************************************************************************************/
 /*                          Bit Position Definition of Peripheral Register                           */
 /*****************************************************************************************************/
@@ -482,6 +691,202 @@ typedef struct
 #define USART_SR_LBD        8
 #define USART_SR_CTS        9
 
+/**
+ * Bit position definition DMA_SxCR.
+ */
+#define DMA_SXCR_EN         0
+#define DMA_SXCR_DMEIE      1
+#define DMA_SXCR_TEIE       2
+#define DMA_SXCR_HTIE       3
+#define DMA_SXCR_TCIE       4
+#define DMA_SXCR_PFCTRL     5
+#define DMA_SXCR_DIR        6
+#define DMA_SXCR_CIRC       8
+#define DMA_SXCR_PINC       9
+#define DMA_SXCR_MINC       10
+#define DMA_SXCR_PSIZE      11
+#define DMA_SXCR_MSIZE      13
+#define DMA_SXCR_PINCOS     15
+#define DMA_SXCR_PL         16
+#define DMA_SXCR_DBM        18
+#define DMA_SXCR_CT         19
+#define DMA_SXCR_PBURST     21
+#define DMA_SXCR_MBURST     23
+#define DMA_SXCR_CHSEL      25
+
+/**
+ * Bit position definition DMA_HISR / DMA_HIFCR for stream 5 (streams 1 and 5 share the same layout).
+ */
+#define DMA_ISR_FEIF5       6
+#define DMA_ISR_DMEIF5      8
+#define DMA_ISR_TEIF5       9
+#define DMA_ISR_HTIF5       10
+#define DMA_ISR_TCIF5       11
+
+/**
+ * Bit position definition DMA_HISR / DMA_HIFCR for stream 6 (streams 2 and 6 share the same layout).
+ */
+#define DMA_ISR_FEIF6       16
+#define DMA_ISR_DMEIF6      18
+#define DMA_ISR_TEIF6       19
+#define DMA_ISR_HTIF6       20
+#define DMA_ISR_TCIF6       21
+
+/**
+ * Bit position definition TIM_CR1.
+ */
+#define TIM_CR1_CEN         0
+#define TIM_CR1_UDIS        1
+#define TIM_CR1_URS         2
+#define TIM_CR1_OPM         3
+#define TIM_CR1_DIR         4
+#define TIM_CR1_CMS         5
+#define TIM_CR1_ARPE        7
+#define TIM_CR1_CKD         8
+
+/**
+ * Bit position definition TIM_DIER.
+ */
+#define TIM_DIER_UIE        0
+#define TIM_DIER_CC1IE      1
+#define TIM_DIER_UDE        8
+#define TIM_DIER_CC1DE      9
+
+/**
+ * Bit position definition TIM_SR.
+ */
+#define TIM_SR_UIF          0
+#define TIM_SR_CC1IF        1
+
+/**
+ * Bit position definition TIM_EGR.
+ */
+#define TIM_EGR_UG          0
+
+/**
+ * Bit position definition TIM_CCMR1 (output compare mode).
+ */
+#define TIM_CCMR1_CC1S      0
+#define TIM_CCMR1_OC1FE     2
+#define TIM_CCMR1_OC1PE     3
+#define TIM_CCMR1_OC1M      4
+
+/**
+ * Bit position definition TIM_CCER.
+ */
+#define TIM_CCER_CC1E       0
+#define TIM_CCER_CC1P       1
+
+/**
+ * Bit position definition TIM_BDTR.
+ */
+#define TIM_BDTR_MOE        15
+
+/**
+ * Bit position definition PWR_CR.
+ */
+#define PWR_CR_LPDS         0
+#define PWR_CR_PDDS         1
+#define PWR_CR_CWUF         2
+#define PWR_CR_DBP          8
+#define PWR_CR_FPDS         9
+#define PWR_CR_VOS          14
+#define PWR_CR_ODEN         16
+#define PWR_CR_ODSWEN       17
+
+/**
+ * Bit position definition PWR_CSR.
+ */
+#define PWR_CSR_VOSRDY      14
+#define PWR_CSR_ODRDY       16
+#define PWR_CSR_ODSWRDY     17
+
+/**
+ * Bit position definition RCC_CR.
+ */
+#define RCC_CR_HSION        0
+#define RCC_CR_HSIRDY       1
+#define RCC_CR_HSEON        16
+#define RCC_CR_HSERDY       17
+#define RCC_CR_HSEBYP       18
+#define RCC_CR_PLLON        24
+#define RCC_CR_PLLRDY       25
+
+/**
+ * Bit position definition RCC_PLLCFGR.
+ */
+#define RCC_PLLCFGR_PLLM    0
+#define RCC_PLLCFGR_PLLN    6
+#define RCC_PLLCFGR_PLLP    16
+#define RCC_PLLCFGR_PLLSRC  22
+#define RCC_PLLCFGR_PLLQ    24
+#define RCC_PLLCFGR_PLLR    28
+
+/**
+ * Bit position definition RCC_CFGR.
+ */
+#define RCC_CFGR_SW         0
+#define RCC_CFGR_SWS        2
+#define RCC_CFGR_HPRE       4
+#define RCC_CFGR_PPRE1      10
+#define RCC_CFGR_PPRE2      13
+
+/**
+ * Bit position definition FLASH_ACR.
+ */
+#define FLASH_ACR_LATENCY   0
+#define FLASH_ACR_PRFTEN    8
+#define FLASH_ACR_ICEN      9
+#define FLASH_ACR_DCEN      10
+#define FLASH_ACR_ICRST     11
+#define FLASH_ACR_DCRST     12
+
+/**
+ * Bit position definition RCC_BDCR and RCC_CSR.
+ */
+#define RCC_BDCR_RTCSEL     8
+#define RCC_BDCR_RTCEN      15
+#define RCC_BDCR_BDRST      16
+#define RCC_CSR_LSION       0
+#define RCC_CSR_LSIRDY      1
+
+/**
+ * Bit position definition RTC_CR.
+ */
+#define RTC_CR_WUCKSEL      0
+#define RTC_CR_BYPSHAD      5
+#define RTC_CR_WUTE         10
+#define RTC_CR_WUTIE        14
+
+/**
+ * Bit position definition RTC_ISR.
+ */
+#define RTC_ISR_WUTWF       2
+#define RTC_ISR_INITF       6
+#define RTC_ISR_INIT        7
+#define RTC_ISR_WUTF        10
+
+/**
+ * Bit position definition RTC_PRER.
+ */
+#define RTC_PRER_PREDIV_S   0
+#define RTC_PRER_PREDIV_A   16
+
+/**
+ * Bit position definition RTC_TR.
+ */
+#define RTC_TR_SU           0
+#define RTC_TR_ST           4
+#define RTC_TR_MNU          8
+#define RTC_TR_MNT          12
+#define RTC_TR_HU           16
+#define RTC_TR_HT           20
+
+/**
+ * EXTI line connected to the RTC wakeup timer.
+ */
+#define EXTI_LINE_RTC_WKUP  22
+
 /*****************************************************************************************************/
 /*          Peripheral definitions (peripheral base addresses typecasted to xxx_RegDef_t)            */
 /*****************************************************************************************************/
@@ -518,6 +923,19 @@ typedef struct
 #define UART5   ((USART_RegDef_t*)UART5_BASEADDR)
 #define USART6  ((USART_RegDef_t*)USART6_BASEADDR)
 
+#define DMA1    ((DMA_RegDef_t*)DMA1_BASEADDR)
+#define DMA2    ((DMA_RegDef_t*)DMA2_BASEADDR)
+
+#define TIM1    ((TIM_RegDef_t*)TIM1_BASEADDR)
+#define TIM2    ((TIM_RegDef_t*)TIM2_BASEADDR)
+#define TIM5    ((TIM_RegDef_t*)TIM5_BASEADDR)
+
+#define PWR     ((PWR_RegDef_t*)PWR_BASEADDR)
+
+#define FLASH   ((FLASH_RegDef_t*)FLASHINTR_BASEADDR)
+
+#define RTC     ((RTC_RegDef_t*)RTCBKP_BASEADDR)
+
 /*****************************************************************************************************/
 /*                          Peripheral macros                                                        */
 /*****************************************************************************************************/
@@ -564,6 +982,24 @@ typedef struct
  */
 #define SYSCFG_PCLK_EN()    (RCC->APB2ENR |= (1 << 14))
 
+/**
+ * Clock enable macros for DMAx peripheral.
+ */
+#define DMA1_PCLK_EN()      (RCC->AHB1ENR |= (1 << 21))
+#define DMA2_PCLK_EN()      (RCC->AHB1ENR |= (1 << 22))
+
+/**
+ * Clock enable macros for TIMx peripheral.
+ */
+#define TIM1_PCLK_EN()      (RCC->APB2ENR |= (1 << 0))
+#define TIM2_PCLK_EN()      (RCC->APB1ENR |= (1 << 0))
+#define TIM5_PCLK_EN()      (RCC->APB1ENR |= (1 << 3))
+
+/**
+ * Clock enable macro for PWR peripheral.
+ */
+#define PWR_PCLK_EN()       (RCC->APB1ENR |= (1 << 28))
+
 /**
  * Clock disable macros for GPIOx peripheral.
  */
@@ -685,6 +1121,9 @@ typedef struct
 #define IRQ_NO_UART4        52
 #define IRQ_NO_UART5        53
 #define IRQ_NO_USART6       71
+#define IRQ_NO_DMA1_STREAM6 17
+#define IRQ_NO_DMA2_STREAM5 68
+#define IRQ_NO_RTC_WKUP     3
 
 /**
  * IRQ priority.
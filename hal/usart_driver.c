@@ -0,0 +1,561 @@
+/*****************************************************************************************************
+* FILENAME :        usart_driver.c
+*
+* DESCRIPTION :
+*       File containing the USART driver.
+*
+* PUBLIC FUNCTIONS :
+*       void    USART_Init(USART_Handle_t* pUSARTHandle)
+*       void    USART_DeInit(USART_RegDef_t* pUSARTx)
+*       void    USART_PerClkCtrl(USART_RegDef_t* pUSARTx, uint8_t en_or_di)
+*       void    USART_SendData(USART_Handle_t* pUSARTHandle, uint8_t* pTxBuffer, uint32_t len)
+*       void    USART_ReceiveData(USART_Handle_t* pUSARTHandle, uint8_t* pRxBuffer, uint32_t len)
+*       uint8_t USART_SendDataIT(USART_Handle_t* pUSARTHandle, uint8_t* pTxBuffer, uint32_t len)
+*       uint8_t USART_ReceiveDataIT(USART_Handle_t* pUSARTHandle, uint8_t* pRxBuffer, uint32_t len)
+*       void    USART_SetBaudRate(USART_RegDef_t* pUSARTx, uint32_t BaudRate)
+*       void    USART_IRQConfig(uint8_t IRQNumber, uint8_t en_or_di)
+*       void    USART_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority)
+*       void    USART_IRQHandling(USART_Handle_t* pUSARTHandle)
+*       void    USART_Enable(USART_RegDef_t* pUSARTx, uint8_t en_or_di)
+*       uint8_t USART_GetFlagStatus(USART_RegDef_t* pUSARTx, uint32_t flagname)
+*       void    USART_ClearFlag(USART_RegDef_t* pUSARTx, uint16_t StatusFlagName)
+*       void    USART_ApplicationEventCallback(USART_Handle_t* pUSARTHandle, uint8_t app_event)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+**/
+
+#include "usart_driver.h"
+#include "rcc_driver.h"
+#include "stm32f446xx.h"
+#include <stdint.h>
+#include <stddef.h>
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void USART_Init(USART_Handle_t* pUSARTHandle){
+
+    uint32_t tempreg = 0;
+
+    /* Enable the peripheral clock */
+    USART_PerClkCtrl(pUSARTHandle->pUSARTx, ENABLE);
+
+    /* Configuration of CR1 */
+    /* Enable USART Tx and Rx engines according to the USART_Mode configuration item */
+    if(pUSARTHandle->USART_Config.USART_Mode == USART_MODE_ONLY_RX){
+        tempreg |= (1 << USART_CR1_RE);
+    }
+    else if(pUSARTHandle->USART_Config.USART_Mode == USART_MODE_ONLY_TX){
+        tempreg |= (1 << USART_CR1_TE);
+    }
+    else if(pUSARTHandle->USART_Config.USART_Mode == USART_MODE_TXRX){
+        tempreg |= ((1 << USART_CR1_RE) | (1 << USART_CR1_TE));
+    }
+
+    /* Configure the word length */
+    tempreg |= pUSARTHandle->USART_Config.USART_WordLength << USART_CR1_M;
+
+    /* Configuration of parity control bit fields */
+    if(pUSARTHandle->USART_Config.USART_ParityControl == USART_PARITY_EN_EVEN){
+        /* Enable the parity control, even parity is selected by default */
+        tempreg |= (1 << USART_CR1_PCE);
+    }
+    else if(pUSARTHandle->USART_Config.USART_ParityControl == USART_PARITY_EN_ODD){
+        /* Enable the parity control and select odd parity */
+        tempreg |= (1 << USART_CR1_PCE);
+        tempreg |= (1 << USART_CR1_PS);
+    }
+
+    pUSARTHandle->pUSARTx->CR1 = tempreg;
+
+    /* Configuration of CR2 */
+    tempreg = 0;
+
+    /* Configure the number of stop bits */
+    tempreg |= pUSARTHandle->USART_Config.USART_NoOfStopBits << USART_CR2_STOP;
+
+    pUSARTHandle->pUSARTx->CR2 = tempreg;
+
+    /* Configuration of CR3 */
+    tempreg = 0;
+
+    /* Configuration of USART hardware flow control */
+    if(pUSARTHandle->USART_Config.USART_HWFlowControl == USART_HW_FLOW_CTRL_CTS){
+        tempreg |= (1 << USART_CR3_CTSE);
+    }
+    else if(pUSARTHandle->USART_Config.USART_HWFlowControl == USART_HW_FLOW_CTRL_RTS){
+        tempreg |= (1 << USART_CR3_RTSE);
+    }
+    else if(pUSARTHandle->USART_Config.USART_HWFlowControl == USART_HW_FLOW_CTRL_CTS_RTS){
+        tempreg |= (1 << USART_CR3_CTSE);
+        tempreg |= (1 << USART_CR3_RTSE);
+    }
+
+    pUSARTHandle->pUSARTx->CR3 = tempreg;
+
+    /* Configuration of BRR */
+    USART_SetBaudRate(pUSARTHandle->pUSARTx, pUSARTHandle->USART_Config.USART_Baud);
+}
+
+void USART_DeInit(USART_RegDef_t* pUSARTx){
+
+    if(pUSARTx == USART1){
+        USART1_REG_RESET();
+    }
+    else if(pUSARTx == USART2){
+        USART2_REG_RESET();
+    }
+    else if(pUSARTx == USART3){
+        USART3_REG_RESET();
+    }
+    else if(pUSARTx == UART4){
+        UART4_REG_RESET();
+    }
+    else if(pUSARTx == UART5){
+        UART5_REG_RESET();
+    }
+    else if(pUSARTx == USART6){
+        USART6_REG_RESET();
+    }
+}
+
+void USART_PerClkCtrl(USART_RegDef_t* pUSARTx, uint8_t en_or_di){
+
+    if(en_or_di == ENABLE){
+        if(pUSARTx == USART1){
+            USART1_PCLK_EN();
+        }
+        else if(pUSARTx == USART2){
+            USART2_PCLK_EN();
+        }
+        else if(pUSARTx == USART3){
+            USART3_PCLK_EN();
+        }
+        else if(pUSARTx == UART4){
+            UART4_PCLK_EN();
+        }
+        else if(pUSARTx == UART5){
+            UART5_PCLK_EN();
+        }
+        else if(pUSARTx == USART6){
+            USART6_PCLK_EN();
+        }
+    }
+    else{
+        if(pUSARTx == USART1){
+            USART1_PCLK_DI();
+        }
+        else if(pUSARTx == USART2){
+            USART2_PCLK_DI();
+        }
+        else if(pUSARTx == USART3){
+            USART3_PCLK_DI();
+        }
+        else if(pUSARTx == UART4){
+            UART4_PCLK_DI();
+        }
+        else if(pUSARTx == UART5){
+            UART5_PCLK_DI();
+        }
+        else if(pUSARTx == USART6){
+            USART6_PCLK_DI();
+        }
+    }
+}
+
+void USART_SendData(USART_Handle_t* pUSARTHandle, uint8_t* pTxBuffer, uint32_t len){
+
+    uint16_t* pdata;
+    uint32_t i;
+
+    /* Loop over until "len" number of bytes are transferred */
+    for(i = 0; i < len; i++){
+        /* Wait until TXE flag is set in the SR */
+        while(!USART_GetFlagStatus(pUSARTHandle->pUSARTx, USART_FLAG_TXE));
+
+        /* Check the USART_WordLength item for 9 bit or 8 bit in a frame */
+        if(pUSARTHandle->USART_Config.USART_WordLength == USART_WORDLEN_9BITS){
+            /* If 9 bit, load the DR with 2 bytes masking the bits other than first 9 bits */
+            pdata = (uint16_t*)pTxBuffer;
+            pUSARTHandle->pUSARTx->DR = (*pdata & (uint16_t)0x01FF);
+
+            /* Check for USART_ParityControl */
+            if(pUSARTHandle->USART_Config.USART_ParityControl == USART_PARITY_DISABLE){
+                /* No parity is used in this transfer, so 9 bits of user data will be sent */
+                pTxBuffer++;
+                pTxBuffer++;
+            }
+            else{
+                /* Parity bit is used in this transfer, so 8 bits of user data will be sent */
+                pTxBuffer++;
+            }
+        }
+        else{
+            /* This is 8 bit data transfer */
+            pUSARTHandle->pUSARTx->DR = (*pTxBuffer & (uint8_t)0xFF);
+            pTxBuffer++;
+        }
+    }
+
+    /* Wait until TC flag is set in the SR */
+    while(!USART_GetFlagStatus(pUSARTHandle->pUSARTx, USART_FLAG_TC));
+}
+
+void USART_ReceiveData(USART_Handle_t* pUSARTHandle, uint8_t* pRxBuffer, uint32_t len){
+
+    uint32_t i;
+
+    /* Loop over until "len" number of bytes are transferred */
+    for(i = 0; i < len; i++){
+        /* Wait until RXNE flag is set in the SR */
+        while(!USART_GetFlagStatus(pUSARTHandle->pUSARTx, USART_FLAG_RXNE));
+
+        /* Check the USART_WordLength to decide whether we are going to receive 9 bit or 8 bit of data */
+        if(pUSARTHandle->USART_Config.USART_WordLength == USART_WORDLEN_9BITS){
+            /* We are going to receive 9 bit data in a frame */
+            if(pUSARTHandle->USART_Config.USART_ParityControl == USART_PARITY_DISABLE){
+                /* No parity is used, so all 9 bits will be of user data */
+                *((uint16_t*)pRxBuffer) = (pUSARTHandle->pUSARTx->DR & (uint16_t)0x01FF);
+                pRxBuffer++;
+                pRxBuffer++;
+            }
+            else{
+                /* Parity is used, so 8 bits will be of user data and 1 bit is parity */
+                *pRxBuffer = (pUSARTHandle->pUSARTx->DR & (uint8_t)0xFF);
+                pRxBuffer++;
+            }
+        }
+        else{
+            /* We are going to receive 8 bit data in a frame */
+            if(pUSARTHandle->USART_Config.USART_ParityControl == USART_PARITY_DISABLE){
+                /* No parity is used, so all 8 bits will be of user data */
+                *pRxBuffer = (uint8_t)(pUSARTHandle->pUSARTx->DR & (uint8_t)0xFF);
+            }
+            else{
+                /* Parity is used, so 7 bits will be of user data and 1 bit is parity */
+                *pRxBuffer = (uint8_t)(pUSARTHandle->pUSARTx->DR & (uint8_t)0x7F);
+            }
+            pRxBuffer++;
+        }
+    }
+}
+
+uint8_t USART_SendDataIT(USART_Handle_t* pUSARTHandle, uint8_t* pTxBuffer, uint32_t len){
+
+    uint8_t txstate = pUSARTHandle->TxBusyState;
+
+    if(txstate != USART_BUSY_IN_TX){
+        pUSARTHandle->TxLen = len;
+        pUSARTHandle->pTxBuffer = pTxBuffer;
+        pUSARTHandle->TxBusyState = USART_BUSY_IN_TX;
+
+        /* Enable interrupt for TXE */
+        pUSARTHandle->pUSARTx->CR1 |= (1 << USART_CR1_TXEIE);
+
+        /* Enable interrupt for TC */
+        pUSARTHandle->pUSARTx->CR1 |= (1 << USART_CR1_TCIE);
+    }
+
+    return txstate;
+}
+
+uint8_t USART_ReceiveDataIT(USART_Handle_t* pUSARTHandle, uint8_t* pRxBuffer, uint32_t len){
+
+    uint8_t rxstate = pUSARTHandle->RxBusyState;
+
+    if(rxstate != USART_BUSY_IN_RX){
+        pUSARTHandle->RxLen = len;
+        pUSARTHandle->pRxBuffer = pRxBuffer;
+        pUSARTHandle->RxBusyState = USART_BUSY_IN_RX;
+
+        /* Enable interrupt for RXNE */
+        pUSARTHandle->pUSARTx->CR1 |= (1 << USART_CR1_RXNEIE);
+    }
+
+    return rxstate;
+}
+
+void USART_SetBaudRate(USART_RegDef_t* pUSARTx, uint32_t BaudRate){
+
+    uint32_t PCLKx;
+    uint32_t usartdiv;
+    uint32_t M_part, F_part;
+    uint32_t tempreg = 0;
+
+    /* Get the value of APB bus clock in to the variable PCLKx */
+    if(pUSARTx == USART1 || pUSARTx == USART6){
+        /* USART1 and USART6 are hanging on APB2 bus */
+        PCLKx = RCC_GetPCLK2Value();
+    }
+    else{
+        PCLKx = RCC_GetPCLK1Value();
+    }
+
+    /* Check for OVER8 configuration bit, usartdiv is scaled by 100 */
+    if(pUSARTx->CR1 & (1 << USART_CR1_OVER8)){
+        /* OVER8 = 1, over sampling by 8 */
+        usartdiv = ((25 * PCLKx) / (2 * BaudRate));
+    }
+    else{
+        /* Over sampling by 16 */
+        usartdiv = ((25 * PCLKx) / (4 * BaudRate));
+    }
+
+    /* Calculate the mantissa part */
+    M_part = usartdiv / 100;
+
+    /* Place the mantissa part in appropriate bit position, refer USART_BRR */
+    tempreg |= M_part << 4;
+
+    /* Extract the fraction part */
+    F_part = (usartdiv - (M_part * 100));
+
+    /* Calculate the final fractional */
+    if(pUSARTx->CR1 & (1 << USART_CR1_OVER8)){
+        /* OVER8 = 1, over sampling by 8 */
+        F_part = (((F_part * 8) + 50) / 100) & ((uint8_t)0x07);
+    }
+    else{
+        /* Over sampling by 16 */
+        F_part = (((F_part * 16) + 50) / 100) & ((uint8_t)0x0F);
+    }
+
+    /* Place the fractional part in appropriate bit position, refer USART_BRR */
+    tempreg |= F_part;
+
+    /* Copy the value of tempreg in to BRR register */
+    pUSARTx->BRR = tempreg;
+}
+
+void USART_IRQConfig(uint8_t IRQNumber, uint8_t en_or_di){
+
+    if(en_or_di == ENABLE){
+        if(IRQNumber <= 31){
+            *NVIC_ISER0 |= (1 << IRQNumber);
+        }
+        else if(IRQNumber > 31 && IRQNumber < 64){
+            *NVIC_ISER1 |= (1 << (IRQNumber % 32));
+        }
+        else if(IRQNumber >= 64 && IRQNumber < 96){
+            *NVIC_ISER2 |= (1 << (IRQNumber % 64));
+        }
+    }
+    else{
+        if(IRQNumber <= 31){
+            *NVIC_ICER0 |= (1 << IRQNumber);
+        }
+        else if(IRQNumber > 31 && IRQNumber < 64){
+            *NVIC_ICER1 |= (1 << (IRQNumber % 32));
+        }
+        else if(IRQNumber >= 64 && IRQNumber < 96){
+            *NVIC_ICER2 |= (1 << (IRQNumber % 64));
+        }
+    }
+}
+
+void USART_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority){
+
+    uint8_t iprx = IRQNumber / 4;
+    uint8_t iprx_section = IRQNumber % 4;
+    uint8_t shift_amount = (8 * iprx_section) + (8 - NO_PR_BITS_IMPLEMENTED);
+
+    *(NVIC_PR_BASEADDR + iprx) |= (IRQPriority << shift_amount);
+}
+
+void USART_IRQHandling(USART_Handle_t* pUSARTHandle){
+
+    uint32_t temp1, temp2, temp3;
+    uint16_t* pdata;
+
+    /* Check for TC flag */
+    temp1 = pUSARTHandle->pUSARTx->SR & (1 << USART_SR_TC);
+    temp2 = pUSARTHandle->pUSARTx->CR1 & (1 << USART_CR1_TCIE);
+    if(temp1 && temp2){
+        /* This interrupt is because of TC, close transmission and call application callback if TxLen is zero */
+        if(pUSARTHandle->TxBusyState == USART_BUSY_IN_TX){
+            if(!pUSARTHandle->TxLen){
+                /* Clear the TC flag */
+                pUSARTHandle->pUSARTx->SR &= ~(1 << USART_SR_TC);
+                /* Clear the TCIE control bit */
+                pUSARTHandle->pUSARTx->CR1 &= ~(1 << USART_CR1_TCIE);
+                /* Reset the application state */
+                pUSARTHandle->TxBusyState = USART_READY;
+                pUSARTHandle->pTxBuffer = NULL;
+                pUSARTHandle->TxLen = 0;
+                /* Call the application callback with USART_EVENT_TX_CMPLT */
+                USART_ApplicationEventCallback(pUSARTHandle, USART_EVENT_TX_CMPLT);
+            }
+        }
+    }
+
+    /* Check for TXE flag */
+    temp1 = pUSARTHandle->pUSARTx->SR & (1 << USART_SR_TXE);
+    temp2 = pUSARTHandle->pUSARTx->CR1 & (1 << USART_CR1_TXEIE);
+    if(temp1 && temp2){
+        /* This interrupt is because of TXE */
+        if(pUSARTHandle->TxBusyState == USART_BUSY_IN_TX){
+            /* Keep sending data until TxLen reaches to zero */
+            if(pUSARTHandle->TxLen > 0){
+                /* Check the USART_WordLength item for 9 bit or 8 bit in a frame */
+                if(pUSARTHandle->USART_Config.USART_WordLength == USART_WORDLEN_9BITS){
+                    /* If 9 bit, load the DR with 2 bytes masking the bits other than first 9 bits */
+                    pdata = (uint16_t*)pUSARTHandle->pTxBuffer;
+                    pUSARTHandle->pUSARTx->DR = (*pdata & (uint16_t)0x01FF);
+
+                    /* Check for USART_ParityControl */
+                    if(pUSARTHandle->USART_Config.USART_ParityControl == USART_PARITY_DISABLE){
+                        /* No parity is used in this transfer, so 9 bits of user data will be sent */
+                        pUSARTHandle->pTxBuffer++;
+                        pUSARTHandle->pTxBuffer++;
+                        pUSARTHandle->TxLen -= 2;
+                    }
+                    else{
+                        /* Parity bit is used in this transfer, so 8 bits of user data will be sent */
+                        pUSARTHandle->pTxBuffer++;
+                        pUSARTHandle->TxLen--;
+                    }
+                }
+                else{
+                    /* This is 8 bit data transfer */
+                    pUSARTHandle->pUSARTx->DR = (*pUSARTHandle->pTxBuffer & (uint8_t)0xFF);
+                    pUSARTHandle->pTxBuffer++;
+                    pUSARTHandle->TxLen--;
+                }
+            }
+            if(pUSARTHandle->TxLen == 0){
+                /* TxLen is zero, clear the TXEIE bit (disable interrupt for TXE flag) */
+                pUSARTHandle->pUSARTx->CR1 &= ~(1 << USART_CR1_TXEIE);
+            }
+        }
+    }
+
+    /* Check for RXNE flag */
+    temp1 = pUSARTHandle->pUSARTx->SR & (1 << USART_SR_RXNE);
+    temp2 = pUSARTHandle->pUSARTx->CR1 & (1 << USART_CR1_RXNEIE);
+    if(temp1 && temp2){
+        /* This interrupt is because of RXNE */
+        if(pUSARTHandle->RxBusyState == USART_BUSY_IN_RX){
+            if(pUSARTHandle->RxLen > 0){
+                /* Check the USART_WordLength to decide whether we are going to receive 9 bit or 8 bit of data */
+                if(pUSARTHandle->USART_Config.USART_WordLength == USART_WORDLEN_9BITS){
+                    /* We are going to receive 9 bit data in a frame */
+                    if(pUSARTHandle->USART_Config.USART_ParityControl == USART_PARITY_DISABLE){
+                        /* No parity is used, so all 9 bits will be of user data */
+                        *((uint16_t*)pUSARTHandle->pRxBuffer) = (pUSARTHandle->pUSARTx->DR & (uint16_t)0x01FF);
+                        pUSARTHandle->pRxBuffer++;
+                        pUSARTHandle->pRxBuffer++;
+                        pUSARTHandle->RxLen -= 2;
+                    }
+                    else{
+                        /* Parity is used, so 8 bits will be of user data and 1 bit is parity */
+                        *pUSARTHandle->pRxBuffer = (pUSARTHandle->pUSARTx->DR & (uint8_t)0xFF);
+                        pUSARTHandle->pRxBuffer++;
+                        pUSARTHandle->RxLen--;
+                    }
+                }
+                else{
+                    /* We are going to receive 8 bit data in a frame */
+                    if(pUSARTHandle->USART_Config.USART_ParityControl == USART_PARITY_DISABLE){
+                        /* No parity is used, so all 8 bits will be of user data */
+                        *pUSARTHandle->pRxBuffer = (uint8_t)(pUSARTHandle->pUSARTx->DR & (uint8_t)0xFF);
+                    }
+                    else{
+                        /* Parity is used, so 7 bits will be of user data and 1 bit is parity */
+                        *pUSARTHandle->pRxBuffer = (uint8_t)(pUSARTHandle->pUSARTx->DR & (uint8_t)0x7F);
+                    }
+                    pUSARTHandle->pRxBuffer++;
+                    pUSARTHandle->RxLen--;
+                }
+            }
+            if(!pUSARTHandle->RxLen){
+                /* Disable the RXNE interrupt */
+                pUSARTHandle->pUSARTx->CR1 &= ~(1 << USART_CR1_RXNEIE);
+                pUSARTHandle->RxBusyState = USART_READY;
+                USART_ApplicationEventCallback(pUSARTHandle, USART_EVENT_RX_CMPLT);
+            }
+        }
+    }
+
+    /* Check for CTS flag */
+    /* Note: CTS feature is not applicable for UART4 and UART5 */
+    temp1 = pUSARTHandle->pUSARTx->SR & (1 << USART_SR_CTS);
+    temp2 = pUSARTHandle->pUSARTx->CR3 & (1 << USART_CR3_CTSE);
+    temp3 = pUSARTHandle->pUSARTx->CR3 & (1 << USART_CR3_CTSIE);
+    if(temp1 && temp2 && temp3){
+        /* Clear the CTS flag in SR */
+        pUSARTHandle->pUSARTx->SR &= ~(1 << USART_SR_CTS);
+        /* This interrupt is because of CTS */
+        USART_ApplicationEventCallback(pUSARTHandle, USART_EVENT_CTS);
+    }
+
+    /* Check for IDLE detection flag */
+    temp1 = pUSARTHandle->pUSARTx->SR & (1 << USART_SR_IDLE);
+    temp2 = pUSARTHandle->pUSARTx->CR1 & (1 << USART_CR1_IDLEIE);
+    if(temp1 && temp2){
+        /* Clear the IDLE flag, refer to the RM to understand the clear sequence */
+        temp1 = pUSARTHandle->pUSARTx->SR;
+        temp1 = pUSARTHandle->pUSARTx->DR;
+        /* This interrupt is because of IDLE */
+        USART_ApplicationEventCallback(pUSARTHandle, USART_EVENT_IDLE);
+    }
+
+    /* Check for overrun detection flag */
+    temp1 = pUSARTHandle->pUSARTx->SR & (1 << USART_SR_ORE);
+    temp2 = pUSARTHandle->pUSARTx->CR1 & (1 << USART_CR1_RXNEIE);
+    if(temp1 && temp2){
+        /* Clear the ORE flag reading SR and DR */
+        temp1 = pUSARTHandle->pUSARTx->SR;
+        temp1 = pUSARTHandle->pUSARTx->DR;
+        /* This interrupt is because of overrun error */
+        USART_ApplicationEventCallback(pUSARTHandle, USART_ERR_ORE);
+    }
+
+    /* Check for error flags (noise, overrun and framing) in multibuffer communication */
+    temp2 = pUSARTHandle->pUSARTx->CR3 & (1 << USART_CR3_EIE);
+    if(temp2){
+        temp1 = pUSARTHandle->pUSARTx->SR;
+        if(temp1 & (1 << USART_SR_FE)){
+            /* Framing error, cleared by a read to SR followed by a read to DR */
+            USART_ApplicationEventCallback(pUSARTHandle, USART_ERR_FE);
+        }
+        if(temp1 & (1 << USART_SR_NF)){
+            /* Noise error, cleared by a read to SR followed by a read to DR */
+            USART_ApplicationEventCallback(pUSARTHandle, USART_ERR_NE);
+        }
+        if(temp1 & (1 << USART_SR_ORE)){
+            USART_ApplicationEventCallback(pUSARTHandle, USART_ERR_ORE);
+        }
+    }
+}
+
+void USART_Enable(USART_RegDef_t* pUSARTx, uint8_t en_or_di){
+
+    if(en_or_di == ENABLE){
+        pUSARTx->CR1 |= (1 << USART_CR1_UE);
+    }
+    else{
+        pUSARTx->CR1 &= ~(1 << USART_CR1_UE);
+    }
+}
+
+uint8_t USART_GetFlagStatus(USART_RegDef_t* pUSARTx, uint32_t flagname){
+
+    if(pUSARTx->SR & flagname){
+        return FLAG_SET;
+    }
+
+    return FLAG_RESET;
+}
+
+void USART_ClearFlag(USART_RegDef_t* pUSARTx, uint16_t StatusFlagName){
+
+    pUSARTx->SR &= ~StatusFlagName;
+}
+
+__attribute__((weak)) void USART_ApplicationEventCallback(USART_Handle_t* pUSARTHandle, uint8_t app_event){
+
+    /* This is a weak implementation, the application may override this function */
+}
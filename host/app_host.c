@@ -0,0 +1,281 @@
+/*****************************************************************************************************
+* FILENAME :        app_host.c
+*
+* DESCRIPTION :
+*       File containing the main function of the host application build. It runs the BSP (bsp/ds1307.c,
+*       bsp/hd44780.c with the GPIO transport) and the application frames (src/app.c) against the
+*       GPIO and I2C stand-ins, with the DS1307 and HD44780 emulators attached, the way src/main.c
+*       does on the board: set the RTC, then read it and refresh the LCD once per second.
+*
+* NOTES :
+*       Usage: app_host [-n frames] [-q] [-v] [-t trace.bin]
+*           -n  number of frames (simulated seconds) to run (default 5).
+*           -q  only print the summary line.
+*           -v  also print the console output of every frame.
+*           -t  write the bus trace (hal/bustrace.h) to a file, read by bustrace_vcd. The trace
+*               keeps the last BUSTRACE_RECORDS events of the run.
+*
+*       Every frame is checked against a reference clock computed with the C library: the emulated
+*       LCD must show the expected time and date. The exit status is 1 if a frame does not match or
+*       the HD44780 emulator detected any timing violation.
+*
+**/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "app.h"
+#include "ds1307.h"
+#include "hd44780.h"
+#include "hd44780_emu.h"
+#include "ds1307_emu.h"
+#include "gpio_sim.h"
+#include "i2c_sim.h"
+#include "fmt.h"
+#include "rcc_driver.h"
+#include "bustrace.h"
+#include "timesnap.h"
+
+/* Date and time set by src/main.c: Saturday 17/07/21, 11:59:15 PM */
+#define APP_HOST_START_YEAR     2021
+#define APP_HOST_START_MONTH    7
+#define APP_HOST_START_DATE     17
+#define APP_HOST_START_HOURS    23
+#define APP_HOST_START_MINUTES  59
+#define APP_HOST_START_SECONDS  15
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn set_clock
+ *
+ * @brief function to set the RTC as src/main.c does.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ */
+static void set_clock(void);
+
+/**
+ * @fn check_frame
+ *
+ * @brief function to compare the emulated LCD with the reference clock.
+ *
+ * @param[in] seconds is the number of seconds since the time set by set_clock.
+ *
+ * @return 0 if the LCD shows the expected content, 1 otherwise.
+ */
+static uint8_t check_frame(uint32_t seconds);
+
+/**
+ * @fn host_ns
+ *
+ * @brief function to get the CPU time used by the process.
+ *
+ * @param[in] void.
+ *
+ * @return CPU time in nanoseconds.
+ */
+static uint64_t host_ns(void);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void hd44780_udelay(uint32_t cnt){
+
+    gpio_sim_advance((uint64_t)cnt * 1000);
+}
+
+uint32_t RCC_GetHCLKValue(void){
+
+    /* Only read by hd44780_bus_init for the weak hd44780_udelay, which is replaced above */
+    return RCC_HSI_VALUE;
+}
+
+int main(int argc, char* argv[]){
+
+    hd44780_emu_stats_t stats;
+    i2c_sim_stats_t i2c_before;
+    i2c_sim_stats_t i2c_after;
+    fmt_console_sink_t console;
+    FILE* trace = NULL;
+    RTC_time_t time;
+    RTC_date_t date;
+    uint64_t total_ns = 0;
+    uint64_t total_host_ns = 0;
+    uint64_t start_ns = 0;
+    uint32_t gpio_writes = 0;
+    uint32_t mismatches = 0;
+    uint32_t frames = 5;
+    uint32_t i = 0;
+    int quiet = 0;
+    int verbose = 0;
+    int opt = 0;
+
+    while((opt = getopt(argc, argv, "n:qvt:")) != -1){
+        switch(opt){
+            case 'n':
+                frames = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'q':
+                quiet = 1;
+                break;
+            case 'v':
+                verbose = 1;
+                break;
+            case 't':
+                trace = fopen(optarg, "wb");
+                if(trace == NULL){
+                    perror(optarg);
+                    return 2;
+                }
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-n frames] [-q] [-v] [-t trace.bin]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    gpio_sim_reset();
+    i2c_sim_reset();
+    bustrace_init(1000000000);
+    fmt_console_sink_init(&console, STDOUT_FILENO);
+
+    hd44780_init();
+    if(ds1307_init()){
+        fprintf(stderr, "RTC init failed\n");
+        return 1;
+    }
+    set_clock();
+    hd44780_display_clear();
+    hd44780_display_return_home();
+
+    for(i = 0; i < frames; i++){
+        ds1307_emu_advance(1);
+
+        i2c_sim_get_stats(&i2c_before);
+        gpio_writes = gpio_sim_get_writes();
+        start_ns = host_ns();
+        hd44780_emu_frame_begin(gpio_sim_now());
+
+        /* As the RTC and LCD tasks: read and publish, then show the published snapshot */
+        ds1307_get_current_time(&time);
+        ds1307_get_current_date(&date);
+        timesnap_publish(&time, &date);
+        timesnap_read(&time, &date);
+        app_lcd_show(&time, &date);
+
+        hd44780_emu_frame_end(gpio_sim_now(), &stats);
+        total_host_ns += host_ns() - start_ns;
+        i2c_sim_get_stats(&i2c_after);
+        total_ns += stats.elapsed_ns;
+
+        mismatches += check_frame(i + 1);
+
+        if(!quiet){
+            printf("frame %u: %llu us, %u I2C transactions (%llu us), %u GPIO writes, %u LCD commands, "
+                   "%u data writes, %u violations\n", i, (unsigned long long)(stats.elapsed_ns / 1000),
+                   i2c_after.transactions - i2c_before.transactions,
+                   (unsigned long long)((i2c_after.bus_ns - i2c_before.bus_ns) / 1000),
+                   gpio_sim_get_writes() - gpio_writes, stats.commands, stats.data_writes, stats.violations);
+        }
+        if(verbose){
+            fflush(stdout);
+            app_console_show(&console.sink, &time, &date);
+        }
+    }
+
+    printf("frames: %u, mean bus time per frame: %llu us, mean host time per frame: %llu ns, "
+           "mismatches: %u, violations: %u\n", frames,
+           (unsigned long long)(frames ? (total_ns / frames / 1000) : 0),
+           (unsigned long long)(frames ? (total_host_ns / frames) : 0), mismatches, hd44780_emu_violations());
+
+    if(trace != NULL){
+        fwrite(&bustrace, sizeof(bustrace), 1, trace);
+        fclose(trace);
+    }
+
+    return (mismatches || hd44780_emu_violations()) ? 1 : 0;
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static void set_clock(void){
+
+    RTC_time_t time;
+    RTC_date_t date;
+
+    date.day = SATURDAY;
+    date.date = APP_HOST_START_DATE;
+    date.month = APP_HOST_START_MONTH;
+    date.year = APP_HOST_START_YEAR % 100;
+
+    time.hours = APP_HOST_START_HOURS - 12;
+    time.minutes = APP_HOST_START_MINUTES;
+    time.seconds = APP_HOST_START_SECONDS;
+    time.time_format = T_FORMAT_12HRS_PM;
+
+    ds1307_set_current_date(&date);
+    ds1307_set_current_time(&time);
+}
+
+static uint8_t check_frame(uint32_t seconds){
+
+    static const char* days[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+    char expected[2][32];
+    char line[HD44780_EMU_COLUMNS + 1];
+    struct tm tm;
+    time_t t;
+    uint8_t row = 0;
+    uint8_t mismatch = 0;
+    size_t len = 0;
+
+    memset(&tm, 0, sizeof(tm));
+    tm.tm_year = APP_HOST_START_YEAR - 1900;
+    tm.tm_mon = APP_HOST_START_MONTH - 1;
+    tm.tm_mday = APP_HOST_START_DATE;
+    tm.tm_hour = APP_HOST_START_HOURS;
+    tm.tm_min = APP_HOST_START_MINUTES;
+    tm.tm_sec = APP_HOST_START_SECONDS;
+    t = timegm(&tm) + seconds;
+    gmtime_r(&t, &tm);
+
+    snprintf(expected[0], sizeof(expected[0]), "%02d:%02d:%02d %s", (tm.tm_hour % 12) ? (tm.tm_hour % 12) : 12,
+             tm.tm_min, tm.tm_sec, (tm.tm_hour >= 12) ? "PM" : "AM");
+    snprintf(expected[1], sizeof(expected[1]), "%02d/%02d/%02d<%s>", tm.tm_mday, tm.tm_mon + 1,
+             tm.tm_year % 100, days[tm.tm_wday]);
+
+    for(row = 1; row <= 2; row++){
+        /* The rest of the row is blank */
+        for(len = strlen(expected[row - 1]); len < HD44780_EMU_COLUMNS; len++){
+            expected[row - 1][len] = ' ';
+        }
+        expected[row - 1][HD44780_EMU_COLUMNS] = '\0';
+
+        hd44780_emu_get_line(row, line);
+        if(strcmp(line, expected[row - 1]) != 0){
+            fprintf(stderr, "row %u: |%s|, expected |%s|\n", row, line, expected[row - 1]);
+            mismatch = 1;
+        }
+    }
+
+    return mismatch;
+}
+
+static uint64_t host_ns(void){
+
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
@@ -0,0 +1,156 @@
+/*****************************************************************************************************
+* FILENAME :        bench_host.c
+*
+* DESCRIPTION :
+*       File containing the main function of the host benchmark. It runs the display path benchmark
+*       (src/bench.c) against the GPIO and I2C stand-ins, with the DS1307 and HD44780 emulators
+*       attached, as the benchmark firmware (src/bench_main.c) does on the board.
+*
+* NOTES :
+*       Usage: bench_host [-n runs] [-o bench.csv]
+*           -n  number of runs per scenario (default BENCH_RUNS).
+*           -o  output file of the CSV results (default standard output).
+*
+*       The benchmark clock is the simulated time of gpio_sim (LCD and I2C bus time, GPIO driver
+*       costs and busy waits) plus the CPU time used by the process, so the render stage, which does
+*       not touch the bus, is measured in host CPU time. The read and write stages are deterministic
+*       apart from the few microseconds of host CPU time they add.
+*
+*       The exit status is 1 if the HD44780 emulator detected any timing violation or the LCD does
+*       not show the last frame of the benchmark.
+*
+**/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "bench.h"
+#include "ds1307.h"
+#include "hd44780.h"
+#include "hd44780_emu.h"
+#include "gpio_sim.h"
+#include "i2c_sim.h"
+#include "fmt.h"
+#include "rcc_driver.h"
+
+/* Last frame of the benchmark: 24 hours format, odd number of runs shows 10 seconds */
+#define BENCH_HOST_ROW1_ODD     "23:59:10        "
+#define BENCH_HOST_ROW1_EVEN    "23:59:11        "
+#define BENCH_HOST_ROW2         "17/07/21<Sat>   "
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn check_lcd
+ *
+ * @brief function to compare the emulated LCD with the last frame of the benchmark.
+ *
+ * @param[in] runs is the number of runs per scenario.
+ *
+ * @return 0 if the LCD shows the expected content, 1 otherwise.
+ */
+static uint8_t check_lcd(uint32_t runs);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void hd44780_udelay(uint32_t cnt){
+
+    gpio_sim_advance((uint64_t)cnt * 1000);
+}
+
+uint32_t RCC_GetHCLKValue(void){
+
+    /* Only read by hd44780_bus_init for the weak hd44780_udelay, which is replaced above */
+    return RCC_HSI_VALUE;
+}
+
+uint32_t bench_now(void){
+
+    struct timespec ts;
+
+    /* Nanoseconds, given to bench_init */
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+
+    return (uint32_t)(gpio_sim_now() + ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec);
+}
+
+int main(int argc, char* argv[]){
+
+    fmt_console_sink_t console;
+    uint32_t runs = BENCH_RUNS;
+    uint8_t mismatch = 0;
+    int fd = STDOUT_FILENO;
+    int opt = 0;
+
+    while((opt = getopt(argc, argv, "n:o:")) != -1){
+        switch(opt){
+            case 'n':
+                runs = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'o':
+                fd = open(optarg, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+                if(fd < 0){
+                    perror(optarg);
+                    return 2;
+                }
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-n runs] [-o bench.csv]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    gpio_sim_reset();
+    i2c_sim_reset();
+    fmt_console_sink_init(&console, fd);
+
+    hd44780_init();
+    hd44780_display_clear();
+    hd44780_display_return_home();
+    if(ds1307_init()){
+        fprintf(stderr, "RTC init failed\n");
+        return 1;
+    }
+
+    bench_init(1000000000);
+    bench_run(&console.sink, runs);
+
+    if(fd != STDOUT_FILENO){
+        close(fd);
+    }
+
+    mismatch = check_lcd(runs);
+    fprintf(stderr, "scenarios: %u, runs: %u, violations: %u\n", BENCH_SCENARIOS, runs, hd44780_emu_violations());
+
+    return (mismatch || hd44780_emu_violations()) ? 1 : 0;
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static uint8_t check_lcd(uint32_t runs){
+
+    char line[HD44780_EMU_COLUMNS + 1];
+    const char* expected[2] = {(runs & 0x1) ? BENCH_HOST_ROW1_ODD : BENCH_HOST_ROW1_EVEN, BENCH_HOST_ROW2};
+    uint8_t mismatch = 0;
+    uint8_t row = 0;
+
+    for(row = 1; row <= 2; row++){
+        hd44780_emu_get_line(row, line);
+        if(strcmp(line, expected[row - 1]) != 0){
+            fprintf(stderr, "row %u: |%s|, expected |%s|\n", row, line, expected[row - 1]);
+            mismatch = 1;
+        }
+    }
+
+    return mismatch;
+}
@@ -0,0 +1,494 @@
+/*****************************************************************************************************
+* FILENAME :        bustrace_vcd.c
+*
+* DESCRIPTION :
+*       File containing the main function of the host bus trace converter. It finds the bus trace
+*       control block (hal/bustrace.h) in a RAM dump of the target, or in a file written by the host
+*       application (app_host -t), and writes the recorded GPIO and I2C activity as a VCD file.
+*
+* NOTES :
+*       Usage: bustrace_vcd [-s] [-o out.vcd] dump.bin
+*           -o  output file (default standard output).
+*           -s  print a summary of the bus time on standard error.
+*
+*       Signals: one wire per GPIO pin which changes in the trace (e.g. PC8), and for every I2C bus
+*       a busy wire (start to stop), the last address byte and the last data byte. The time unit is
+*       1 ns, the first record is at time 0. Open the file with GTKWave: gtkwave bus.vcd
+*
+*       The exit status is 1 if the control block is not found or it is not consistent.
+*
+**/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include "bustrace.h"
+
+#define PORTS               8
+#define BUSES               4
+#define RECORD_BYTES        8
+#define HEADER_BYTES        (BUSTRACE_ID_LEN + 12)
+
+/* Decoded record, time in ns since the first record */
+typedef struct
+{
+    uint64_t time;
+    uint8_t type;
+    uint8_t bus;
+    uint16_t value;
+}record_t;
+
+static uint8_t* dump = NULL;
+static uint32_t dump_len = 0;
+static record_t* records = NULL;
+static uint32_t nrecords = 0;
+static uint64_t vcd_last_time = 0;
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn load_dump
+ *
+ * @brief function to read a whole dump file in memory.
+ *
+ * @param[in] path of the dump file.
+ *
+ * @return 0 if OK, 1 on error.
+ */
+static int load_dump(const char* path);
+
+/**
+ * @fn read_word
+ *
+ * @brief function to read a little endian 32 bit word of the dump.
+ *
+ * @param[in] offset in the dump.
+ *
+ * @return word value.
+ */
+static uint32_t read_word(uint32_t offset);
+
+/**
+ * @fn load_records
+ *
+ * @brief function to find the control block and decode its records in time order.
+ *
+ * @param[in] void.
+ *
+ * @return 0 if OK, 1 if the control block is not found or not consistent.
+ */
+static int load_records(void);
+
+/**
+ * @fn vcd_id
+ *
+ * @brief function to build the VCD identifier of a signal.
+ *
+ * @param[in] index of the signal.
+ * @param[out] id is the identifier, at least 4 characters.
+ *
+ * @return void.
+ */
+static void vcd_id(uint32_t index, char* id);
+
+/**
+ * @fn vcd_stamp
+ *
+ * @brief function to write the time of the next value change, if it is not written yet.
+ *
+ * @param[in] out is the output file.
+ * @param[in] time in ns.
+ *
+ * @return void.
+ */
+static void vcd_stamp(FILE* out, uint64_t time);
+
+/**
+ * @fn write_vcd
+ *
+ * @brief function to write the records as a VCD file.
+ *
+ * @param[in] out is the output file.
+ *
+ * @return void.
+ */
+static void write_vcd(FILE* out);
+
+/**
+ * @fn print_summary
+ *
+ * @brief function to print the number of events and the bus time of every port and I2C bus.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ */
+static void print_summary(void);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+int main(int argc, char* argv[]){
+
+    FILE* out = stdout;
+    const char* out_path = NULL;
+    int summary = 0;
+    int opt = 0;
+
+    while((opt = getopt(argc, argv, "o:s")) != -1){
+        switch(opt){
+            case 'o':
+                out_path = optarg;
+                break;
+            case 's':
+                summary = 1;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-s] [-o out.vcd] dump.bin\n", argv[0]);
+                return 2;
+        }
+    }
+
+    if((optind >= argc) || load_dump(argv[optind])){
+        fprintf(stderr, "usage: %s [-s] [-o out.vcd] dump.bin\n", argv[0]);
+        return 2;
+    }
+
+    if(load_records()){
+        return 1;
+    }
+
+    if(out_path != NULL){
+        out = fopen(out_path, "w");
+        if(out == NULL){
+            perror(out_path);
+            return 1;
+        }
+    }
+
+    write_vcd(out);
+
+    if(out != stdout){
+        fclose(out);
+    }
+
+    if(summary){
+        print_summary();
+    }
+
+    free(records);
+    free(dump);
+
+    return 0;
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static int load_dump(const char* path){
+
+    FILE* f = fopen(path, "rb");
+    long len = 0;
+
+    if(f == NULL){
+        perror(path);
+        return 1;
+    }
+
+    fseek(f, 0, SEEK_END);
+    len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    dump = malloc((size_t)len);
+    if((dump == NULL) || (fread(dump, 1, (size_t)len, f) != (size_t)len)){
+        fprintf(stderr, "%s: read error\n", path);
+        fclose(f);
+        return 1;
+    }
+
+    dump_len = (uint32_t)len;
+    fclose(f);
+
+    return 0;
+}
+
+static uint32_t read_word(uint32_t offset){
+
+    if((offset + 4) > dump_len){
+        return 0xFFFFFFFF;
+    }
+
+    return (uint32_t)dump[offset] | ((uint32_t)dump[offset + 1] << 8) | ((uint32_t)dump[offset + 2] << 16) |
+           ((uint32_t)dump[offset + 3] << 24);
+}
+
+static int load_records(void){
+
+    uint32_t cb = 0;
+    uint32_t clock_hz = 0;
+    uint32_t size = 0;
+    uint32_t count = 0;
+    uint32_t first = 0;
+    uint32_t offset = 0;
+    uint32_t raw = 0;
+    uint32_t prev_raw = 0;
+    int64_t ticks = 0;
+    int64_t min_ticks = 0;
+    uint32_t i = 0;
+    uint32_t j = 0;
+    record_t tmp;
+
+    /* The control block is word aligned */
+    for(cb = 0; (cb + HEADER_BYTES) <= dump_len; cb += 4){
+        if(memcmp(&dump[cb], BUSTRACE_ID, BUSTRACE_ID_LEN) == 0){
+            break;
+        }
+    }
+    if((cb + HEADER_BYTES) > dump_len){
+        fprintf(stderr, "bus trace control block not found\n");
+        return 1;
+    }
+
+    clock_hz = read_word(cb + BUSTRACE_ID_LEN);
+    size = read_word(cb + BUSTRACE_ID_LEN + 4);
+    count = read_word(cb + BUSTRACE_ID_LEN + 8);
+    fprintf(stderr, "bus trace at offset 0x%08x, %u Hz, %u records written, %u kept\n", cb, clock_hz, count,
+            (count < size) ? count : size);
+
+    if((clock_hz == 0) || (size == 0) || (size & (size - 1)) ||
+       ((cb + HEADER_BYTES + (size * RECORD_BYTES)) > dump_len)){
+        fprintf(stderr, "inconsistent control block\n");
+        return 1;
+    }
+
+    records = malloc(size * sizeof(record_t));
+    if(records == NULL){
+        return 1;
+    }
+
+    /* Oldest record first, timestamps unwrapped against the previous record */
+    first = (count > size) ? (count - size) : 0;
+    for(i = first; i != count; i++){
+        offset = cb + HEADER_BYTES + ((i & (size - 1)) * RECORD_BYTES);
+        if(dump[offset + 4] == 0){
+            continue;
+        }
+        raw = read_word(offset);
+        ticks += (nrecords == 0) ? 0 : (int32_t)(raw - prev_raw);
+        prev_raw = raw;
+        if((nrecords == 0) || (ticks < min_ticks)){
+            min_ticks = ticks;
+        }
+        records[nrecords].time = (uint64_t)ticks;
+        records[nrecords].type = dump[offset + 4];
+        records[nrecords].bus = dump[offset + 5];
+        records[nrecords].value = (uint16_t)(dump[offset + 6] | (dump[offset + 7] << 8));
+        nrecords++;
+    }
+
+    /* A record written by an ISR may be earlier than the one it preempted: insertion sort, the
+       records are almost in order */
+    for(i = 0; i < nrecords; i++){
+        records[i].time = (uint64_t)(((int64_t)records[i].time - min_ticks) * 1000000000LL / clock_hz);
+        tmp = records[i];
+        for(j = i; (j > 0) && (records[j - 1].time > tmp.time); j--){
+            records[j] = records[j - 1];
+        }
+        records[j] = tmp;
+    }
+
+    return 0;
+}
+
+static void vcd_id(uint32_t index, char* id){
+
+    /* Printable characters from '!' to '~' */
+    do{
+        *id++ = (char)('!' + (index % 94));
+        index /= 94;
+    }while(index != 0);
+    *id = '\0';
+}
+
+static void vcd_stamp(FILE* out, uint64_t time){
+
+    if(time != vcd_last_time){
+        fprintf(out, "#%llu\n", (unsigned long long)time);
+        vcd_last_time = time;
+    }
+}
+
+static void write_vcd(FILE* out){
+
+    uint16_t port_first[PORTS];
+    uint16_t port_changed[PORTS];
+    uint16_t port_level[PORTS];
+    uint8_t port_seen[PORTS];
+    uint8_t bus_seen[BUSES];
+    uint32_t pin_signal[PORTS][16];
+    uint32_t bus_signal[BUSES];
+    uint32_t signals = 0;
+    uint32_t i = 0;
+    uint32_t pin = 0;
+    record_t* r = NULL;
+    char id[8];
+    int bit = 0;
+
+    memset(port_seen, 0, sizeof(port_seen));
+    memset(port_changed, 0, sizeof(port_changed));
+    memset(bus_seen, 0, sizeof(bus_seen));
+
+    /* Pins which change and buses which are used */
+    for(i = 0; i < nrecords; i++){
+        r = &records[i];
+        if((r->type == BUSTRACE_GPIO) && (r->bus < PORTS)){
+            if(!port_seen[r->bus]){
+                port_seen[r->bus] = 1;
+                port_first[r->bus] = r->value;
+            }
+            port_changed[r->bus] |= r->value ^ port_first[r->bus];
+        }
+        else if(r->bus < BUSES){
+            bus_seen[r->bus] = 1;
+        }
+    }
+
+    fprintf(out, "$version bustrace_vcd $end\n$timescale 1ns $end\n$scope module bus $end\n");
+    for(i = 0; i < PORTS; i++){
+        for(pin = 0; pin < 16; pin++){
+            if(port_changed[i] & (1 << pin)){
+                pin_signal[i][pin] = signals;
+                vcd_id(signals++, id);
+                fprintf(out, "$var wire 1 %s P%c%u $end\n", id, 'A' + i, pin);
+            }
+        }
+    }
+    for(i = 0; i < BUSES; i++){
+        if(bus_seen[i]){
+            bus_signal[i] = signals;
+            vcd_id(signals++, id);
+            fprintf(out, "$var wire 1 %s I2C%u_busy $end\n", id, i);
+            vcd_id(signals++, id);
+            fprintf(out, "$var wire 8 %s I2C%u_addr $end\n", id, i);
+            vcd_id(signals++, id);
+            fprintf(out, "$var wire 8 %s I2C%u_data $end\n", id, i);
+        }
+    }
+    fprintf(out, "$upscope $end\n$enddefinitions $end\n#0\n$dumpvars\n");
+
+    /* Initial values */
+    for(i = 0; i < PORTS; i++){
+        port_level[i] = port_first[i];
+        for(pin = 0; pin < 16; pin++){
+            if(port_changed[i] & (1 << pin)){
+                vcd_id(pin_signal[i][pin], id);
+                fprintf(out, "%u%s\n", (port_first[i] >> pin) & 0x1, id);
+            }
+        }
+    }
+    for(i = 0; i < BUSES; i++){
+        if(bus_seen[i]){
+            vcd_id(bus_signal[i], id);
+            fprintf(out, "0%s\n", id);
+            vcd_id(bus_signal[i] + 1, id);
+            fprintf(out, "bxxxxxxxx %s\n", id);
+            vcd_id(bus_signal[i] + 2, id);
+            fprintf(out, "bxxxxxxxx %s\n", id);
+        }
+    }
+    fprintf(out, "$end\n");
+
+    for(i = 0; i < nrecords; i++){
+        r = &records[i];
+        if((r->type == BUSTRACE_GPIO) && (r->bus < PORTS)){
+            for(pin = 0; pin < 16; pin++){
+                if((port_changed[r->bus] & (1 << pin)) && ((port_level[r->bus] ^ r->value) & (1 << pin))){
+                    vcd_stamp(out, r->time);
+                    vcd_id(pin_signal[r->bus][pin], id);
+                    fprintf(out, "%u%s\n", (r->value >> pin) & 0x1, id);
+                }
+            }
+            port_level[r->bus] = r->value;
+        }
+        else if(r->bus < BUSES){
+            vcd_stamp(out, r->time);
+            if(r->type == BUSTRACE_I2C_START){
+                vcd_id(bus_signal[r->bus], id);
+                fprintf(out, "1%s\n", id);
+            }
+            else if(r->type == BUSTRACE_I2C_STOP){
+                vcd_id(bus_signal[r->bus], id);
+                fprintf(out, "0%s\n", id);
+                continue;
+            }
+            vcd_id(bus_signal[r->bus] + ((r->type == BUSTRACE_I2C_START) ? 1 : 2), id);
+            fputc('b', out);
+            for(bit = 7; bit >= 0; bit--){
+                fputc(((r->value >> bit) & 0x1) ? '1' : '0', out);
+            }
+            fprintf(out, " %s\n", id);
+        }
+    }
+}
+
+static void print_summary(void){
+
+    uint32_t port_writes[PORTS];
+    uint32_t starts[BUSES];
+    uint32_t bytes[BUSES];
+    uint64_t busy_ns[BUSES];
+    uint64_t busy_since[BUSES];
+    uint8_t busy[BUSES];
+    uint64_t span = nrecords ? (records[nrecords - 1].time - records[0].time) : 0;
+    record_t* r = NULL;
+    uint32_t i = 0;
+
+    memset(port_writes, 0, sizeof(port_writes));
+    memset(starts, 0, sizeof(starts));
+    memset(bytes, 0, sizeof(bytes));
+    memset(busy_ns, 0, sizeof(busy_ns));
+    memset(busy, 0, sizeof(busy));
+
+    for(i = 0; i < nrecords; i++){
+        r = &records[i];
+        if((r->type == BUSTRACE_GPIO) && (r->bus < PORTS)){
+            port_writes[r->bus]++;
+        }
+        else if(r->bus < BUSES){
+            if(r->type == BUSTRACE_I2C_START){
+                starts[r->bus]++;
+                if(!busy[r->bus]){
+                    busy[r->bus] = 1;
+                    busy_since[r->bus] = r->time;
+                }
+            }
+            else if(r->type == BUSTRACE_I2C_BYTE){
+                bytes[r->bus]++;
+            }
+            else if((r->type == BUSTRACE_I2C_STOP) && busy[r->bus]){
+                busy[r->bus] = 0;
+                busy_ns[r->bus] += r->time - busy_since[r->bus];
+            }
+        }
+    }
+
+    fprintf(stderr, "span: %llu us, %u records\n", (unsigned long long)(span / 1000), nrecords);
+    for(i = 0; i < PORTS; i++){
+        if(port_writes[i]){
+            fprintf(stderr, "GPIO%c: %u writes\n", 'A' + i, port_writes[i]);
+        }
+    }
+    for(i = 0; i < BUSES; i++){
+        if(starts[i]){
+            fprintf(stderr, "I2C%u: %u starts, %u bytes, busy %llu us (%llu%%)\n", i, starts[i], bytes[i],
+                    (unsigned long long)(busy_ns[i] / 1000),
+                    (unsigned long long)(span ? ((busy_ns[i] * 100) / span) : 0));
+        }
+    }
+}
@@ -0,0 +1,228 @@
+/*****************************************************************************************************
+* FILENAME :        ds1307_emu.c
+*
+* DESCRIPTION :
+*       File containing the host DS1307 emulator.
+*
+* PUBLIC FUNCTIONS :
+*       void        ds1307_emu_reset(void)
+*       void        ds1307_emu_write(const uint8_t* buf, uint32_t len)
+*       void        ds1307_emu_read(uint8_t* buf, uint32_t len)
+*       void        ds1307_emu_advance(uint32_t seconds)
+*       uint8_t     ds1307_emu_get_reg(uint8_t addr)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+**/
+
+#include "ds1307_emu.h"
+#include "ds1307.h"
+#include <stdint.h>
+
+#define DS1307_EMU_CH           (1 << 7)    /* Clock halt, seconds register */
+#define DS1307_EMU_12H          (1 << 6)    /* 12 hours mode, hours register */
+#define DS1307_EMU_PM           (1 << 5)    /* PM in 12 hours mode, hours register */
+
+static uint8_t emu_regs[DS1307_EMU_REGS];
+static uint8_t emu_pointer = 0;
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn ds1307_emu_tick
+ *
+ * @brief function to advance the clock registers by one second.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ */
+static void ds1307_emu_tick(void);
+
+/**
+ * @fn ds1307_emu_tick_hours
+ *
+ * @brief function to advance the hours register by one hour.
+ *
+ * @param[in] void.
+ *
+ * @return 1 if the day changed, 0 otherwise.
+ */
+static uint8_t ds1307_emu_tick_hours(void);
+
+/**
+ * @fn ds1307_emu_days_in_month
+ *
+ * @brief function to get the number of days of a month.
+ *
+ * @param[in] month is the month (1 to 12).
+ * @param[in] year is the year of the century (0 to 99).
+ *
+ * @return number of days.
+ */
+static uint8_t ds1307_emu_days_in_month(uint8_t month, uint8_t year);
+
+/**
+ * @fn bin_to_bcd
+ *
+ * @brief function to convert a number in binary format to bcd format.
+ *
+ * @param[in] value is the number in binary format (0 to 99).
+ *
+ * @return value in bcd format.
+ */
+static uint8_t bin_to_bcd(uint8_t value);
+
+/**
+ * @fn bcd_to_bin
+ *
+ * @brief function to convert a number in bcd format to binary format.
+ *
+ * @param[in] value is the number in bcd format.
+ *
+ * @return value in binary format.
+ */
+static uint8_t bcd_to_bin(uint8_t value);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void ds1307_emu_reset(void){
+
+    uint8_t i = 0;
+
+    for(i = 0; i < DS1307_EMU_REGS; i++){
+        emu_regs[i] = 0;
+    }
+    emu_regs[DS1307_ADDR_SEC] = DS1307_EMU_CH;
+    emu_pointer = 0;
+}
+
+void ds1307_emu_write(const uint8_t* buf, uint32_t len){
+
+    uint32_t i = 0;
+
+    if(len == 0){
+        return;
+    }
+
+    emu_pointer = buf[0] % DS1307_EMU_REGS;
+    for(i = 1; i < len; i++){
+        emu_regs[emu_pointer] = buf[i];
+        emu_pointer = (emu_pointer + 1) % DS1307_EMU_REGS;
+    }
+}
+
+void ds1307_emu_read(uint8_t* buf, uint32_t len){
+
+    uint32_t i = 0;
+
+    for(i = 0; i < len; i++){
+        buf[i] = emu_regs[emu_pointer];
+        emu_pointer = (emu_pointer + 1) % DS1307_EMU_REGS;
+    }
+}
+
+void ds1307_emu_advance(uint32_t seconds){
+
+    while(seconds-- && !(emu_regs[DS1307_ADDR_SEC] & DS1307_EMU_CH)){
+        ds1307_emu_tick();
+    }
+}
+
+uint8_t ds1307_emu_get_reg(uint8_t addr){
+
+    return emu_regs[addr % DS1307_EMU_REGS];
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static void ds1307_emu_tick(void){
+
+    uint8_t seconds = bcd_to_bin(emu_regs[DS1307_ADDR_SEC]);
+    uint8_t minutes = bcd_to_bin(emu_regs[DS1307_ADDR_MIN]);
+    uint8_t day = bcd_to_bin(emu_regs[DS1307_ADDR_DAY]);
+    uint8_t date = bcd_to_bin(emu_regs[DS1307_ADDR_DATE]);
+    uint8_t month = bcd_to_bin(emu_regs[DS1307_ADDR_MONTH]);
+    uint8_t year = bcd_to_bin(emu_regs[DS1307_ADDR_YEAR]);
+
+    if(++seconds < 60){
+        emu_regs[DS1307_ADDR_SEC] = bin_to_bcd(seconds);
+        return;
+    }
+    emu_regs[DS1307_ADDR_SEC] = 0;
+
+    if(++minutes < 60){
+        emu_regs[DS1307_ADDR_MIN] = bin_to_bcd(minutes);
+        return;
+    }
+    emu_regs[DS1307_ADDR_MIN] = 0;
+
+    if(!ds1307_emu_tick_hours()){
+        return;
+    }
+
+    emu_regs[DS1307_ADDR_DAY] = bin_to_bcd((day >= SUNDAY) ? MONDAY : (day + 1));
+
+    if(++date > ds1307_emu_days_in_month(month, year)){
+        date = 1;
+        if(++month > 12){
+            month = 1;
+            year = (year + 1) % 100;
+        }
+    }
+    emu_regs[DS1307_ADDR_DATE] = bin_to_bcd(date);
+    emu_regs[DS1307_ADDR_MONTH] = bin_to_bcd(month);
+    emu_regs[DS1307_ADDR_YEAR] = bin_to_bcd(year);
+}
+
+static uint8_t ds1307_emu_tick_hours(void){
+
+    uint8_t reg = emu_regs[DS1307_ADDR_HRS];
+    uint8_t hours = 0;
+
+    if(!(reg & DS1307_EMU_12H)){
+        hours = bcd_to_bin(reg & 0x3F) + 1;
+        emu_regs[DS1307_ADDR_HRS] = bin_to_bcd((hours < 24) ? hours : 0);
+        return (hours >= 24);
+    }
+
+    /* 12 hours mode: 11 AM -> 12 PM -> 1 PM ... 11 PM -> 12 AM, the day changes at 12 AM */
+    hours = bcd_to_bin(reg & 0x1F) + 1;
+    if(hours == 13){
+        hours = 1;
+    }
+    if(hours == 12){
+        reg ^= DS1307_EMU_PM;
+    }
+    emu_regs[DS1307_ADDR_HRS] = (reg & (DS1307_EMU_12H | DS1307_EMU_PM)) | bin_to_bcd(hours);
+
+    return ((hours == 12) && !(reg & DS1307_EMU_PM));
+}
+
+static uint8_t ds1307_emu_days_in_month(uint8_t month, uint8_t year){
+
+    static const uint8_t days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+    if((month == 2) && ((year % 4) == 0)){
+        return 29;
+    }
+
+    return ((month >= 1) && (month <= 12)) ? days[month - 1] : 31;
+}
+
+static uint8_t bin_to_bcd(uint8_t value){
+
+    return (uint8_t)(((value / 10) << 4) | (value % 10));
+}
+
+static uint8_t bcd_to_bin(uint8_t value){
+
+    return (uint8_t)(((value >> 4) * 10) + (value & 0x0F));
+}
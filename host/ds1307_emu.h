@@ -0,0 +1,96 @@
+/*****************************************************************************************************
+* FILENAME :        ds1307_emu.h
+*
+* DESCRIPTION :
+*       Header file containing the prototypes of the APIs for the host DS1307 emulator.
+*
+* PUBLIC FUNCTIONS :
+*       void        ds1307_emu_reset(void)
+*       void        ds1307_emu_write(const uint8_t* buf, uint32_t len)
+*       void        ds1307_emu_read(uint8_t* buf, uint32_t len)
+*       void        ds1307_emu_advance(uint32_t seconds)
+*       uint8_t     ds1307_emu_get_reg(uint8_t addr)
+*
+* NOTES :
+*       The emulator models the 64 registers of the DS1307 (clock registers, control and NV RAM)
+*       and the register pointer, which is set by the first byte of a write and incremented after
+*       every byte read or written, wrapping from 0x3F to 0x00. The time only runs while the CH bit
+*       (bit 7 of the seconds register) is clear, in BCD, in 12 or 24 hours mode, with the leap years
+*       of 2000 to 2099.
+*
+**/
+
+#ifndef DS1307_EMU_H
+#define DS1307_EMU_H
+
+#include <stdint.h>
+
+/**
+ * Size of the register map (clock registers, control register and 56 bytes of NV RAM).
+ */
+#define DS1307_EMU_REGS         64
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn ds1307_emu_reset
+ *
+ * @brief function to reset the emulated device to its first power-on state: every register cleared
+ *        and the oscillator halted (CH bit set).
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+void ds1307_emu_reset(void);
+
+/**
+ * @fn ds1307_emu_write
+ *
+ * @brief function to emulate an I2C write transaction addressed to the device.
+ *
+ * @param[in] buf is the data sent, the first byte is the register pointer.
+ * @param[in] len is the number of bytes sent.
+ *
+ * @return void
+ */
+void ds1307_emu_write(const uint8_t* buf, uint32_t len);
+
+/**
+ * @fn ds1307_emu_read
+ *
+ * @brief function to emulate an I2C read transaction addressed to the device, from the register
+ *        pointer.
+ *
+ * @param[out] buf is the buffer to store the data read.
+ * @param[in] len is the number of bytes to read.
+ *
+ * @return void
+ */
+void ds1307_emu_read(uint8_t* buf, uint32_t len);
+
+/**
+ * @fn ds1307_emu_advance
+ *
+ * @brief function to advance the emulated clock, nothing happens while the oscillator is halted.
+ *
+ * @param[in] seconds is the number of seconds to advance.
+ *
+ * @return void
+ */
+void ds1307_emu_advance(uint32_t seconds);
+
+/**
+ * @fn ds1307_emu_get_reg
+ *
+ * @brief function to get a register without moving the register pointer.
+ *
+ * @param[in] addr is the register address (0x00 to 0x3F).
+ *
+ * @return register value.
+ */
+uint8_t ds1307_emu_get_reg(uint8_t addr);
+
+#endif /* DS1307_EMU_H */
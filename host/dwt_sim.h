@@ -0,0 +1,26 @@
+/*****************************************************************************************************
+* FILENAME :        dwt_sim.h
+*
+* DESCRIPTION :
+*       Header file containing the host stand-in for the DWT cycle counter.
+*
+* NOTES :
+*       The host build defines GPIO_SIM, so stm32f446xx.h includes this file and DWT_CYCCNT reads
+*       dwt_sim_cyccnt, defined once in gpio_sim.c. The counter is not advanced and stays at 0, so the
+*       cycle counts measured on the host are 0.
+*
+**/
+
+#ifndef DWT_SIM_H
+#define DWT_SIM_H
+
+#include <stdint.h>
+
+/**
+ * Host cycle counter (gpio_sim.c).
+ */
+extern volatile uint32_t dwt_sim_cyccnt;
+
+#define DWT_CYCCNT      (&dwt_sim_cyccnt)
+
+#endif /* DWT_SIM_H */
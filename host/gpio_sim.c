@@ -0,0 +1,260 @@
+/*****************************************************************************************************
+* FILENAME :        gpio_sim.c
+*
+* DESCRIPTION :
+*       File containing the host stand-in for the GPIO driver.
+*
+* PUBLIC FUNCTIONS :
+*       void        gpio_sim_reset(void)
+*       uint64_t    gpio_sim_now(void)
+*       void        gpio_sim_advance(uint64_t ns)
+*       void        gpio_sim_set_write_cost(uint32_t ns)
+*       uint16_t    gpio_sim_get_port(GPIO_RegDef_t* pGPIOx)
+*       uint32_t    gpio_sim_get_writes(void)
+*       void        gpio_sim_write_bsrr(GPIO_RegDef_t* pGPIOx, uint32_t value)
+*       uint32_t    gpio_sim_read_odr(GPIO_RegDef_t* pGPIOx)
+*       uint32_t    gpio_sim_read_idr(GPIO_RegDef_t* pGPIOx)
+*
+*       The APIs of gpio_driver.h, bustrace_now of bustrace.h and the cycle counter of dwt_sim.h.
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+**/
+
+#include "gpio_sim.h"
+#include "gpio_driver.h"
+#include "hd44780.h"
+#include "hd44780_emu.h"
+#include "bustrace.h"
+#include "dwt_sim.h"
+#include <stdint.h>
+
+#define GPIO_SIM_PORTS      8
+
+static uint16_t port_odr[GPIO_SIM_PORTS];
+static uint16_t port_idr[GPIO_SIM_PORTS];
+static uint32_t port_moder[GPIO_SIM_PORTS];
+static uint64_t sim_time_ns = 0;
+static uint32_t sim_write_cost_ns = GPIO_SIM_WRITE_COST_NS;
+static uint32_t sim_writes = 0;
+
+volatile uint32_t dwt_sim_cyccnt = 0;
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn gpio_sim_port_changed
+ *
+ * @brief function to forward the new level of a port to the attached device models.
+ *
+ * @param[in] code is the port code, as returned by GPIO_BASEADDR_TO_CODE.
+ *
+ * @return void.
+ */
+static void gpio_sim_port_changed(uint8_t code);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void gpio_sim_reset(void){
+
+    uint8_t i = 0;
+
+    for(i = 0; i < GPIO_SIM_PORTS; i++){
+        port_odr[i] = 0;
+        port_idr[i] = 0;
+        port_moder[i] = 0;
+    }
+
+    sim_time_ns = 0;
+    sim_writes = 0;
+
+    hd44780_emu_reset();
+}
+
+uint64_t gpio_sim_now(void){
+
+    return sim_time_ns;
+}
+
+void gpio_sim_advance(uint64_t ns){
+
+    sim_time_ns += ns;
+}
+
+void gpio_sim_set_write_cost(uint32_t ns){
+
+    sim_write_cost_ns = ns;
+}
+
+uint16_t gpio_sim_get_port(GPIO_RegDef_t* pGPIOx){
+
+    return port_odr[GPIO_BASEADDR_TO_CODE(pGPIOx)];
+}
+
+uint32_t gpio_sim_get_writes(void){
+
+    return sim_writes;
+}
+
+void gpio_sim_write_bsrr(GPIO_RegDef_t* pGPIOx, uint32_t value){
+
+    uint8_t code = GPIO_BASEADDR_TO_CODE(pGPIOx);
+
+    sim_time_ns += GPIO_SIM_BSRR_COST_NS;
+    sim_writes++;
+
+    /* Reset first, so a pin both set and reset ends set as in the hardware */
+    port_odr[code] &= (uint16_t)~(value >> 16);
+    port_odr[code] |= (uint16_t)(value & 0xFFFF);
+
+    gpio_sim_port_changed(code);
+}
+
+uint32_t gpio_sim_read_odr(GPIO_RegDef_t* pGPIOx){
+
+    sim_time_ns += GPIO_SIM_BSRR_COST_NS;
+
+    return port_odr[GPIO_BASEADDR_TO_CODE(pGPIOx)];
+}
+
+uint32_t gpio_sim_read_idr(GPIO_RegDef_t* pGPIOx){
+
+    sim_time_ns += GPIO_SIM_BSRR_COST_NS;
+
+    return port_idr[GPIO_BASEADDR_TO_CODE(pGPIOx)];
+}
+
+uint32_t bustrace_now(void){
+
+    /* Bus trace timestamps in simulated nanoseconds, bustrace_init(1000000000) */
+    return (uint32_t)sim_time_ns;
+}
+
+void GPIO_Init(GPIO_Handle_t* pGPIOHandle){
+
+    uint8_t code = GPIO_BASEADDR_TO_CODE(pGPIOHandle->pGPIOx);
+    uint8_t pin = pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber;
+
+    sim_time_ns += sim_write_cost_ns;
+
+    port_moder[code] &= ~(0x3U << (2 * pin));
+    port_moder[code] |= (uint32_t)(pGPIOHandle->GPIO_PinConfig.GPIO_PinMode & 0x3) << (2 * pin);
+}
+
+void GPIO_DeInit(GPIO_RegDef_t* pGPIOx){
+
+    uint8_t code = GPIO_BASEADDR_TO_CODE(pGPIOx);
+
+    port_odr[code] = 0;
+    port_moder[code] = 0;
+    gpio_sim_port_changed(code);
+}
+
+void GPIO_PerClkCtrl(GPIO_RegDef_t* pGPIOx, uint8_t en_or_di){
+
+    (void)pGPIOx;
+    (void)en_or_di;
+}
+
+uint8_t GPIO_ReadFromInputPin(GPIO_RegDef_t* pGPIOx, uint8_t pin_number){
+
+    sim_time_ns += sim_write_cost_ns;
+
+    return (uint8_t)((port_idr[GPIO_BASEADDR_TO_CODE(pGPIOx)] >> pin_number) & 0x1);
+}
+
+uint16_t GPIO_ReadFromInputPort(GPIO_RegDef_t* pGPIOx){
+
+    sim_time_ns += sim_write_cost_ns;
+
+    return port_idr[GPIO_BASEADDR_TO_CODE(pGPIOx)];
+}
+
+void GPIO_WriteToOutputPin(GPIO_RegDef_t* pGPIOx, uint8_t pin_number, uint8_t value){
+
+    uint8_t code = GPIO_BASEADDR_TO_CODE(pGPIOx);
+
+    sim_time_ns += sim_write_cost_ns;
+    sim_writes++;
+
+    if(value == GPIO_PIN_SET){
+        port_odr[code] |= (uint16_t)(1 << pin_number);
+    }
+    else{
+        port_odr[code] &= (uint16_t)~(1 << pin_number);
+    }
+
+    gpio_sim_port_changed(code);
+}
+
+void GPIO_WriteToOutputPort(GPIO_RegDef_t* pGPIOx, uint16_t value){
+
+    uint8_t code = GPIO_BASEADDR_TO_CODE(pGPIOx);
+
+    sim_time_ns += sim_write_cost_ns;
+    sim_writes++;
+
+    port_odr[code] = value;
+
+    gpio_sim_port_changed(code);
+}
+
+void GPIO_ToggleOutputPin(GPIO_RegDef_t* pGPIOx, uint8_t pin_number){
+
+    uint8_t code = GPIO_BASEADDR_TO_CODE(pGPIOx);
+
+    sim_time_ns += sim_write_cost_ns;
+    sim_writes++;
+
+    port_odr[code] ^= (uint16_t)(1 << pin_number);
+
+    gpio_sim_port_changed(code);
+}
+
+void GPIO_IRQConfig(uint8_t IRQNumber, uint8_t en_or_di){
+
+    (void)IRQNumber;
+    (void)en_or_di;
+}
+
+void GPIO_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority){
+
+    (void)IRQNumber;
+    (void)IRQPriority;
+}
+
+void GPIO_IRQHandling(uint8_t pin_number){
+
+    (void)pin_number;
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static void gpio_sim_port_changed(uint8_t code){
+
+    uint16_t odr = port_odr[code];
+    uint8_t pins = 0;
+
+    BUSTRACE(BUSTRACE_GPIO, code, odr);
+
+    if(code != GPIO_BASEADDR_TO_CODE(HD44780_GPIO_PORT)){
+        return;
+    }
+
+    pins |= ((odr >> HD44780_GPIO_RS) & 0x1) ? HD44780_EMU_RS : 0;
+    pins |= ((odr >> HD44780_GPIO_RW) & 0x1) ? HD44780_EMU_RW : 0;
+    pins |= ((odr >> HD44780_GPIO_EN) & 0x1) ? HD44780_EMU_EN : 0;
+    pins |= ((odr >> HD44780_GPIO_D4) & 0x1) ? HD44780_EMU_D4 : 0;
+    pins |= ((odr >> HD44780_GPIO_D5) & 0x1) ? HD44780_EMU_D5 : 0;
+    pins |= ((odr >> HD44780_GPIO_D6) & 0x1) ? HD44780_EMU_D6 : 0;
+    pins |= ((odr >> HD44780_GPIO_D7) & 0x1) ? HD44780_EMU_D7 : 0;
+
+    hd44780_emu_set_pins(sim_time_ns, pins);
+}
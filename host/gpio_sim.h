@@ -0,0 +1,150 @@
+/*****************************************************************************************************
+* FILENAME :        gpio_sim.h
+*
+* DESCRIPTION :
+*       Header file containing the prototypes of the host stand-in for the GPIO driver.
+*
+* PUBLIC FUNCTIONS :
+*       void        gpio_sim_reset(void)
+*       uint64_t    gpio_sim_now(void)
+*       void        gpio_sim_advance(uint64_t ns)
+*       void        gpio_sim_set_write_cost(uint32_t ns)
+*       uint16_t    gpio_sim_get_port(GPIO_RegDef_t* pGPIOx)
+*       uint32_t    gpio_sim_get_writes(void)
+*       void        gpio_sim_write_bsrr(GPIO_RegDef_t* pGPIOx, uint32_t value)
+*       uint32_t    gpio_sim_read_odr(GPIO_RegDef_t* pGPIOx)
+*       uint32_t    gpio_sim_read_idr(GPIO_RegDef_t* pGPIOx)
+*
+* NOTES :
+*       gpio_sim.c implements the APIs of gpio_driver.h on Linux. Output pins are kept in a per port
+*       shadow register and every call advances a simulated clock. The host build defines GPIO_SIM, so
+*       the inline fast path of gpio_driver.h goes through gpio_sim_write_bsrr and gpio_sim_read_*.
+*       The HD44780 pins configured in hd44780.h are forwarded to the HD44780 emulator
+*       (hd44780_emu.h).
+*
+*       Every output write is recorded in the bus trace (bustrace.h), timestamped with the simulated
+*       clock in nanoseconds (bustrace_now).
+*
+**/
+
+#ifndef GPIO_SIM_H
+#define GPIO_SIM_H
+
+#include <stdint.h>
+#include "stm32f446xx.h"
+
+/**
+ * Default simulated cost of a GPIO driver call, a library call at 16MHz and -O0.
+ */
+#define GPIO_SIM_WRITE_COST_NS      2000
+
+/**
+ * Simulated cost of an inline fast path access, one store to BSRR at 180MHz.
+ */
+#define GPIO_SIM_BSRR_COST_NS       20
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn gpio_sim_reset
+ *
+ * @brief function to reset the simulated ports, the simulated clock and the HD44780 emulator.
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+void gpio_sim_reset(void);
+
+/**
+ * @fn gpio_sim_now
+ *
+ * @brief function to get the simulated time.
+ *
+ * @param[in] void
+ *
+ * @return simulated time in nanoseconds.
+ */
+uint64_t gpio_sim_now(void);
+
+/**
+ * @fn gpio_sim_advance
+ *
+ * @brief function to advance the simulated time.
+ *
+ * @param[in] ns is the number of nanoseconds to advance.
+ *
+ * @return void
+ */
+void gpio_sim_advance(uint64_t ns);
+
+/**
+ * @fn gpio_sim_set_write_cost
+ *
+ * @brief function to set the simulated cost of each GPIO driver call.
+ *
+ * @param[in] ns is the cost in nanoseconds.
+ *
+ * @return void
+ */
+void gpio_sim_set_write_cost(uint32_t ns);
+
+/**
+ * @fn gpio_sim_get_port
+ *
+ * @brief function to get the output level of all pins of a simulated port.
+ *
+ * @param[in] pGPIOx the base address of the GPIOx peripheral port.
+ *
+ * @return output data register of the port.
+ */
+uint16_t gpio_sim_get_port(GPIO_RegDef_t* pGPIOx);
+
+/**
+ * @fn gpio_sim_get_writes
+ *
+ * @brief function to get the number of output writes since the last reset.
+ *
+ * @param[in] void
+ *
+ * @return number of output writes.
+ */
+uint32_t gpio_sim_get_writes(void);
+
+/**
+ * @fn gpio_sim_write_bsrr
+ *
+ * @brief function to simulate a store to the BSRR register of a port.
+ *
+ * @param[in] pGPIOx the base address of the GPIOx peripheral port.
+ * @param[in] value bits 0 to 15 set pins, bits 16 to 31 reset pins (set wins).
+ *
+ * @return void
+ */
+void gpio_sim_write_bsrr(GPIO_RegDef_t* pGPIOx, uint32_t value);
+
+/**
+ * @fn gpio_sim_read_odr
+ *
+ * @brief function to simulate a read of the ODR register of a port.
+ *
+ * @param[in] pGPIOx the base address of the GPIOx peripheral port.
+ *
+ * @return output data register of the port.
+ */
+uint32_t gpio_sim_read_odr(GPIO_RegDef_t* pGPIOx);
+
+/**
+ * @fn gpio_sim_read_idr
+ *
+ * @brief function to simulate a read of the IDR register of a port.
+ *
+ * @param[in] pGPIOx the base address of the GPIOx peripheral port.
+ *
+ * @return input data register of the port.
+ */
+uint32_t gpio_sim_read_idr(GPIO_RegDef_t* pGPIOx);
+
+#endif /* GPIO_SIM_H */
@@ -0,0 +1,388 @@
+/*****************************************************************************************************
+* FILENAME :        hd44780_emu.c
+*
+* DESCRIPTION :
+*       File containing the host HD44780 controller emulator.
+*
+* PUBLIC FUNCTIONS :
+*       void        hd44780_emu_reset(void)
+*       void        hd44780_emu_set_pins(uint64_t t_ns, uint8_t pins)
+*       void        hd44780_emu_frame_begin(uint64_t t_ns)
+*       void        hd44780_emu_frame_end(uint64_t t_ns, hd44780_emu_stats_t* stats)
+*       void        hd44780_emu_get_line(uint8_t row, char* buf)
+*       uint32_t    hd44780_emu_violations(void)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+**/
+
+#include "hd44780_emu.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define DATA_MASK       (HD44780_EMU_D4 | HD44780_EMU_D5 | HD44780_EMU_D6 | HD44780_EMU_D7)
+
+/**
+ * Structure for storing the emulated controller state.
+ */
+typedef struct
+{
+    uint8_t ddram[2][HD44780_EMU_LINE_LEN];
+    uint8_t cgram[64];
+    uint8_t ac;                 /* Address counter (DDRAM address or CGRAM address) */
+    uint8_t ac_cgram;           /* 1 if the address counter points to CGRAM */
+    uint8_t increment;          /* Entry mode I/D */
+    uint8_t shift_on_write;     /* Entry mode S */
+    uint8_t shift;              /* First DDRAM column shown in the display */
+    uint8_t display_on;
+    uint8_t cursor_on;
+    uint8_t blink_on;
+    uint8_t four_bit;           /* Interface data length, 1 after function set with DL = 0 */
+    uint8_t two_lines;          /* Only the 2 line addressing (0x00-0x27, 0x40-0x67) is modelled */
+    uint8_t high_nibble;        /* Upper nibble of the current 4 bit transfer */
+    uint8_t nibble_phase;       /* 0 waiting for upper nibble, 1 waiting for lower nibble */
+    uint8_t init_sets;          /* Function sets received in 8 bit mode */
+    uint8_t pins;               /* Current level of the signals */
+    uint64_t busy_until;        /* Time at which the last instruction ends */
+    uint64_t en_rise;           /* Time of the last rising edge of EN */
+    uint64_t addr_change;       /* Time of the last change of RS or RW */
+    uint32_t violations;
+    hd44780_emu_stats_t frame;  /* Statistics of the current frame */
+    uint64_t frame_start;
+}hd44780_emu_t;
+
+static hd44780_emu_t emu;
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn emu_violation
+ *
+ * @brief function to report a timing violation.
+ *
+ * @param[in] t_ns is the simulated time of the violation.
+ * @param[in] msg is the description of the violation.
+ *
+ * @return void.
+ */
+static void emu_violation(uint64_t t_ns, const char* msg);
+
+/**
+ * @fn emu_latch
+ *
+ * @brief function to process a falling edge of EN.
+ *
+ * @param[in] t_ns is the simulated time of the edge.
+ *
+ * @return void.
+ */
+static void emu_latch(uint64_t t_ns);
+
+/**
+ * @fn emu_execute
+ *
+ * @brief function to execute an instruction or a data write.
+ *
+ * @param[in] t_ns is the simulated time of the transfer.
+ * @param[in] rs is the register select (0 instruction, 1 data).
+ * @param[in] value is the transferred byte.
+ *
+ * @return busy time of the operation in nanoseconds.
+ */
+static uint64_t emu_execute(uint64_t t_ns, uint8_t rs, uint8_t value);
+
+/**
+ * @fn emu_move_ac
+ *
+ * @brief function to increment or decrement the address counter.
+ *
+ * @param[in] increment is 1 for incrementing and 0 for decrementing.
+ *
+ * @return void.
+ */
+static void emu_move_ac(uint8_t increment);
+
+/**
+ * @fn emu_shift_display
+ *
+ * @brief function to shift the display window.
+ *
+ * @param[in] left is 1 for shifting the display to the left and 0 to the right.
+ *
+ * @return void.
+ */
+static void emu_shift_display(uint8_t left);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void hd44780_emu_reset(void){
+
+    memset(&emu, 0, sizeof(emu));
+
+    /* Internal reset: display off, increment, 8 bit interface, DDRAM filled with spaces */
+    memset(emu.ddram, ' ', sizeof(emu.ddram));
+    emu.increment = 1;
+    emu.busy_until = HD44780_EMU_T_POWER_ON;
+}
+
+void hd44780_emu_set_pins(uint64_t t_ns, uint8_t pins){
+
+    uint8_t changed = emu.pins ^ pins;
+
+    if(changed == 0){
+        return;
+    }
+
+    emu.frame.pin_changes++;
+
+    /* RS and RW must be stable while EN is high */
+    if((emu.pins & HD44780_EMU_EN) && (pins & HD44780_EMU_EN) &&
+       (changed & (HD44780_EMU_RS | HD44780_EMU_RW))){
+        emu_violation(t_ns, "RS/RW changed while EN is high");
+    }
+
+    if(changed & (HD44780_EMU_RS | HD44780_EMU_RW)){
+        emu.addr_change = t_ns;
+    }
+
+    if((changed & HD44780_EMU_EN) && (pins & HD44780_EMU_EN)){
+        /* Rising edge */
+        if((emu.en_rise != 0) && ((t_ns - emu.en_rise) < HD44780_EMU_T_CYCE)){
+            emu_violation(t_ns, "enable cycle time shorter than tcycE");
+        }
+        if((t_ns - emu.addr_change) < HD44780_EMU_T_AS){
+            emu_violation(t_ns, "RS/RW set up less than tAS before the rising edge of EN");
+        }
+        emu.en_rise = t_ns;
+    }
+
+    if((changed & HD44780_EMU_EN) && !(pins & HD44780_EMU_EN)){
+        /* Falling edge, data is latched with the levels before the edge */
+        if((t_ns - emu.en_rise) < HD44780_EMU_PW_EH){
+            emu_violation(t_ns, "enable pulse shorter than PWEH");
+        }
+        if(changed & DATA_MASK){
+            emu_violation(t_ns, "data changed together with the falling edge of EN");
+        }
+        emu_latch(t_ns);
+    }
+
+    emu.pins = pins;
+}
+
+void hd44780_emu_frame_begin(uint64_t t_ns){
+
+    memset(&emu.frame, 0, sizeof(emu.frame));
+    emu.frame_start = t_ns;
+}
+
+void hd44780_emu_frame_end(uint64_t t_ns, hd44780_emu_stats_t* stats){
+
+    emu.frame.elapsed_ns = t_ns - emu.frame_start;
+
+    if(stats){
+        *stats = emu.frame;
+    }
+}
+
+void hd44780_emu_get_line(uint8_t row, char* buf){
+
+    uint8_t i = 0;
+    uint8_t c = 0;
+
+    for(i = 0; i < HD44780_EMU_COLUMNS; i++){
+        c = emu.ddram[(row - 1) & 0x1][(emu.shift + i) % HD44780_EMU_LINE_LEN];
+        buf[i] = ((c >= 0x20) && (c < 0x7F)) ? (char)c : '.';
+    }
+    buf[HD44780_EMU_COLUMNS] = '\0';
+}
+
+uint32_t hd44780_emu_violations(void){
+
+    return emu.violations;
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static void emu_violation(uint64_t t_ns, const char* msg){
+
+    emu.violations++;
+    emu.frame.violations++;
+
+    fprintf(stderr, "hd44780_emu: t=%llu.%03llu us: %s\n",
+            (unsigned long long)(t_ns / 1000), (unsigned long long)(t_ns % 1000), msg);
+}
+
+static void emu_latch(uint64_t t_ns){
+
+    uint8_t rs = (emu.pins & HD44780_EMU_RS) ? 1 : 0;
+    uint8_t nibble = (emu.pins & DATA_MASK) >> 4;
+    uint8_t value = 0;
+    char msg[96];
+
+    emu.frame.en_pulses++;
+
+    if(emu.pins & HD44780_EMU_RW){
+        /* Reads are not used by the driver, nothing to latch */
+        return;
+    }
+
+    if(emu.four_bit && (emu.nibble_phase == 0)){
+        /* Start of a transfer, the previous instruction must be finished */
+        if(t_ns < emu.busy_until){
+            snprintf(msg, sizeof(msg), "transfer started %llu ns before the controller is ready",
+                     (unsigned long long)(emu.busy_until - t_ns));
+            emu_violation(t_ns, msg);
+        }
+        emu.high_nibble = nibble;
+        emu.nibble_phase = 1;
+        return;
+    }
+
+    if(emu.four_bit){
+        value = (uint8_t)((emu.high_nibble << 4) | nibble);
+        emu.nibble_phase = 0;
+    }
+    else{
+        /* 8 bit interface, D0 to D3 are not connected and read as 0 */
+        if(t_ns < emu.busy_until){
+            snprintf(msg, sizeof(msg), "instruction issued %llu ns before the controller is ready",
+                     (unsigned long long)(emu.busy_until - t_ns));
+            emu_violation(t_ns, msg);
+        }
+        value = (uint8_t)(nibble << 4);
+    }
+
+    emu.busy_until = t_ns + emu_execute(t_ns, rs, value);
+}
+
+static uint64_t emu_execute(uint64_t t_ns, uint8_t rs, uint8_t value){
+
+    (void)t_ns;
+
+    if(rs){
+        /* Data write */
+        emu.frame.data_writes++;
+        if(emu.ac_cgram){
+            emu.cgram[emu.ac & 0x3F] = value & 0x1F;
+        }
+        else{
+            emu.ddram[(emu.ac & 0x40) ? 1 : 0][emu.ac & 0x3F] = value;
+        }
+        emu_move_ac(emu.increment);
+        if(emu.shift_on_write && !emu.ac_cgram){
+            emu_shift_display(emu.increment);
+        }
+        return HD44780_EMU_T_WRITE;
+    }
+
+    emu.frame.commands++;
+
+    if(value & 0x80){
+        /* Set DDRAM address */
+        emu.ac = value & 0x7F;
+        if((emu.ac & 0x3F) >= HD44780_EMU_LINE_LEN){
+            emu.ac &= 0x40;
+        }
+        emu.ac_cgram = 0;
+    }
+    else if(value & 0x40){
+        /* Set CGRAM address */
+        emu.ac = value & 0x3F;
+        emu.ac_cgram = 1;
+    }
+    else if(value & 0x20){
+        /* Function set */
+        uint8_t eight_bit = !emu.four_bit;
+        emu.four_bit = (value & 0x10) ? 0 : 1;
+        emu.two_lines = (value & 0x08) ? 1 : 0;
+        if(eight_bit){
+            /* Initialization by instruction: first two function sets need longer waits */
+            emu.init_sets++;
+            if(emu.init_sets == 1){
+                return HD44780_EMU_T_INIT_1;
+            }
+            if(emu.init_sets == 2){
+                return HD44780_EMU_T_INIT_2;
+            }
+        }
+    }
+    else if(value & 0x10){
+        /* Cursor or display shift */
+        if(value & 0x08){
+            emu_shift_display((value & 0x04) ? 0 : 1);
+        }
+        else{
+            emu_move_ac((value & 0x04) ? 1 : 0);
+        }
+    }
+    else if(value & 0x08){
+        /* Display on/off control */
+        emu.display_on = (value & 0x04) ? 1 : 0;
+        emu.cursor_on = (value & 0x02) ? 1 : 0;
+        emu.blink_on = (value & 0x01) ? 1 : 0;
+    }
+    else if(value & 0x04){
+        /* Entry mode set */
+        emu.increment = (value & 0x02) ? 1 : 0;
+        emu.shift_on_write = (value & 0x01) ? 1 : 0;
+    }
+    else if(value & 0x02){
+        /* Return home */
+        emu.ac = 0;
+        emu.ac_cgram = 0;
+        emu.shift = 0;
+        return HD44780_EMU_T_HOME;
+    }
+    else if(value & 0x01){
+        /* Clear display */
+        memset(emu.ddram, ' ', sizeof(emu.ddram));
+        emu.ac = 0;
+        emu.ac_cgram = 0;
+        emu.shift = 0;
+        emu.increment = 1;
+        return HD44780_EMU_T_HOME;
+    }
+
+    return HD44780_EMU_T_EXEC;
+}
+
+static void emu_move_ac(uint8_t increment){
+
+    uint8_t line = emu.ac & 0x40;
+    uint8_t column = emu.ac & 0x3F;
+
+    if(emu.ac_cgram){
+        emu.ac = (uint8_t)((emu.ac + (increment ? 1 : 63)) & 0x3F);
+        return;
+    }
+
+    if(increment){
+        if(++column >= HD44780_EMU_LINE_LEN){
+            /* End of line 1 goes to line 2 and end of line 2 to line 1 */
+            column = 0;
+            line ^= 0x40;
+        }
+    }
+    else{
+        if(column-- == 0){
+            column = HD44780_EMU_LINE_LEN - 1;
+            line ^= 0x40;
+        }
+    }
+
+    emu.ac = line | column;
+}
+
+static void emu_shift_display(uint8_t left){
+
+    emu.shift = (uint8_t)((emu.shift + (left ? 1 : HD44780_EMU_LINE_LEN - 1)) % HD44780_EMU_LINE_LEN);
+}
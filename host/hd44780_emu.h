@@ -0,0 +1,144 @@
+/*****************************************************************************************************
+* FILENAME :        hd44780_emu.h
+*
+* DESCRIPTION :
+*       Header file containing the prototypes of the APIs for the host HD44780 controller emulator.
+*
+* PUBLIC FUNCTIONS :
+*       void        hd44780_emu_reset(void)
+*       void        hd44780_emu_set_pins(uint64_t t_ns, uint8_t pins)
+*       void        hd44780_emu_frame_begin(uint64_t t_ns)
+*       void        hd44780_emu_frame_end(uint64_t t_ns, hd44780_emu_stats_t* stats)
+*       void        hd44780_emu_get_line(uint8_t row, char* buf)
+*       uint32_t    hd44780_emu_violations(void)
+*
+* NOTES :
+*       The emulator decodes the RS/RW/EN/D4-D7 signals into the HD44780 instruction set. It models
+*       DDRAM, CGRAM, the address counter, the entry mode and the display shift, and it reports any
+*       transfer started before the busy time of the previous instruction has elapsed.
+*
+**/
+
+#ifndef HD44780_EMU_H
+#define HD44780_EMU_H
+
+#include <stdint.h>
+
+/**
+ * @HD44780_EMU_PIN
+ * Bit of each HD44780 signal in the pins argument of hd44780_emu_set_pins().
+ */
+#define HD44780_EMU_RS          (1 << 0)
+#define HD44780_EMU_RW          (1 << 1)
+#define HD44780_EMU_EN          (1 << 2)
+#define HD44780_EMU_D4          (1 << 4)
+#define HD44780_EMU_D5          (1 << 5)
+#define HD44780_EMU_D6          (1 << 6)
+#define HD44780_EMU_D7          (1 << 7)
+
+/**
+ * HD44780 timing (nanoseconds), 5V supply.
+ */
+#define HD44780_EMU_T_POWER_ON      15000000ULL /* Wait after VCC rises before the first instruction */
+#define HD44780_EMU_T_INIT_1        4100000ULL  /* Busy time of the first function set (8 bit mode) */
+#define HD44780_EMU_T_INIT_2        100000ULL   /* Busy time of the second function set (8 bit mode) */
+#define HD44780_EMU_T_EXEC          37000ULL    /* Busy time of most instructions */
+#define HD44780_EMU_T_WRITE         43000ULL    /* Busy time of a data write (37us + tADD) */
+#define HD44780_EMU_T_HOME          1520000ULL  /* Busy time of clear display and return home */
+#define HD44780_EMU_PW_EH           450ULL      /* Minimum enable pulse width */
+#define HD44780_EMU_T_CYCE          1000ULL     /* Minimum enable cycle time */
+#define HD44780_EMU_T_AS            40ULL       /* Minimum RS/RW setup time before EN rises */
+
+/**
+ * Geometry of the emulated 16x2 display.
+ */
+#define HD44780_EMU_COLUMNS     16
+#define HD44780_EMU_LINE_LEN    40
+
+/**
+ * Structure for storing bus statistics of a frame.
+ */
+typedef struct
+{
+    uint64_t elapsed_ns;        /* Simulated time between frame begin and frame end */
+    uint32_t pin_changes;       /* Number of changes of the HD44780 signals */
+    uint32_t en_pulses;         /* Number of nibbles latched */
+    uint32_t commands;          /* Number of instructions executed */
+    uint32_t data_writes;       /* Number of DDRAM / CGRAM writes */
+    uint32_t violations;        /* Number of timing violations */
+}hd44780_emu_stats_t;
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn hd44780_emu_reset
+ *
+ * @brief function to reset the emulated controller to its power-on state at time 0.
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+void hd44780_emu_reset(void);
+
+/**
+ * @fn hd44780_emu_set_pins
+ *
+ * @brief function to update the level of the HD44780 signals.
+ *
+ * @param[in] t_ns is the simulated time of the change in nanoseconds.
+ * @param[in] pins is the level of every signal, bit mask of @HD44780_EMU_PIN.
+ *
+ * @return void
+ */
+void hd44780_emu_set_pins(uint64_t t_ns, uint8_t pins);
+
+/**
+ * @fn hd44780_emu_frame_begin
+ *
+ * @brief function to start collecting the statistics of a frame.
+ *
+ * @param[in] t_ns is the simulated time in nanoseconds.
+ *
+ * @return void
+ */
+void hd44780_emu_frame_begin(uint64_t t_ns);
+
+/**
+ * @fn hd44780_emu_frame_end
+ *
+ * @brief function to stop collecting the statistics of a frame.
+ *
+ * @param[in] t_ns is the simulated time in nanoseconds.
+ * @param[out] stats structure for storing the statistics of the frame.
+ *
+ * @return void
+ */
+void hd44780_emu_frame_end(uint64_t t_ns, hd44780_emu_stats_t* stats);
+
+/**
+ * @fn hd44780_emu_get_line
+ *
+ * @brief function to get the visible characters of a display line.
+ *
+ * @param[in] row to indicate the number of row (1 to 2).
+ * @param[out] buf buffer of HD44780_EMU_COLUMNS + 1 characters, non printable codes are shown as '.'.
+ *
+ * @return void
+ */
+void hd44780_emu_get_line(uint8_t row, char* buf);
+
+/**
+ * @fn hd44780_emu_violations
+ *
+ * @brief function to get the number of timing violations since the last reset.
+ *
+ * @param[in] void
+ *
+ * @return number of timing violations.
+ */
+uint32_t hd44780_emu_violations(void);
+
+#endif /* HD44780_EMU_H */
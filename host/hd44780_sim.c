@@ -0,0 +1,197 @@
+/*****************************************************************************************************
+* FILENAME :        hd44780_sim.c
+*
+* DESCRIPTION :
+*       File containing the main function of the host HD44780 simulation. It runs bsp/hd44780.c with
+*       the GPIO transport against the GPIO stand-in and the HD44780 emulator, renders clock frames
+*       like src/main.c and reports the simulated bus time of every frame. Built with
+*       HD44780_TRANSPORT = HD44780_TRANSPORT_SPI_595 it runs the SPI transport against
+*       host/hd44780_spi_sim.c instead, and -g and -l have no effect.
+*
+* NOTES :
+*       Usage: hd44780_sim [-n frames] [-g gpio_ns] [-l loop_ns] [-q]
+*           -n  number of frames to render (default 3).
+*           -g  simulated cost of a GPIO driver call in ns (default GPIO_SIM_WRITE_COST_NS).
+*           -l  simulated duration of one microsecond of the HD44780 busy wait in ns (default 1000).
+*           -q  only print the summary line.
+*
+*       The exit status is 1 if the emulator detected any timing violation.
+*
+**/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "hd44780.h"
+#include "hd44780_bus.h"
+#include "hd44780_emu.h"
+#include "gpio_sim.h"
+#include "rcc_driver.h"
+#if HD44780_TRANSPORT == HD44780_TRANSPORT_SPI_595
+#include "hd44780_spi_sim.h"
+#endif
+
+static uint32_t loop_cost_ns = 1000;
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn render_frame
+ *
+ * @brief function to print a time and date frame in the LCD as Systick_Handler does.
+ *
+ * @param[in] seconds is the number of seconds since 11:59:15 PM, the time set by src/main.c.
+ *
+ * @return void.
+ */
+static void render_frame(uint32_t seconds);
+
+/**
+ * @fn lcd_wait
+ *
+ * @brief function to wait for the bus traffic queued by the transport.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ */
+static void lcd_wait(void);
+
+/**
+ * @fn print_display
+ *
+ * @brief function to print the visible content of the emulated LCD.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ */
+static void print_display(void);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void hd44780_udelay(uint32_t cnt){
+
+    gpio_sim_advance((uint64_t)cnt * loop_cost_ns);
+}
+
+uint32_t RCC_GetHCLKValue(void){
+
+    /* Only read by hd44780_bus_init for the weak hd44780_udelay, which is replaced above */
+    return RCC_HSI_VALUE;
+}
+
+int main(int argc, char* argv[]){
+
+    hd44780_emu_stats_t stats;
+    uint64_t total_ns = 0;
+    uint32_t frames = 3;
+    uint32_t i = 0;
+    int quiet = 0;
+    int opt = 0;
+
+    while((opt = getopt(argc, argv, "n:g:l:q")) != -1){
+        switch(opt){
+            case 'n':
+                frames = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'g':
+                gpio_sim_set_write_cost((uint32_t)strtoul(optarg, NULL, 0));
+                break;
+            case 'l':
+                loop_cost_ns = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'q':
+                quiet = 1;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-n frames] [-g gpio_ns] [-l loop_ns] [-q]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    gpio_sim_reset();
+
+    hd44780_emu_frame_begin(gpio_sim_now());
+    hd44780_init();
+    lcd_wait();
+    hd44780_emu_frame_end(gpio_sim_now(), &stats);
+
+    if(!quiet){
+        printf("init: %llu us, %u pin changes, %u commands\n",
+               (unsigned long long)(stats.elapsed_ns / 1000), stats.pin_changes, stats.commands);
+    }
+
+    for(i = 0; i < frames; i++){
+        hd44780_emu_frame_begin(gpio_sim_now());
+        render_frame(i);
+        lcd_wait();
+        hd44780_emu_frame_end(gpio_sim_now(), &stats);
+
+        total_ns += stats.elapsed_ns;
+
+        if(!quiet){
+            printf("frame %u: %llu us, %u pin changes, %u nibbles, %u commands, %u data writes, %u violations\n",
+                   i, (unsigned long long)(stats.elapsed_ns / 1000), stats.pin_changes, stats.en_pulses,
+                   stats.commands, stats.data_writes, stats.violations);
+        }
+    }
+
+    if(!quiet){
+        print_display();
+    }
+
+    printf("frames: %u, mean bus time per frame: %llu us, violations: %u\n", frames,
+           (unsigned long long)(frames ? (total_ns / frames / 1000) : 0), hd44780_emu_violations());
+
+    return hd44780_emu_violations() ? 1 : 0;
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static void render_frame(uint32_t seconds){
+
+    static char* days[] = {"Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"};
+    char buf[12];
+    uint32_t t = (23 * 3600) + (59 * 60) + 15 + seconds;
+
+    snprintf(buf, sizeof(buf), "%02u:%02u:%02u", ((t / 3600) % 12) ? ((t / 3600) % 12) : 12,
+             (t / 60) % 60, t % 60);
+    hd44780_set_cursor(1, 1);
+    hd44780_print_string(buf);
+    hd44780_print_char(' ');
+    hd44780_print_string(((t / 3600) % 24) >= 12 ? "PM" : "AM");
+
+    snprintf(buf, sizeof(buf), "%02u/%02u/%02u", (17 + (t / 86400)) % 100, 7, 21);
+    hd44780_set_cursor(2, 1);
+    hd44780_print_string(buf);
+    hd44780_print_char('<');
+    hd44780_print_string(days[(5 + (t / 86400)) % 7]);
+    hd44780_print_char('>');
+}
+
+static void lcd_wait(void){
+
+#if HD44780_TRANSPORT == HD44780_TRANSPORT_SPI_595
+    hd44780_spi_sim_wait();
+#endif
+}
+
+static void print_display(void){
+
+    char line[HD44780_EMU_COLUMNS + 1];
+
+    printf("+----------------+\n");
+    hd44780_emu_get_line(1, line);
+    printf("|%s|\n", line);
+    hd44780_emu_get_line(2, line);
+    printf("|%s|\n", line);
+    printf("+----------------+\n");
+}
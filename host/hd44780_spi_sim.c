@@ -0,0 +1,134 @@
+/*****************************************************************************************************
+* FILENAME :        hd44780_spi_sim.c
+*
+* DESCRIPTION :
+*       File containing the host stand-in for the peripherals of the HD44780 SPI transport.
+*
+* PUBLIC FUNCTIONS :
+*       void    hd44780_spi_sim_wait(void)
+*
+*       The hd44780_spi_hw_* functions of hd44780_bus.h.
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+**/
+
+#include "hd44780_spi_sim.h"
+#include "hd44780.h"
+#include "hd44780_bus.h"
+#include "hd44780_emu.h"
+#include "gpio_sim.h"
+#include <stdint.h>
+
+/* Interrupt handler of the transport, called at the end of a simulated transfer */
+void DMA2_Stream5_Handler(void);
+
+static const uint8_t* sim_states = 0;
+static uint16_t sim_len = 0;
+static uint8_t sim_done = 0;
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn sim_play
+ *
+ * @brief function to latch the states of the running transfer and advance the simulated clock to
+ *        its transfer complete event.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ */
+static void sim_play(void);
+
+/**
+ * @fn sim_pins
+ *
+ * @brief function to convert the 74HC595 outputs into the signals of the HD44780 emulator.
+ *
+ * @param[in] state is the value of the 74HC595 outputs.
+ *
+ * @return bit mask of @HD44780_EMU_PIN.
+ */
+static uint8_t sim_pins(uint8_t state);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void hd44780_spi_sim_wait(void){
+
+    while(hd44780_bus_busy()){
+        if(hd44780_spi_hw_done()){
+            DMA2_Stream5_Handler();
+        }
+    }
+}
+
+void hd44780_spi_hw_init(void){
+
+    sim_states = 0;
+    sim_len = 0;
+    sim_done = 0;
+}
+
+void hd44780_spi_hw_start(const uint8_t* states, uint16_t len){
+
+    sim_states = states;
+    sim_len = len;
+    sim_done = 0;
+}
+
+uint8_t hd44780_spi_hw_done(void){
+
+    if(!sim_done && sim_len){
+        sim_play();
+    }
+
+    return sim_done;
+}
+
+void hd44780_spi_hw_stop(void){
+
+    sim_len = 0;
+    sim_done = 0;
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static void sim_play(void){
+
+    uint16_t i = 0;
+
+    /* State n is latched HD44780_SPI_LATCH_US after the start of slot n, the transfer ends with the
+       last one */
+    for(i = 0; i < sim_len; i++){
+        gpio_sim_advance(HD44780_SPI_LATCH_US * 1000ULL);
+        hd44780_emu_set_pins(gpio_sim_now(), sim_pins(sim_states[i]));
+        if(i < (sim_len - 1)){
+            gpio_sim_advance((HD44780_SPI_SLOT_US - HD44780_SPI_LATCH_US) * 1000ULL);
+        }
+    }
+
+    sim_done = 1;
+}
+
+static uint8_t sim_pins(uint8_t state){
+
+    uint8_t pins = 0;
+
+    pins |= (state & (1 << HD44780_595_RS)) ? HD44780_EMU_RS : 0;
+    pins |= (state & (1 << HD44780_595_RW)) ? HD44780_EMU_RW : 0;
+    pins |= (state & (1 << HD44780_595_EN)) ? HD44780_EMU_EN : 0;
+    pins |= (state & (1 << HD44780_595_D4)) ? HD44780_EMU_D4 : 0;
+    pins |= (state & (1 << HD44780_595_D5)) ? HD44780_EMU_D5 : 0;
+    pins |= (state & (1 << HD44780_595_D6)) ? HD44780_EMU_D6 : 0;
+    pins |= (state & (1 << HD44780_595_D7)) ? HD44780_EMU_D7 : 0;
+
+    return pins;
+}
@@ -0,0 +1,43 @@
+/*****************************************************************************************************
+* FILENAME :        hd44780_spi_sim.h
+*
+* DESCRIPTION :
+*       Header file containing the prototypes of the host stand-in for the peripherals of the HD44780
+*       SPI transport (74HC595 on SPI, paced by TIM1 and fed by DMA).
+*
+* PUBLIC FUNCTIONS :
+*       void    hd44780_spi_sim_wait(void)
+*
+*       The hd44780_spi_hw_* functions of hd44780_bus.h.
+*
+* NOTES :
+*       A transfer is played when the transport polls it (hd44780_spi_hw_done) or when
+*       hd44780_spi_sim_wait is called: state n is latched into the 74HC595 outputs HD44780_SPI_LATCH_US
+*       after the start of slot n, and the outputs are forwarded to the HD44780 emulator. The
+*       simulated clock is the one of the GPIO stand-in (gpio_sim_now), the queueing CPU time is not
+*       simulated.
+*
+**/
+
+#ifndef HD44780_SPI_SIM_H
+#define HD44780_SPI_SIM_H
+
+#include <stdint.h>
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn hd44780_spi_sim_wait
+ *
+ * @brief function to play the queued transfers until the transport is idle, as a task polling
+ *        hd44780_is_busy would wait for them.
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+void hd44780_spi_sim_wait(void);
+
+#endif /* HD44780_SPI_SIM_H */
@@ -0,0 +1,201 @@
+/*****************************************************************************************************
+* FILENAME :        i2c_sim.c
+*
+* DESCRIPTION :
+*       File containing the host stand-in for the I2C driver.
+*
+* PUBLIC FUNCTIONS :
+*       void        i2c_sim_reset(void)
+*       void        i2c_sim_get_stats(i2c_sim_stats_t* stats)
+*       uint8_t     i2c_sim_get_record(uint32_t index, i2c_sim_record_t* record)
+*
+*       The blocking master APIs of i2c_driver.h.
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+**/
+
+#include "i2c_sim.h"
+#include "i2c_driver.h"
+#include "gpio_sim.h"
+#include "ds1307.h"
+#include "ds1307_emu.h"
+#include "bustrace.h"
+#include <stdint.h>
+
+/* Bit times of a byte with its acknowledge, the start and stop conditions take one bit time */
+#define I2C_SIM_BYTE_BITS           9
+
+static i2c_sim_stats_t sim_stats;
+static i2c_sim_record_t sim_records[I2C_SIM_RECORDS];
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn i2c_sim_transfer
+ *
+ * @brief function to run a master transaction: forward it to the addressed device, record it and
+ *        advance the simulated clock.
+ *
+ * @param[in] pI2C_Handle handle structure for the I2C peripheral.
+ * @param[in] buf is the data to send, or the buffer for the data received.
+ * @param[in] len is the number of data bytes.
+ * @param[in] slave_addr is the 7 bit slave address.
+ * @param[in] read is 1 for a read, 0 for a write.
+ * @param[in] sr is the repeated start option, possible values @I2C_SR.
+ *
+ * @return void.
+ */
+static void i2c_sim_transfer(I2C_Handle_t* pI2C_Handle, uint8_t* buf, uint32_t len, uint8_t slave_addr,
+                             uint8_t read, sr_t sr);
+
+/**
+ * @fn i2c_sim_bits
+ *
+ * @brief function to advance the simulated clock by a number of SCL periods.
+ *
+ * @param[in] bits is the number of SCL periods.
+ * @param[in] speed is the SCL frequency in Hz.
+ *
+ * @return void.
+ */
+static void i2c_sim_bits(uint32_t bits, uint32_t speed);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void i2c_sim_reset(void){
+
+    uint32_t i = 0;
+
+    sim_stats.transactions = 0;
+    sim_stats.bytes_written = 0;
+    sim_stats.bytes_read = 0;
+    sim_stats.nacks = 0;
+    sim_stats.bus_ns = 0;
+
+    for(i = 0; i < I2C_SIM_RECORDS; i++){
+        sim_records[i].len = 0;
+    }
+
+    ds1307_emu_reset();
+}
+
+void i2c_sim_get_stats(i2c_sim_stats_t* stats){
+
+    *stats = sim_stats;
+}
+
+uint8_t i2c_sim_get_record(uint32_t index, i2c_sim_record_t* record){
+
+    if((index >= sim_stats.transactions) || ((sim_stats.transactions - index) > I2C_SIM_RECORDS)){
+        return 1;
+    }
+
+    *record = sim_records[index % I2C_SIM_RECORDS];
+
+    return 0;
+}
+
+void I2C_Init(I2C_Handle_t* pI2C_Handle){
+
+    (void)pI2C_Handle;
+}
+
+void I2C_DeInit(I2C_RegDef_t* pI2Cx){
+
+    (void)pI2Cx;
+}
+
+void I2C_PerClkCtrl(I2C_RegDef_t* pI2Cx, uint8_t en_or_di){
+
+    (void)pI2Cx;
+    (void)en_or_di;
+}
+
+void I2C_Enable(I2C_RegDef_t* pI2Cx, uint8_t en_or_di){
+
+    (void)pI2Cx;
+    (void)en_or_di;
+}
+
+void I2C_MasterSendData(I2C_Handle_t* pI2C_Handle, uint8_t* pTxBuffer, uint32_t len, uint8_t slave_addr, sr_t sr){
+
+    i2c_sim_transfer(pI2C_Handle, pTxBuffer, len, slave_addr, 0, sr);
+}
+
+void I2C_MasterReceiveData(I2C_Handle_t* pI2C_Handle, uint8_t* pRxBuffer, uint8_t len, uint8_t slave_addr, sr_t sr){
+
+    i2c_sim_transfer(pI2C_Handle, pRxBuffer, len, slave_addr, 1, sr);
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static void i2c_sim_transfer(I2C_Handle_t* pI2C_Handle, uint8_t* buf, uint32_t len, uint8_t slave_addr,
+                             uint8_t read, sr_t sr){
+
+    i2c_sim_record_t* record = &sim_records[sim_stats.transactions % I2C_SIM_RECORDS];
+    uint32_t speed = pI2C_Handle->I2C_Config.I2C_SCLSpeed ? pI2C_Handle->I2C_Config.I2C_SCLSpeed
+                                                          : I2C_SCL_SPEED_SM;
+    uint64_t start_ns = gpio_sim_now();
+    uint32_t i = 0;
+
+    record->addr = slave_addr;
+    record->read = read;
+    record->ack = (slave_addr == DS1307_I2C_ADDR);
+    record->sr = (sr == I2C_ENABLE_SR);
+    record->len = len;
+
+    /* Start condition and address byte */
+    BUSTRACE(BUSTRACE_I2C_START, 1, (slave_addr << 1) | read);
+    i2c_sim_bits(1 + I2C_SIM_BYTE_BITS, speed);
+
+    if(record->ack){
+        /* The master sends or receives every byte */
+        if(read){
+            ds1307_emu_read(buf, len);
+            sim_stats.bytes_read += len;
+        }
+        else{
+            ds1307_emu_write(buf, len);
+            sim_stats.bytes_written += len;
+        }
+        for(i = 0; i < len; i++){
+            i2c_sim_bits(I2C_SIM_BYTE_BITS, speed);
+            BUSTRACE(BUSTRACE_I2C_BYTE, 1, buf[i]);
+        }
+    }
+    else{
+        /* Address not acknowledged, the master stops after the address byte */
+        if(read){
+            for(i = 0; i < len; i++){
+                buf[i] = 0xFF;
+            }
+        }
+        sim_stats.nacks++;
+    }
+
+    /* Stop condition, or the repeated start of the next transaction */
+    i2c_sim_bits(1, speed);
+    if(sr == I2C_DISABLE_SR){
+        BUSTRACE(BUSTRACE_I2C_STOP, 1, 0);
+    }
+
+    for(i = 0; (i < len) && (i < I2C_SIM_RECORD_DATA); i++){
+        record->data[i] = buf[i];
+    }
+
+    sim_stats.transactions++;
+    sim_stats.bus_ns += gpio_sim_now() - start_ns;
+}
+
+static void i2c_sim_bits(uint32_t bits, uint32_t speed){
+
+    gpio_sim_advance(((uint64_t)bits * 1000000000ULL) / speed);
+}
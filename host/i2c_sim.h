@@ -0,0 +1,101 @@
+/*****************************************************************************************************
+* FILENAME :        i2c_sim.h
+*
+* DESCRIPTION :
+*       Header file containing the prototypes of the host stand-in for the I2C driver.
+*
+* PUBLIC FUNCTIONS :
+*       void        i2c_sim_reset(void)
+*       void        i2c_sim_get_stats(i2c_sim_stats_t* stats)
+*       uint8_t     i2c_sim_get_record(uint32_t index, i2c_sim_record_t* record)
+*
+* NOTES :
+*       i2c_sim.c implements the blocking master APIs of i2c_driver.h on Linux (I2C_Init, I2C_DeInit,
+*       I2C_PerClkCtrl, I2C_Enable, I2C_MasterSendData and I2C_MasterReceiveData), which are the ones
+*       used by the BSP; the interrupt and slave APIs are not provided. Transactions addressed to
+*       DS1307_I2C_ADDR are forwarded to the DS1307 emulator (ds1307_emu.h), any other address is not
+*       acknowledged and reads return 0xFF. Every transaction is recorded and advances the simulated
+*       clock of gpio_sim.h by its duration on the bus at the configured SCL speed. The start, every byte
+*       and the stop are recorded in the bus trace (bustrace.h) as I2C number 1.
+*
+**/
+
+#ifndef I2C_SIM_H
+#define I2C_SIM_H
+
+#include <stdint.h>
+
+/**
+ * Number of transactions kept, the oldest ones are overwritten.
+ */
+#define I2C_SIM_RECORDS         64
+
+/**
+ * Number of data bytes kept per transaction.
+ */
+#define I2C_SIM_RECORD_DATA     8
+
+/**
+ * Structure for storing a transaction.
+ */
+typedef struct
+{
+    uint8_t addr;                       /* 7 bit slave address */
+    uint8_t read;                       /* 1 for a read, 0 for a write */
+    uint8_t ack;                        /* 1 if the address was acknowledged */
+    uint8_t sr;                         /* 1 if it ended with a repeated start */
+    uint32_t len;                       /* Number of data bytes */
+    uint8_t data[I2C_SIM_RECORD_DATA];  /* First data bytes */
+}i2c_sim_record_t;
+
+/**
+ * Structure for storing the bus statistics since the last reset.
+ */
+typedef struct
+{
+    uint32_t transactions;      /* Number of transactions */
+    uint32_t bytes_written;     /* Number of data bytes sent by the master */
+    uint32_t bytes_read;        /* Number of data bytes received by the master */
+    uint32_t nacks;             /* Number of addresses not acknowledged */
+    uint64_t bus_ns;            /* Simulated time on the bus */
+}i2c_sim_stats_t;
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn i2c_sim_reset
+ *
+ * @brief function to clear the statistics and the records and to reset the DS1307 emulator.
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+void i2c_sim_reset(void);
+
+/**
+ * @fn i2c_sim_get_stats
+ *
+ * @brief function to get the bus statistics since the last reset.
+ *
+ * @param[out] stats is the structure to fill.
+ *
+ * @return void
+ */
+void i2c_sim_get_stats(i2c_sim_stats_t* stats);
+
+/**
+ * @fn i2c_sim_get_record
+ *
+ * @brief function to get a recorded transaction.
+ *
+ * @param[in] index is the transaction number since the last reset, 0 is the first one.
+ * @param[out] record is the structure to fill.
+ *
+ * @return 0 if found, 1 if the transaction was overwritten or has not happened.
+ */
+uint8_t i2c_sim_get_record(uint32_t index, i2c_sim_record_t* record);
+
+#endif /* I2C_SIM_H */
@@ -0,0 +1,201 @@
+//
+// FILENAME :        DS1307.cs
+//
+// DESCRIPTION :
+//       Renode model of the DS1307 real time clock, attached to I2C1 of the emulated board.
+//
+// NOTES :
+//       Same register model as host/ds1307_emu.c: 64 registers (clock registers, control and NV
+//       RAM), a register pointer set by the first byte of a write and incremented after every byte
+//       read or written, and a clock which only runs while the CH bit is clear, in BCD, in 12 or 24
+//       hours mode. The clock ticks once per second of virtual time. LastTickMicroseconds is the
+//       virtual time of the last tick, used by the refresh latency check of board.robot.
+//
+//       Loaded by the scripts with: include @host/renode/DS1307.cs
+//
+
+using System;
+using Antmicro.Renode.Core;
+using Antmicro.Renode.Logging;
+using Antmicro.Renode.Peripherals.Timers;
+using Antmicro.Renode.Time;
+
+namespace Antmicro.Renode.Peripherals.I2C
+{
+    public class DS1307 : II2CPeripheral
+    {
+        public DS1307(IMachine machine)
+        {
+            this.machine = machine;
+            secondTimer = new LimitTimer(machine.ClockSource, 1, this, "second", limit: 1, direction: Direction.Ascending,
+                                         enabled: true, workMode: WorkMode.Periodic, eventEnabled: true);
+            secondTimer.LimitReached += Tick;
+            Reset();
+        }
+
+        public void Reset()
+        {
+            // First power-on: every register cleared and the oscillator halted
+            Array.Clear(registers, 0, registers.Length);
+            registers[RegSeconds] = ClockHalt;
+            pointer = 0;
+            pointerExpected = true;
+            LastTickMicroseconds = 0;
+            secondTimer.Reset();
+            secondTimer.Enabled = true;
+        }
+
+        public void Write(byte[] data)
+        {
+            foreach(var b in data)
+            {
+                if(pointerExpected)
+                {
+                    pointer = b % Registers;
+                    pointerExpected = false;
+                    continue;
+                }
+                registers[pointer] = b;
+                pointer = (pointer + 1) % Registers;
+            }
+        }
+
+        public byte[] Read(int count = 1)
+        {
+            var data = new byte[count];
+
+            for(var i = 0; i < count; i++)
+            {
+                data[i] = registers[pointer];
+                pointer = (pointer + 1) % Registers;
+            }
+            return data;
+        }
+
+        public void FinishTransmission()
+        {
+            // The next write starts with the register pointer
+            pointerExpected = true;
+        }
+
+        public byte GetRegister(int address)
+        {
+            return registers[address % Registers];
+        }
+
+        public ulong LastTickMicroseconds { get; private set; }
+
+        private void Tick()
+        {
+            if((registers[RegSeconds] & ClockHalt) != 0)
+            {
+                return;
+            }
+
+            LastTickMicroseconds = machine.ElapsedVirtualTime.TimeElapsed.TotalMicroseconds;
+
+            var seconds = FromBcd(registers[RegSeconds]) + 1;
+            if(seconds < 60)
+            {
+                registers[RegSeconds] = ToBcd(seconds);
+                return;
+            }
+            registers[RegSeconds] = 0;
+
+            var minutes = FromBcd(registers[RegMinutes]) + 1;
+            if(minutes < 60)
+            {
+                registers[RegMinutes] = ToBcd(minutes);
+                return;
+            }
+            registers[RegMinutes] = 0;
+
+            if(!TickHours())
+            {
+                return;
+            }
+
+            var day = FromBcd(registers[RegDay]);
+            var date = FromBcd(registers[RegDate]) + 1;
+            var month = FromBcd(registers[RegMonth]);
+            var year = FromBcd(registers[RegYear]);
+
+            registers[RegDay] = ToBcd((day >= 7) ? 1 : day + 1);
+            if(date > DaysInMonth(month, year))
+            {
+                date = 1;
+                if(++month > 12)
+                {
+                    month = 1;
+                    year = (year + 1) % 100;
+                }
+            }
+            registers[RegDate] = ToBcd(date);
+            registers[RegMonth] = ToBcd(month);
+            registers[RegYear] = ToBcd(year);
+        }
+
+        private bool TickHours()
+        {
+            var reg = registers[RegHours];
+
+            if((reg & Mode12h) == 0)
+            {
+                var hours24 = FromBcd((byte)(reg & 0x3F)) + 1;
+                registers[RegHours] = ToBcd((hours24 < 24) ? hours24 : 0);
+                return hours24 >= 24;
+            }
+
+            // 12 hours mode: 11 AM -> 12 PM -> 1 PM ... 11 PM -> 12 AM, the day changes at 12 AM
+            var hours = FromBcd((byte)(reg & 0x1F)) + 1;
+            if(hours == 13)
+            {
+                hours = 1;
+            }
+            if(hours == 12)
+            {
+                reg ^= Pm;
+            }
+            registers[RegHours] = (byte)((reg & (Mode12h | Pm)) | ToBcd(hours));
+            return (hours == 12) && ((reg & Pm) == 0);
+        }
+
+        private static int DaysInMonth(int month, int year)
+        {
+            if(month == 2 && (year % 4) == 0)
+            {
+                return 29;
+            }
+            return (month >= 1 && month <= 12) ? DaysPerMonth[month - 1] : 31;
+        }
+
+        private static byte ToBcd(int value)
+        {
+            return (byte)(((value / 10) << 4) | (value % 10));
+        }
+
+        private static int FromBcd(byte value)
+        {
+            return ((value >> 4) * 10) + (value & 0x0F);
+        }
+
+        private readonly IMachine machine;
+        private readonly LimitTimer secondTimer;
+        private readonly byte[] registers = new byte[Registers];
+        private int pointer;
+        private bool pointerExpected;
+
+        private const int Registers = 64;
+        private const int RegSeconds = 0x00;
+        private const int RegMinutes = 0x01;
+        private const int RegHours = 0x02;
+        private const int RegDay = 0x03;
+        private const int RegDate = 0x04;
+        private const int RegMonth = 0x05;
+        private const int RegYear = 0x06;
+        private const byte ClockHalt = 1 << 7;
+        private const byte Mode12h = 1 << 6;
+        private const byte Pm = 1 << 5;
+        private static readonly int[] DaysPerMonth = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    }
+}
@@ -0,0 +1,242 @@
+//
+// FILENAME :        HD44780.cs
+//
+// DESCRIPTION :
+//       Renode model of the HD44780 16x2 LCD, driven by the GPIOC pins of the emulated board.
+//
+// NOTES :
+//       Inputs: 0 RS, 1 RW, 2 EN, 4 D4, 5 D5, 6 D6, 7 D7 (same bits as host/hd44780_emu.h), wired to
+//       the pins of bsp/hd44780.h in nucleo_f446re.repl. The data is latched on the falling edge of
+//       EN, in 8 bit mode until a function set selects the 4 bit interface. Only the features used
+//       by bsp/hd44780.c are modelled: DDRAM with the 2 line addressing, address counter, entry
+//       mode, clear and home.
+//
+//       A transfer started before the busy time of the previous instruction has elapsed is counted
+//       in Violations. The virtual time of a GPIO change has the resolution of the global quantum
+//       set by the scripts, so the enable pulse width is not checked here (host/hd44780_emu.c does).
+//       LastWriteMicroseconds is the virtual time of the last DDRAM write, used by the refresh
+//       latency check of board.robot.
+//
+//       Loaded by the scripts with: include @host/renode/HD44780.cs
+//
+
+using System;
+using System.Text;
+using Antmicro.Renode.Core;
+using Antmicro.Renode.Logging;
+
+namespace Antmicro.Renode.Peripherals.Miscellaneous
+{
+    public class HD44780 : IGPIOReceiver
+    {
+        public HD44780(IMachine machine)
+        {
+            this.machine = machine;
+            Reset();
+        }
+
+        public void Reset()
+        {
+            // Internal reset: increment, 8 bit interface, DDRAM filled with spaces
+            for(var i = 0; i < ddram.Length; i++)
+            {
+                ddram[i] = (byte)' ';
+            }
+            pins = 0;
+            address = 0;
+            increment = true;
+            fourBit = false;
+            nibblePhase = false;
+            highNibble = 0;
+            initSets = 0;
+            busyUntil = PowerOnUs;
+            Violations = 0;
+            Writes = 0;
+            LastWriteMicroseconds = 0;
+        }
+
+        public void OnGPIO(int number, bool value)
+        {
+            var previous = pins;
+
+            pins = value ? (pins | (1 << number)) : (pins & ~(1 << number));
+            if((previous & En) != 0 && (pins & En) == 0)
+            {
+                // Falling edge, the data is latched with the levels before the edge
+                Latch(previous);
+            }
+        }
+
+        public string GetLine(int row)
+        {
+            var line = new StringBuilder(Columns);
+
+            for(var i = 0; i < Columns; i++)
+            {
+                var c = ddram[((row - 1) & 0x1) * LineLength + i];
+                line.Append((c >= 0x20 && c < 0x7F) ? (char)c : '.');
+            }
+            return line.ToString();
+        }
+
+        public uint Violations { get; private set; }
+
+        public uint Writes { get; private set; }
+
+        public ulong LastWriteMicroseconds { get; private set; }
+
+        private void Latch(int levels)
+        {
+            var now = machine.ElapsedVirtualTime.TimeElapsed.TotalMicroseconds;
+            var rs = (levels & Rs) != 0;
+            var nibble = (byte)((levels >> 4) & 0xF);
+            byte value;
+
+            if((levels & Rw) != 0)
+            {
+                // Reads are not used by the driver
+                return;
+            }
+
+            if(!fourBit || !nibblePhase)
+            {
+                // Start of an instruction, the previous one must be finished
+                if(now < busyUntil)
+                {
+                    Violations++;
+                    this.Log(LogLevel.Warning, "Transfer started {0} us before the controller is ready", busyUntil - now);
+                }
+            }
+
+            if(fourBit)
+            {
+                if(!nibblePhase)
+                {
+                    highNibble = nibble;
+                    nibblePhase = true;
+                    return;
+                }
+                value = (byte)((highNibble << 4) | nibble);
+                nibblePhase = false;
+            }
+            else
+            {
+                // 8 bit interface, D0 to D3 are not connected and read as 0
+                value = (byte)(nibble << 4);
+            }
+
+            busyUntil = now + Execute(rs, value, now);
+        }
+
+        private ulong Execute(bool rs, byte value, ulong now)
+        {
+            if(rs)
+            {
+                ddram[((address & 0x40) != 0 ? LineLength : 0) + (address & 0x3F) % LineLength] = value;
+                MoveAddress();
+                Writes++;
+                LastWriteMicroseconds = now;
+                return WriteUs;
+            }
+
+            if((value & 0x80) != 0)
+            {
+                // Set DDRAM address
+                address = value & 0x7F;
+                if((address & 0x3F) >= LineLength)
+                {
+                    address &= 0x40;
+                }
+            }
+            else if((value & 0x40) != 0)
+            {
+                // Set CGRAM address, CGRAM is not modelled
+            }
+            else if((value & 0x20) != 0)
+            {
+                // Function set, the first two in 8 bit mode need longer waits
+                var eightBit = !fourBit;
+                fourBit = (value & 0x10) == 0;
+                if(eightBit)
+                {
+                    initSets++;
+                    if(initSets == 1)
+                    {
+                        return Init1Us;
+                    }
+                    if(initSets == 2)
+                    {
+                        return Init2Us;
+                    }
+                }
+            }
+            else if((value & 0x04) != 0 && (value & 0x18) == 0)
+            {
+                // Entry mode set
+                increment = (value & 0x02) != 0;
+            }
+            else if((value & 0x02) != 0 && (value & 0x1C) == 0)
+            {
+                // Return home
+                address = 0;
+                return HomeUs;
+            }
+            else if(value == 0x01)
+            {
+                // Clear display
+                for(var i = 0; i < ddram.Length; i++)
+                {
+                    ddram[i] = (byte)' ';
+                }
+                address = 0;
+                increment = true;
+                return HomeUs;
+            }
+            return ExecUs;
+        }
+
+        private void MoveAddress()
+        {
+            var line = address & 0x40;
+            var column = address & 0x3F;
+
+            if(increment)
+            {
+                if(++column >= LineLength)
+                {
+                    column = 0;
+                    line ^= 0x40;
+                }
+            }
+            else if(column-- == 0)
+            {
+                column = LineLength - 1;
+                line ^= 0x40;
+            }
+            address = line | column;
+        }
+
+        private readonly IMachine machine;
+        private readonly byte[] ddram = new byte[2 * LineLength];
+        private int pins;
+        private int address;
+        private bool increment;
+        private bool fourBit;
+        private bool nibblePhase;
+        private byte highNibble;
+        private int initSets;
+        private ulong busyUntil;
+
+        private const int Rs = 1 << 0;
+        private const int Rw = 1 << 1;
+        private const int En = 1 << 2;
+        private const int Columns = 16;
+        private const int LineLength = 40;
+        private const ulong PowerOnUs = 15000;
+        private const ulong Init1Us = 4100;
+        private const ulong Init2Us = 100;
+        private const ulong ExecUs = 37;
+        private const ulong WriteUs = 43;
+        private const ulong HomeUs = 1520;
+    }
+}
@@ -0,0 +1,17 @@
+#
+# FILENAME :        stm32f4_flash.py
+#
+# DESCRIPTION :
+#       Renode Python peripheral standing in for the flash interface registers of the STM32F446RE.
+#
+# NOTES :
+#       The registers keep the written values, so the wait states and cache settings written to ACR
+#       read back as hal/rcc_driver.c expects. Programming the flash is not supported.
+#
+
+if request.isInit:
+    regs = {}
+elif request.isRead:
+    request.value = regs.get(request.offset, 0)
+elif request.isWrite:
+    regs[request.offset] = request.value
@@ -0,0 +1,24 @@
+#
+# FILENAME :        stm32f4_pwr.py
+#
+# DESCRIPTION :
+#       Renode Python peripheral standing in for the PWR controller of the STM32F446RE.
+#
+# NOTES :
+#       The registers keep the written values. In CSR, VOSRDY is always set and ODRDY and ODSWRDY
+#       follow ODEN and ODSWEN of CR, the flags polled by hal/rcc_driver.c to switch to over-drive.
+#
+
+CR = 0x00
+CSR = 0x04
+
+if request.isInit:
+    regs = {CR: 0x0000C000, CSR: 0x00000000}
+elif request.isRead:
+    value = regs.get(request.offset, 0)
+    if request.offset == CSR:
+        cr = regs.get(CR, 0)
+        value = (value & ~(0x3 << 16)) | (1 << 14) | (cr & (0x3 << 16))
+    request.value = value
+elif request.isWrite:
+    regs[request.offset] = request.value
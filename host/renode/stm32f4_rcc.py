@@ -0,0 +1,33 @@
+#
+# FILENAME :        stm32f4_rcc.py
+#
+# DESCRIPTION :
+#       Renode Python peripheral standing in for the RCC of the STM32F446RE.
+#
+# NOTES :
+#       The registers keep the written values, and the ready flags follow their enable bits the way
+#       hal/rcc_driver.c polls them: HSIRDY, HSERDY and PLLRDY in CR, SWS mirrors SW in CFGR and
+#       LSIRDY in CSR. The clock frequencies are computed by the driver from PLLCFGR and CFGR, the
+#       CPU speed is fixed in nucleo_f446re.repl.
+#
+
+CR = 0x00
+PLLCFGR = 0x04
+CFGR = 0x08
+CSR = 0x74
+
+if request.isInit:
+    regs = {CR: 0x00000083, PLLCFGR: 0x24003010, CFGR: 0x00000000, CSR: 0x0E000000}
+elif request.isRead:
+    value = regs.get(request.offset, 0)
+    if request.offset == CR:
+        # HSION (0) -> HSIRDY (1), HSEON (16) -> HSERDY (17), PLLON (24) -> PLLRDY (25)
+        value = (value & ~((1 << 1) | (1 << 17) | (1 << 25))) | ((value & ((1 << 0) | (1 << 16) | (1 << 24))) << 1)
+    elif request.offset == CFGR:
+        value = (value & ~(0x3 << 2)) | ((value & 0x3) << 2)
+    elif request.offset == CSR:
+        # LSION (0) -> LSIRDY (1)
+        value = (value & ~(1 << 1)) | ((value & 1) << 1)
+    request.value = value
+elif request.isWrite:
+    regs[request.offset] = request.value
@@ -0,0 +1,233 @@
+/*****************************************************************************************************
+* FILENAME :        rtt_reader.c
+*
+* DESCRIPTION :
+*       File containing the main function of the host RTT console reader. It finds the RTT control
+*       block (src/rtt.h) in a RAM dump of the target and prints the content of its up buffers.
+*
+* NOTES :
+*       Usage: rtt_reader [-b base_addr] [-c channel] [-l] dump.bin
+*           -b  target address of the first byte of the dump (default 0x20000000).
+*           -c  print only this up buffer (default all).
+*           -l  print all the bytes kept in the buffer, not only the ones the probe has not read yet.
+*
+*       A dump can be taken with OpenOCD:
+*           halt
+*           dump_image ram.bin 0x20000000 0x20000
+*
+*       The exit status is 1 if the control block is not found or it is not consistent.
+*
+**/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#define RTT_ID              "SEGGER RTT"
+#define RTT_ID_LEN          16
+#define RTT_BUFFER_WORDS    6
+#define RTT_MAX_BUFFERS     16
+
+static uint8_t* dump = NULL;
+static uint32_t dump_len = 0;
+static uint32_t dump_base = 0x20000000;
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn load_dump
+ *
+ * @brief function to read a whole dump file in memory.
+ *
+ * @param[in] path of the dump file.
+ *
+ * @return 0 if OK, 1 on error.
+ */
+static int load_dump(const char* path);
+
+/**
+ * @fn read_word
+ *
+ * @brief function to read a little endian 32 bit word of the dump.
+ *
+ * @param[in] offset in the dump.
+ *
+ * @return word value.
+ */
+static uint32_t read_word(uint32_t offset);
+
+/**
+ * @fn find_cb
+ *
+ * @brief function to find the RTT control block in the dump.
+ *
+ * @param[out] offset of the control block in the dump.
+ *
+ * @return 0 if found, 1 otherwise.
+ */
+static int find_cb(uint32_t* offset);
+
+/**
+ * @fn print_buffer
+ *
+ * @brief function to print the content of an up buffer.
+ *
+ * @param[in] offset of the buffer descriptor in the dump.
+ * @param[in] index of the buffer.
+ * @param[in] all is 1 for printing all the kept bytes, 0 for the unread ones.
+ *
+ * @return 0 if OK, 1 if the descriptor is not consistent.
+ */
+static int print_buffer(uint32_t offset, uint32_t index, int all);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+int main(int argc, char* argv[]){
+
+    uint32_t cb = 0;
+    uint32_t num_up = 0;
+    uint32_t i = 0;
+    long channel = -1;
+    int all = 0;
+    int err = 0;
+    int opt = 0;
+
+    while((opt = getopt(argc, argv, "b:c:l")) != -1){
+        switch(opt){
+            case 'b':
+                dump_base = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'c':
+                channel = strtol(optarg, NULL, 0);
+                break;
+            case 'l':
+                all = 1;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-b base_addr] [-c channel] [-l] dump.bin\n", argv[0]);
+                return 2;
+        }
+    }
+
+    if((optind >= argc) || load_dump(argv[optind])){
+        fprintf(stderr, "usage: %s [-b base_addr] [-c channel] [-l] dump.bin\n", argv[0]);
+        return 2;
+    }
+
+    if(find_cb(&cb)){
+        fprintf(stderr, "RTT control block not found\n");
+        return 1;
+    }
+
+    num_up = read_word(cb + RTT_ID_LEN);
+    fprintf(stderr, "RTT control block at 0x%08x, %u up buffers, %u down buffers\n", dump_base + cb, num_up,
+            read_word(cb + RTT_ID_LEN + 4));
+
+    if(num_up > RTT_MAX_BUFFERS){
+        fprintf(stderr, "inconsistent number of up buffers\n");
+        return 1;
+    }
+
+    for(i = 0; i < num_up; i++){
+        if((channel < 0) || (channel == (long)i)){
+            err |= print_buffer(cb + RTT_ID_LEN + 8 + (i * RTT_BUFFER_WORDS * 4), i, all);
+        }
+    }
+
+    free(dump);
+
+    return err;
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static int load_dump(const char* path){
+
+    FILE* f = fopen(path, "rb");
+    long len = 0;
+
+    if(f == NULL){
+        perror(path);
+        return 1;
+    }
+
+    fseek(f, 0, SEEK_END);
+    len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    dump = malloc((size_t)len);
+    if((dump == NULL) || (fread(dump, 1, (size_t)len, f) != (size_t)len)){
+        fprintf(stderr, "%s: read error\n", path);
+        fclose(f);
+        return 1;
+    }
+
+    dump_len = (uint32_t)len;
+    fclose(f);
+
+    return 0;
+}
+
+static uint32_t read_word(uint32_t offset){
+
+    if((offset + 4) > dump_len){
+        return 0xFFFFFFFF;
+    }
+
+    return (uint32_t)dump[offset] | ((uint32_t)dump[offset + 1] << 8) | ((uint32_t)dump[offset + 2] << 16) |
+           ((uint32_t)dump[offset + 3] << 24);
+}
+
+static int find_cb(uint32_t* offset){
+
+    uint32_t i = 0;
+
+    /* The control block is word aligned */
+    for(i = 0; (i + RTT_ID_LEN + 8) <= dump_len; i += 4){
+        if(memcmp(&dump[i], RTT_ID, sizeof(RTT_ID)) == 0){
+            *offset = i;
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+static int print_buffer(uint32_t offset, uint32_t index, int all){
+
+    uint32_t name = read_word(offset);
+    uint32_t addr = read_word(offset + 4);
+    uint32_t size = read_word(offset + 8);
+    uint32_t wr = read_word(offset + 12);
+    uint32_t rd = read_word(offset + 16);
+    uint32_t buf = addr - dump_base;
+    uint32_t pos = 0;
+
+    fprintf(stderr, "up buffer %u: name at 0x%08x, buffer at 0x%08x, size %u, WrOff %u, RdOff %u\n", index,
+            name, addr, size, wr, rd);
+
+    if((addr < dump_base) || (size == 0) || ((uint64_t)buf + size > dump_len) || (wr >= size) || (rd >= size)){
+        fprintf(stderr, "up buffer %u: inconsistent descriptor or buffer out of the dump\n", index);
+        return 1;
+    }
+
+    /* The byte after WrOff is the oldest one still kept, the target never fills the last free byte */
+    pos = all ? ((wr + 1) % size) : rd;
+
+    while(pos != wr){
+        if(!all || (dump[buf + pos] != '\0')){
+            putchar(dump[buf + pos]);
+        }
+        pos = (pos + 1) % size;
+    }
+
+    return 0;
+}
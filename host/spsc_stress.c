@@ -0,0 +1,239 @@
+/*****************************************************************************************************
+* FILENAME :        spsc_stress.c
+*
+* DESCRIPTION :
+*       File containing the main function of the host stress test of the lock-free ring buffer
+*       (src/spsc.c). A producer thread and the consumer (main thread) run concurrently on a small
+*       ring buffer, so the indexes wrap around the buffer many times, and every element is checked.
+*
+* NOTES :
+*       Usage: spsc_stress [-n elements] [-c capacity] [-s seed]
+*           -n  number of elements sent (default SPSC_STRESS_ELEMENTS).
+*           -c  ring buffer capacity, power of 2 (default SPSC_STRESS_CAPACITY).
+*           -s  seed of the batch sizes (default 1).
+*
+*       The producer pushes batches of random size, also larger than the free space, so the partial
+*       pushes are exercised. The consumer alternates spsc_pop batches of random size and spsc_peek
+*       followed by spsc_skip of a random part of the contiguous elements. Each element carries its
+*       sequence number and a check word, so a lost, duplicated, reordered or torn element is
+*       reported with its position. Both sides also yield the CPU at random points, so they
+*       interleave on a single core too.
+*
+*       The exit status is 1 if any element is wrong or missing.
+*
+**/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "spsc.h"
+
+#define SPSC_STRESS_ELEMENTS    1000000
+#define SPSC_STRESS_CAPACITY    64
+#define SPSC_STRESS_CHECK(seq)  (((seq) * 2654435761U) ^ 0xA5A5A5A5U)
+
+/**
+ * Element exchanged through the ring buffer, larger than a word so torn copies are visible.
+ */
+typedef struct
+{
+    uint32_t seq;
+    uint32_t check;
+    uint8_t pad[4];
+}spsc_stress_elem_t;
+
+static spsc_t ring;
+static uint32_t elements = SPSC_STRESS_ELEMENTS;
+static uint32_t capacity = SPSC_STRESS_CAPACITY;
+static uint32_t seed = 1;
+static volatile uint32_t producer_errors = 0;
+static volatile uint8_t consumer_stop = 0;         /* Set by the consumer on its first error */
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn producer
+ *
+ * @brief function of the producer thread, pushes the elements 0 to elements - 1 in order.
+ *
+ * @param[in] arg not used.
+ *
+ * @return NULL.
+ */
+static void* producer(void* arg);
+
+/**
+ * @fn check_elem
+ *
+ * @brief function to check a received element against the expected sequence number.
+ *
+ * @param[in] elem is the received element.
+ * @param[in] seq is the expected sequence number.
+ *
+ * @return 0 if the element is right, 1 otherwise.
+ */
+static uint8_t check_elem(const spsc_stress_elem_t* elem, uint32_t seq);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+int main(int argc, char* argv[]){
+
+    spsc_stress_elem_t* buf = NULL;
+    spsc_stress_elem_t* batch = NULL;
+    spsc_stress_elem_t* elems = NULL;
+    pthread_t thread;
+    unsigned int rnd = 0;
+    uint32_t seq = 0;
+    uint32_t count = 0;
+    uint32_t pops = 0;
+    uint32_t peeks = 0;
+    uint32_t errors = 0;
+    uint32_t i = 0;
+    int opt = 0;
+
+    while((opt = getopt(argc, argv, "n:c:s:")) != -1){
+        switch(opt){
+            case 'n':
+                elements = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'c':
+                capacity = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                seed = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-n elements] [-c capacity] [-s seed]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    buf = malloc(capacity * sizeof(spsc_stress_elem_t));
+    batch = malloc(capacity * sizeof(spsc_stress_elem_t));
+    if((buf == NULL) || (batch == NULL) || spsc_init(&ring, buf, sizeof(spsc_stress_elem_t), capacity)){
+        fprintf(stderr, "capacity must be a power of 2\n");
+        return 2;
+    }
+
+    if(pthread_create(&thread, NULL, producer, NULL)){
+        fprintf(stderr, "cannot start the producer thread\n");
+        return 2;
+    }
+
+    rnd = seed ^ 0x5A5A5A5AU;
+
+    while((seq < elements) && (errors == 0) && (producer_errors == 0)){
+        if(spsc_count(&ring) > capacity){
+            printf("count %u above the capacity at element %u\n", spsc_count(&ring), seq);
+            errors++;
+            break;
+        }
+
+        if(rand_r(&rnd) & 1){
+            /* Copy out a batch, which can wrap around the end of the buffer */
+            count = spsc_pop(&ring, batch, 1 + ((uint32_t)rand_r(&rnd) % capacity));
+            for(i = 0; (i < count) && (errors == 0); i++){
+                errors += check_elem(&batch[i], seq++);
+            }
+            pops += count ? 1 : 0;
+        }
+        else{
+            /* Read in place and release a part of the contiguous elements */
+            count = spsc_peek(&ring, (void**)&elems);
+            if(count){
+                count = 1 + ((uint32_t)rand_r(&rnd) % count);
+                for(i = 0; (i < count) && (errors == 0); i++){
+                    errors += check_elem(&elems[i], seq++);
+                }
+                spsc_skip(&ring, count);
+                peeks++;
+            }
+        }
+
+        /* Give the CPU to the producer at random points, so the two sides also interleave on a
+         * single core and the batches start anywhere in the buffer (sched.h is src/sched.h here) */
+        if((count == 0) || ((rand_r(&rnd) & 3) == 0)){
+            usleep(0);
+        }
+    }
+
+    consumer_stop = 1;
+    pthread_join(thread, NULL);
+
+    if((errors == 0) && spsc_count(&ring)){
+        printf("%u elements left after the last one\n", spsc_count(&ring));
+        errors++;
+    }
+    errors += producer_errors;
+
+    printf("elements: %u, capacity: %u, wraparounds: %u, pop batches: %u, peek batches: %u, errors: %u\n",
+           seq, capacity, seq / capacity, pops, peeks, errors);
+
+    free(batch);
+    free(buf);
+
+    return errors ? 1 : 0;
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static void* producer(void* arg){
+
+    spsc_stress_elem_t* batch = malloc(2 * capacity * sizeof(spsc_stress_elem_t));
+    unsigned int rnd = seed;
+    uint32_t seq = 0;
+    uint32_t len = 0;
+    uint32_t pushed = 0;
+    uint32_t i = 0;
+
+    (void)arg;
+
+    while((seq < elements) && !consumer_stop){
+        /* Up to twice the capacity, so some pushes only fit in part */
+        len = 1 + ((uint32_t)rand_r(&rnd) % (2 * capacity));
+        if(len > (elements - seq)){
+            len = elements - seq;
+        }
+
+        for(i = 0; i < len; i++){
+            batch[i].seq = seq + i;
+            batch[i].check = SPSC_STRESS_CHECK(seq + i);
+            batch[i].pad[0] = (uint8_t)(seq + i);
+        }
+
+        if(spsc_space(&ring) > capacity){
+            printf("space %u above the capacity at element %u\n", spsc_space(&ring), seq);
+            producer_errors++;
+            break;
+        }
+
+        pushed = spsc_push(&ring, batch, len);
+        seq += pushed;
+
+        if((pushed == 0) || ((rand_r(&rnd) & 3) == 0)){
+            usleep(0);
+        }
+    }
+
+    free(batch);
+
+    return NULL;
+}
+
+static uint8_t check_elem(const spsc_stress_elem_t* elem, uint32_t seq){
+
+    if((elem->seq != seq) || (elem->check != SPSC_STRESS_CHECK(seq)) || (elem->pad[0] != (uint8_t)seq)){
+        printf("element %u: got sequence %u, check 0x%08x\n", seq, elem->seq, elem->check);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,330 @@
+/*****************************************************************************************************
+* FILENAME :        trace_decode.c
+*
+* DESCRIPTION :
+*       File containing the main function of the host trace log decoder. It reads the binary records
+*       written by TRACE (src/trace.h) and prints them as text, using the format strings of the
+*       .trace_fmt section of the firmware ELF file.
+*
+* NOTES :
+*       Usage: trace_decode -e firmware.elf [-f cpu_hz] [trace.bin]
+*           -e  firmware ELF file which wrote the trace.
+*           -f  frequency of the DWT cycle counter, used for the timestamps (default 180000000).
+*           The records are read from stdin when no file is given.
+*
+*       The trace can be streamed by OpenOCD from the RTT trace channel:
+*           rtt server start 9091 1
+*           nc 127.0.0.1 9091 | ./build/host/trace_decode -e build/nucleof446re.elf
+*
+*       Or taken from a RAM dump:
+*           ./build/host/rtt_reader -c 1 ram.bin > trace.bin
+*
+*       Words which are not a valid record header are skipped until the next one.
+*
+**/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <elf.h>
+
+/* Keep in sync with src/trace.h */
+#define TRACE_SYNC              0xA5
+#define TRACE_SYNC_POS          24
+#define TRACE_NARGS_POS         20
+#define TRACE_ID_MASK           0x000FFFFF
+#define TRACE_MAX_ARGS          4
+
+static char* fmt_sec = NULL;
+static uint32_t fmt_sec_addr = 0;
+static uint32_t fmt_sec_size = 0;
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn load_formats
+ *
+ * @brief function to read the .trace_fmt section of an ELF32 little endian file.
+ *
+ * @param[in] path of the ELF file.
+ *
+ * @return 0 if OK, 1 on error.
+ */
+static int load_formats(const char* path);
+
+/**
+ * @fn read_word
+ *
+ * @brief function to read a little endian 32 bit word of the trace stream.
+ *
+ * @param[in] f is the trace stream.
+ * @param[out] word read.
+ *
+ * @return 0 if OK, 1 at the end of the stream.
+ */
+static int read_word(FILE* f, uint32_t* word);
+
+/**
+ * @fn print_record
+ *
+ * @brief function to print a message, formatting its arguments as a printf call.
+ *
+ * @param[in] fmt is the format string.
+ * @param[in] args are the arguments of the record.
+ * @param[in] nargs is the number of arguments.
+ *
+ * @return void.
+ */
+static void print_record(const char* fmt, const uint32_t* args, uint32_t nargs);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+int main(int argc, char* argv[]){
+
+    const char* elf = NULL;
+    double hz = 180000000.0;
+    FILE* f = stdin;
+    uint32_t header = 0;
+    uint32_t stamp = 0;
+    uint32_t prev_stamp = 0;
+    uint64_t wraps = 0;
+    uint32_t args[TRACE_MAX_ARGS];
+    uint32_t nargs = 0;
+    uint32_t id = 0;
+    uint32_t records = 0;
+    uint32_t skipped = 0;
+    uint32_t i = 0;
+    int opt = 0;
+
+    while((opt = getopt(argc, argv, "e:f:")) != -1){
+        switch(opt){
+            case 'e':
+                elf = optarg;
+                break;
+            case 'f':
+                hz = strtod(optarg, NULL);
+                break;
+            default:
+                fprintf(stderr, "usage: %s -e firmware.elf [-f cpu_hz] [trace.bin]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    if((elf == NULL) || (hz <= 0)){
+        fprintf(stderr, "usage: %s -e firmware.elf [-f cpu_hz] [trace.bin]\n", argv[0]);
+        return 2;
+    }
+
+    if(load_formats(elf)){
+        return 1;
+    }
+
+    if(optind < argc){
+        f = fopen(argv[optind], "rb");
+        if(f == NULL){
+            perror(argv[optind]);
+            return 1;
+        }
+    }
+
+    while(read_word(f, &header) == 0){
+
+        nargs = (header >> TRACE_NARGS_POS) & 0x0F;
+        id = header & TRACE_ID_MASK;
+
+        if(((header >> TRACE_SYNC_POS) != TRACE_SYNC) || (nargs > TRACE_MAX_ARGS) || (id < fmt_sec_addr) ||
+           ((id - fmt_sec_addr) >= fmt_sec_size)){
+            skipped++;
+            continue;
+        }
+
+        if(read_word(f, &stamp)){
+            break;
+        }
+        for(i = 0; i < nargs; i++){
+            if(read_word(f, &args[i])){
+                break;
+            }
+        }
+        if(i < nargs){
+            break;
+        }
+
+        /* The cycle counter wraps every 2^32 cycles, records are assumed to be closer than that */
+        if(records && (stamp < prev_stamp)){
+            wraps++;
+        }
+        prev_stamp = stamp;
+        records++;
+
+        printf("%14.6f  ", (double)((wraps << 32) | stamp) / hz);
+        print_record(&fmt_sec[id - fmt_sec_addr], args, nargs);
+        putchar('\n');
+    }
+
+    if(skipped){
+        fprintf(stderr, "%u words skipped\n", skipped);
+    }
+
+    if(f != stdin){
+        fclose(f);
+    }
+    free(fmt_sec);
+
+    return 0;
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static int load_formats(const char* path){
+
+    FILE* f = fopen(path, "rb");
+    Elf32_Ehdr ehdr;
+    Elf32_Shdr* shdr = NULL;
+    char* names = NULL;
+    uint16_t i = 0;
+    int err = 1;
+
+    if(f == NULL){
+        perror(path);
+        return 1;
+    }
+
+    if((fread(&ehdr, sizeof(ehdr), 1, f) != 1) || memcmp(ehdr.e_ident, ELFMAG, SELFMAG) ||
+       (ehdr.e_ident[EI_CLASS] != ELFCLASS32) || (ehdr.e_ident[EI_DATA] != ELFDATA2LSB) ||
+       (ehdr.e_shentsize != sizeof(Elf32_Shdr)) || (ehdr.e_shstrndx >= ehdr.e_shnum)){
+        fprintf(stderr, "%s: not an ELF32 little endian file\n", path);
+        goto out;
+    }
+
+    shdr = calloc(ehdr.e_shnum, sizeof(Elf32_Shdr));
+    if((shdr == NULL) || fseek(f, ehdr.e_shoff, SEEK_SET) ||
+       (fread(shdr, sizeof(Elf32_Shdr), ehdr.e_shnum, f) != ehdr.e_shnum)){
+        fprintf(stderr, "%s: cannot read the section headers\n", path);
+        goto out;
+    }
+
+    names = calloc(1, shdr[ehdr.e_shstrndx].sh_size + 1);
+    if((names == NULL) || fseek(f, shdr[ehdr.e_shstrndx].sh_offset, SEEK_SET) ||
+       (fread(names, 1, shdr[ehdr.e_shstrndx].sh_size, f) != shdr[ehdr.e_shstrndx].sh_size)){
+        fprintf(stderr, "%s: cannot read the section names\n", path);
+        goto out;
+    }
+
+    for(i = 0; i < ehdr.e_shnum; i++){
+        if((shdr[i].sh_name < shdr[ehdr.e_shstrndx].sh_size) && !strcmp(&names[shdr[i].sh_name], ".trace_fmt")){
+            break;
+        }
+    }
+
+    if(i == ehdr.e_shnum){
+        fprintf(stderr, "%s: no .trace_fmt section\n", path);
+        goto out;
+    }
+
+    /* One more NUL, so a corrupted section never makes a format string run past the end */
+    fmt_sec_addr = shdr[i].sh_addr;
+    fmt_sec_size = shdr[i].sh_size;
+    fmt_sec = calloc(1, fmt_sec_size + 1);
+    if((fmt_sec == NULL) || fseek(f, shdr[i].sh_offset, SEEK_SET) ||
+       (fread(fmt_sec, 1, fmt_sec_size, f) != fmt_sec_size)){
+        fprintf(stderr, "%s: cannot read the .trace_fmt section\n", path);
+        goto out;
+    }
+
+    err = 0;
+
+out:
+    free(names);
+    free(shdr);
+    fclose(f);
+
+    return err;
+}
+
+static int read_word(FILE* f, uint32_t* word){
+
+    uint8_t b[4];
+
+    if(fread(b, 1, sizeof(b), f) != sizeof(b)){
+        return 1;
+    }
+
+    *word = (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+
+    return 0;
+}
+
+static void print_record(const char* fmt, const uint32_t* args, uint32_t nargs){
+
+    char spec[16];
+    uint32_t arg = 0;
+    uint8_t len = 0;
+
+    while(*fmt != '\0'){
+
+        if(*fmt != '%'){
+            putchar(*fmt++);
+            continue;
+        }
+
+        /* Copy the flags and the width, the length modifier is dropped as all arguments are 32 bit */
+        len = 0;
+        spec[len++] = *fmt++;
+        while(((*fmt == '-') || (*fmt == '0') || ((*fmt >= '1') && (*fmt <= '9'))) && (len < sizeof(spec) - 2)){
+            spec[len++] = *fmt++;
+        }
+        while((*fmt >= '0') && (*fmt <= '9')){
+            fmt++;
+        }
+        if(*fmt == 'l'){
+            fmt++;
+        }
+        if(*fmt == '\0'){
+            break;
+        }
+        spec[len++] = *fmt;
+        spec[len] = '\0';
+
+        if(*fmt == '%'){
+            putchar('%');
+            fmt++;
+            continue;
+        }
+
+        if(arg >= nargs){
+            printf("<missing>");
+            fmt++;
+            continue;
+        }
+
+        switch(*fmt){
+            case 'd':
+            case 'i':
+                printf(spec, (int)(int32_t)args[arg]);
+                break;
+            case 'u':
+            case 'x':
+            case 'X':
+                printf(spec, (unsigned int)args[arg]);
+                break;
+            case 'c':
+                printf(spec, (int)(char)args[arg]);
+                break;
+            default:
+                printf("<%c:0x%08x>", *fmt, (unsigned int)args[arg]);
+                break;
+        }
+
+        arg++;
+        fmt++;
+    }
+}
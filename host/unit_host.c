@@ -0,0 +1,984 @@
+/*****************************************************************************************************
+* FILENAME :        unit_host.c
+*
+* DESCRIPTION :
+*       File containing the main function of the host unit tests. It runs the checks of the target
+*       independent modules one by one: the formatted output engine (src/fmt.c), the clock face
+*       formatter (src/clockfmt.c), the task scheduler (src/sched.c) with its event (src/event.c), the
+*       date and time snapshot (src/timesnap.c), the application frames (src/app.c) and the display
+*       pages of the HD44780 driver (bsp/hd44780.c). The LCD sinks and the driver write to the
+*       HD44780 emulator through the GPIO stand-in.
+*
+* NOTES :
+*       Usage: unit_host [-l] [test ...]
+*           -l  list the tests and exit.
+*           test    run only the named tests (default all of them).
+*
+*       Every test prints PASS or FAIL with its number of checks, and every failed check prints
+*       its line and expression. The exit status is 1 if any check failed, 2 for an unknown test.
+*
+*       The scheduler keeps its tasks for the whole run, so every scheduler test adds the tasks it
+*       uses and stops them before it returns; the tests can run alone or in any order.
+*
+**/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "fmt.h"
+#include "clockfmt.h"
+#include "sched.h"
+#include "event.h"
+#include "timesnap.h"
+#include "app.h"
+#include "ds1307.h"
+#include "hd44780.h"
+#include "hd44780_emu.h"
+#include "gpio_sim.h"
+#include "rcc_driver.h"
+
+#define UNIT_CHECK(cond)            unit_check((cond) ? 1 : 0, #cond, __LINE__)
+#define UNIT_CHECK_STR(got, exp)    unit_check_str((got), (exp), __LINE__)
+
+#define UNIT_MAX_EMITS              8
+#define UNIT_SNAP_PUBLISHES         200000
+
+/**
+ * Test case.
+ */
+typedef struct
+{
+    const char* name;
+    void (*fn)(void);
+}unit_test_t;
+
+/**
+ * Runs collected by the clockfmt_emit_changes callback.
+ */
+typedef struct
+{
+    uint8_t count;
+    uint8_t pos[UNIT_MAX_EMITS];
+    char str[UNIT_MAX_EMITS][CLOCKFMT_ISO8601_LEN + 1];
+}unit_emits_t;
+
+static uint32_t unit_checks = 0;
+static uint32_t unit_failures = 0;
+static char unit_sched_log[32];
+static uint8_t unit_sched_self = SCHED_INVALID_ID;
+static uint32_t unit_sched_events = 0;
+static volatile uint8_t unit_snap_done = 0;
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn unit_check
+ *
+ * @brief function to count a check and print it if it failed, called by UNIT_CHECK.
+ *
+ * @param[in] ok is 1 if the check passed.
+ * @param[in] expr is the text of the checked expression.
+ * @param[in] line is the line of the check.
+ *
+ * @return void.
+ */
+static void unit_check(int ok, const char* expr, int line);
+
+/**
+ * @fn unit_check_str
+ *
+ * @brief function to compare two strings, called by UNIT_CHECK_STR.
+ *
+ * @param[in] got is the string produced by the code under test.
+ * @param[in] exp is the expected string.
+ * @param[in] line is the line of the check.
+ *
+ * @return void.
+ */
+static void unit_check_str(const char* got, const char* exp, int line);
+
+/**
+ * @fn test_*
+ *
+ * @brief test cases, run by main in the order of unit_tests.
+ */
+static void test_fmt_integers(void);
+static void test_fmt_strings(void);
+static void test_fmt_buf_sink(void);
+static void test_fmt_lcd_sink(void);
+static void test_clockfmt_formats(void);
+static void test_clockfmt_changes(void);
+static void test_sched_order(void);
+static void test_sched_periodic(void);
+static void test_sched_wrap(void);
+static void test_sched_event(void);
+static void test_sched_limits(void);
+static void test_timesnap_sequence(void);
+static void test_timesnap_concurrent(void);
+static void test_app_frames(void);
+static void test_hd44780_pages(void);
+
+/**
+ * @fn check_fmt_int
+ *
+ * @brief function to compare the output of fmt_snprintf and of the C library for an integer.
+ *
+ * @param[in] format is a format string with a single integer conversion.
+ * @param[in] value is the argument.
+ * @param[in] line is the line of the caller.
+ *
+ * @return void.
+ */
+static void check_fmt_int(const char* format, int value, int line);
+
+/**
+ * @fn unit_lcd_flip
+ *
+ * @brief function to flip the LCD to a page and count the instructions sent.
+ *
+ * @param[in] page is the page number.
+ *
+ * @return number of instructions executed by the emulator.
+ */
+static uint32_t unit_lcd_flip(uint8_t page);
+
+/**
+ * @fn unit_emit
+ *
+ * @brief clockfmt_emit_fn_t function storing every run in a unit_emits_t.
+ */
+static void unit_emit(void* ctx, uint8_t pos, const char* str, uint8_t len);
+
+/**
+ * @fn unit_task_a, unit_task_b, unit_task_c, unit_task_self_stop
+ *
+ * @brief scheduler tasks appending their name to unit_sched_log, the last one also stops itself.
+ */
+static void unit_task_a(void);
+static void unit_task_b(void);
+static void unit_task_c(void);
+static void unit_task_self_stop(void);
+
+/**
+ * @fn unit_sched_handler
+ *
+ * @brief SCHED_EVENT handler counting the dispatches in unit_sched_events.
+ */
+static void unit_sched_handler(void);
+
+/**
+ * @fn unit_snap_publish
+ *
+ * @brief function to publish the snapshot number n, every field is derived from n.
+ */
+static void unit_snap_publish(uint32_t n);
+
+/**
+ * @fn unit_snap_writer
+ *
+ * @brief function of the thread publishing the snapshots 1 to UNIT_SNAP_PUBLISHES.
+ */
+static void* unit_snap_writer(void* arg);
+
+static const unit_test_t unit_tests[] = {
+    {"fmt_integers", test_fmt_integers},
+    {"fmt_strings", test_fmt_strings},
+    {"fmt_buf_sink", test_fmt_buf_sink},
+    {"fmt_lcd_sink", test_fmt_lcd_sink},
+    {"clockfmt_formats", test_clockfmt_formats},
+    {"clockfmt_changes", test_clockfmt_changes},
+    {"sched_order", test_sched_order},
+    {"sched_periodic", test_sched_periodic},
+    {"sched_wrap", test_sched_wrap},
+    {"sched_event", test_sched_event},
+    {"sched_limits", test_sched_limits},
+    {"timesnap_sequence", test_timesnap_sequence},
+    {"timesnap_concurrent", test_timesnap_concurrent},
+    {"app_frames", test_app_frames},
+    {"hd44780_pages", test_hd44780_pages},
+};
+
+#define UNIT_NUM_TESTS      (sizeof(unit_tests) / sizeof(unit_tests[0]))
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void hd44780_udelay(uint32_t cnt){
+
+    gpio_sim_advance((uint64_t)cnt * 1000);
+}
+
+uint32_t RCC_GetHCLKValue(void){
+
+    /* Only read by hd44780_bus_init for the weak hd44780_udelay, which is replaced above */
+    return RCC_HSI_VALUE;
+}
+
+void trace_write(uint32_t id, const uint32_t* args, uint32_t nargs){
+
+    /* The scheduler overrun messages are not checked */
+    (void)id;
+    (void)args;
+    (void)nargs;
+}
+
+int main(int argc, char* argv[]){
+
+    uint32_t failed = 0;
+    uint32_t run = 0;
+    uint32_t checks = 0;
+    uint32_t i = 0;
+    int selected = 0;
+    int opt = 0;
+    int j = 0;
+
+    while((opt = getopt(argc, argv, "l")) != -1){
+        switch(opt){
+            case 'l':
+                for(i = 0; i < UNIT_NUM_TESTS; i++){
+                    printf("%s\n", unit_tests[i].name);
+                }
+                return 0;
+            default:
+                fprintf(stderr, "usage: %s [-l] [test ...]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    for(j = optind; j < argc; j++){
+        for(i = 0; (i < UNIT_NUM_TESTS) && strcmp(argv[j], unit_tests[i].name); i++);
+        if(i == UNIT_NUM_TESTS){
+            fprintf(stderr, "unknown test: %s\n", argv[j]);
+            return 2;
+        }
+    }
+
+    for(i = 0; i < UNIT_NUM_TESTS; i++){
+        selected = (optind == argc);
+        for(j = optind; j < argc; j++){
+            selected |= !strcmp(argv[j], unit_tests[i].name);
+        }
+        if(!selected){
+            continue;
+        }
+
+        unit_checks = 0;
+        unit_failures = 0;
+        unit_tests[i].fn();
+
+        printf("%s %s (%u checks)\n", unit_failures ? "FAIL" : "PASS", unit_tests[i].name, unit_checks);
+        failed += unit_failures ? 1 : 0;
+        checks += unit_checks;
+        run++;
+    }
+
+    printf("tests: %u, checks: %u, failed: %u\n", run, checks, failed);
+
+    return failed ? 1 : 0;
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static void unit_check(int ok, const char* expr, int line){
+
+    unit_checks++;
+    if(!ok){
+        unit_failures++;
+        printf("    line %d: %s\n", line, expr);
+    }
+}
+
+static void unit_check_str(const char* got, const char* exp, int line){
+
+    unit_checks++;
+    if(strcmp(got, exp)){
+        unit_failures++;
+        printf("    line %d: \"%s\", expected \"%s\"\n", line, got, exp);
+    }
+}
+
+static void check_fmt_int(const char* format, int value, int line){
+
+    char got[32];
+    char exp[32];
+    int len = 0;
+
+    len = fmt_snprintf(got, sizeof(got), format, value);
+    snprintf(exp, sizeof(exp), format, value);
+
+    unit_check_str(got, exp, line);
+    unit_check(len == (int)strlen(exp), "fmt_snprintf length", line);
+}
+
+static void test_fmt_integers(void){
+
+    static const char* formats[] = {"%d", "%i", "%u", "%x", "%X", "%5d", "%-5d|", "%05d", "%3u", "%08x",
+                                    "%-8X|", "%010d", "%1d", "<%d>"};
+    static const int values[] = {0, 1, -1, 9, 10, 42, -42, 255, 65535, 1000000, 2147483647, (int)0x80000000};
+    const char* long_format = "%lu %lx %ld";
+    char buf[32];
+    uint32_t f = 0;
+    uint32_t v = 0;
+
+    for(f = 0; f < (sizeof(formats) / sizeof(formats[0])); f++){
+        for(v = 0; v < (sizeof(values) / sizeof(values[0])); v++){
+            check_fmt_int(formats[f], values[v], __LINE__);
+        }
+    }
+
+    /* int and long have the same size on the target, so the 'l' arguments are passed as int here */
+    fmt_snprintf(buf, sizeof(buf), long_format, 4000000000U, 0xDEADBEEFU, -7);
+    UNIT_CHECK_STR(buf, "4000000000 deadbeef -7");
+}
+
+static void test_fmt_strings(void){
+
+    const char* zero_format = "%06s|%c|%3c|%-3c|%03c";
+    const char* null_str = NULL;
+    char buf[32];
+
+    fmt_snprintf(buf, sizeof(buf), "%s|%6s|%-6s|", "abc", "abc", "abc");
+    UNIT_CHECK_STR(buf, "abc|   abc|abc   |");
+
+    /* The zero flag only applies to numbers */
+    fmt_snprintf(buf, sizeof(buf), zero_format, "ab", 'x', 'y', 'z', 'w');
+    UNIT_CHECK_STR(buf, "    ab|x|  y|z  |  w");
+
+    fmt_snprintf(buf, sizeof(buf), "%s", null_str);
+    UNIT_CHECK_STR(buf, "(null)");
+
+    fmt_snprintf(buf, sizeof(buf), "100%% %s", "");
+    UNIT_CHECK_STR(buf, "100% ");
+}
+
+static void test_fmt_buf_sink(void){
+
+    const char* unsupported_format = "%q %5f abc%";
+    fmt_buf_sink_t sink;
+    char buf[8];
+    char big[32];
+    int count = 0;
+
+    /* Truncated, always NUL terminated, the length stored is returned */
+    count = fmt_snprintf(buf, sizeof(buf), "%s", "0123456789");
+    UNIT_CHECK(count == 7);
+    UNIT_CHECK_STR(buf, "0123456");
+
+    count = fmt_snprintf(buf, 1, "%d", 12345);
+    UNIT_CHECK(count == 0);
+    UNIT_CHECK_STR(buf, "");
+
+    buf[0] = 'x';
+    count = fmt_snprintf(buf, 0, "%d", 12345);
+    UNIT_CHECK((count == 0) && (buf[0] == 'x'));
+
+    /* fmt_printf appends and returns the characters formatted, also the ones which did not fit */
+    fmt_buf_sink_init(&sink, buf, sizeof(buf));
+    UNIT_CHECK(fmt_printf(&sink.sink, "%u:", 12) == 3);
+    UNIT_CHECK(fmt_printf(&sink.sink, "%02u", 5) == 2);
+    UNIT_CHECK_STR(buf, "12:05");
+    UNIT_CHECK(fmt_printf(&sink.sink, "%s", "abcdef") == 6);
+    UNIT_CHECK_STR(buf, "12:05ab");
+    UNIT_CHECK(sink.len == 7);
+
+    /* Unsupported conversions are printed as is, a '%' at the end is dropped */
+    fmt_buf_sink_init(&sink, big, sizeof(big));
+    count = fmt_printf(&sink.sink, unsupported_format);
+    UNIT_CHECK_STR(big, "%q %f abc");
+    UNIT_CHECK(count == 9);
+}
+
+static void test_fmt_lcd_sink(void){
+
+    fmt_lcd_sink_t sink;
+    char line[HD44780_EMU_COLUMNS + 1];
+
+    gpio_sim_reset();
+    hd44780_init();
+
+    fmt_lcd_sink_init(&sink, 1, 1);
+    fmt_printf(&sink.sink, "%02u:%02u", 9, 5);
+    hd44780_emu_get_line(1, line);
+    UNIT_CHECK_STR(line, "09:05           ");
+
+    /* Every flush continues after the previous output */
+    fmt_printf(&sink.sink, " %s", "AM");
+    hd44780_emu_get_line(1, line);
+    UNIT_CHECK_STR(line, "09:05 AM        ");
+
+    /* Clipped at the end of the 16 column page */
+    fmt_lcd_sink_init(&sink, 2, 11);
+    UNIT_CHECK(fmt_printf(&sink.sink, "%s", "0123456789") == 10);
+    hd44780_emu_get_line(2, line);
+    UNIT_CHECK_STR(line, "          012345");
+
+    /* The last page is clipped at the 40th DDRAM column, not at a 16 column boundary */
+    fmt_lcd_sink_init(&sink, 1, 33);
+    UNIT_CHECK(fmt_printf(&sink.sink, "%s", "ABCDEFGHIJKLMNOP") == 16);
+    hd44780_display_shift(HD44780_SHIFT_RIGHT);
+    hd44780_emu_get_line(1, line);
+    UNIT_CHECK_STR(line, "H09:05 AM       ");
+    hd44780_emu_get_line(2, line);
+    UNIT_CHECK_STR(line, "           01234");
+    hd44780_display_return_home();
+
+    UNIT_CHECK(hd44780_emu_violations() == 0);
+}
+
+static void test_clockfmt_formats(void){
+
+    RTC_time_t time = {5, 59, 23, T_FORMAT_24HRS};
+    RTC_date_t date = {17, 7, 21, 6};
+    char buf[CLOCKFMT_ISO8601_LEN + 1];
+
+    UNIT_CHECK(clockfmt_time24(&time, &date, buf) == CLOCKFMT_TIME24_LEN);
+    UNIT_CHECK_STR(buf, "23:59:05");
+    UNIT_CHECK(clockfmt_time12(&time, &date, buf) == CLOCKFMT_TIME12_LEN);
+    UNIT_CHECK_STR(buf, "11:59:05 PM");
+    UNIT_CHECK(clockfmt_date(&time, &date, buf) == CLOCKFMT_DATE_LEN);
+    UNIT_CHECK_STR(buf, "17/07/21");
+    UNIT_CHECK(clockfmt_iso8601(&time, &date, buf) == CLOCKFMT_ISO8601_LEN);
+    UNIT_CHECK_STR(buf, "2021-07-17T23:59:05");
+    UNIT_CHECK(clockfmt_weekday(&time, &date, buf) == CLOCKFMT_WEEKDAY_LEN);
+    UNIT_CHECK_STR(buf, "Sat");
+
+    /* Midnight and noon in both modes */
+    time.hours = 0;
+    clockfmt_time12(&time, &date, buf);
+    UNIT_CHECK_STR(buf, "12:59:05 AM");
+    time.hours = 12;
+    clockfmt_time12(&time, &date, buf);
+    UNIT_CHECK_STR(buf, "12:59:05 PM");
+
+    time.time_format = T_FORMAT_12HRS_AM;
+    clockfmt_time24(&time, &date, buf);
+    UNIT_CHECK_STR(buf, "00:59:05");
+    clockfmt_time12(&time, &date, buf);
+    UNIT_CHECK_STR(buf, "12:59:05 AM");
+
+    time.time_format = T_FORMAT_12HRS_PM;
+    clockfmt_time24(&time, &date, buf);
+    UNIT_CHECK_STR(buf, "12:59:05");
+    time.hours = 7;
+    clockfmt_iso8601(&time, &date, buf);
+    UNIT_CHECK_STR(buf, "2021-07-17T19:59:05");
+
+    /* Days out of range are shown as ??? */
+    date.day = MONDAY;
+    clockfmt_weekday(&time, &date, buf);
+    UNIT_CHECK_STR(buf, "Mon");
+    date.day = SUNDAY;
+    clockfmt_weekday(&time, &date, buf);
+    UNIT_CHECK_STR(buf, "Sun");
+    date.day = 0;
+    clockfmt_weekday(&time, &date, buf);
+    UNIT_CHECK_STR(buf, "???");
+    date.day = SUNDAY + 1;
+    clockfmt_weekday(&time, &date, buf);
+    UNIT_CHECK_STR(buf, "???");
+}
+
+static void test_clockfmt_changes(void){
+
+    unit_emits_t emits;
+    char shown[CLOCKFMT_TIME24_LEN + 1];
+
+    /* Nothing changed */
+    memset(&emits, 0, sizeof(emits));
+    strcpy(shown, "12:00:00");
+    UNIT_CHECK(clockfmt_emit_changes(shown, "12:00:00", CLOCKFMT_TIME24_LEN, unit_emit, &emits) == 0);
+    UNIT_CHECK(emits.count == 0);
+
+    /* A single digit */
+    memset(&emits, 0, sizeof(emits));
+    UNIT_CHECK(clockfmt_emit_changes(shown, "12:00:09", CLOCKFMT_TIME24_LEN, unit_emit, &emits) == 1);
+    UNIT_CHECK((emits.count == 1) && (emits.pos[0] == 7));
+    UNIT_CHECK_STR(emits.str[0], "9");
+    UNIT_CHECK_STR(shown, "12:00:09");
+
+    /* Runs more than CLOCKFMT_MERGE_GAP apart are sent separately */
+    memset(&emits, 0, sizeof(emits));
+    UNIT_CHECK(clockfmt_emit_changes(shown, "12:01:00", CLOCKFMT_TIME24_LEN, unit_emit, &emits) == 2);
+    UNIT_CHECK((emits.count == 2) && (emits.pos[0] == 4) && (emits.pos[1] == 7));
+    UNIT_CHECK_STR(emits.str[0], "1");
+    UNIT_CHECK_STR(emits.str[1], "0");
+
+    /* Runs CLOCKFMT_MERGE_GAP apart are merged */
+    memset(&emits, 0, sizeof(emits));
+    UNIT_CHECK(clockfmt_emit_changes(shown, "12:02:19", CLOCKFMT_TIME24_LEN, unit_emit, &emits) == 4);
+    UNIT_CHECK((emits.count == 1) && (emits.pos[0] == 4));
+    UNIT_CHECK_STR(emits.str[0], "2:19");
+
+    /* Every character */
+    memset(&emits, 0, sizeof(emits));
+    UNIT_CHECK(clockfmt_emit_changes(shown, "01:13:20", CLOCKFMT_TIME24_LEN, unit_emit, &emits) == 8);
+    UNIT_CHECK((emits.count == 1) && (emits.pos[0] == 0));
+    UNIT_CHECK_STR(shown, "01:13:20");
+}
+
+static void test_sched_order(void){
+
+    uint8_t a = sched_add("a", unit_task_a, 0);
+    uint8_t b = sched_add("b", unit_task_b, 0);
+    uint8_t c = sched_add("c", unit_task_c, 0);
+    sched_stats_t stats;
+
+    UNIT_CHECK((a != SCHED_INVALID_ID) && (b != SCHED_INVALID_ID) && (c != SCHED_INVALID_ID));
+    UNIT_CHECK(sched_get_idle_ticks() == SCHED_IDLE_FOREVER);
+
+    unit_sched_log[0] = '\0';
+    sched_start(a, 5);
+    sched_start(b, 2);
+    sched_start(c, 5);
+    UNIT_CHECK(sched_get_idle_ticks() == 2);
+
+    sched_tick();
+    UNIT_CHECK(sched_run() == 0);
+    UNIT_CHECK(sched_get_idle_ticks() == 1);
+
+    sched_tick();
+    UNIT_CHECK(sched_run() == 1);
+    UNIT_CHECK_STR(unit_sched_log, "b");
+
+    /* Same deadline: in start order, one-shot tasks are not queued again */
+    sched_advance(3);
+    UNIT_CHECK(sched_get_idle_ticks() == 0);
+    UNIT_CHECK(sched_run() == 2);
+    UNIT_CHECK_STR(unit_sched_log, "bac");
+    UNIT_CHECK(sched_get_idle_ticks() == SCHED_IDLE_FOREVER);
+
+    /* Restarting a queued task moves it, stopping it removes it */
+    sched_start(a, 1);
+    sched_start(b, 3);
+    sched_start(a, 4);
+    UNIT_CHECK(sched_get_idle_ticks() == 3);
+    sched_stop(b);
+    sched_stop(b);
+    UNIT_CHECK(sched_get_idle_ticks() == 4);
+    sched_advance(4);
+    UNIT_CHECK(sched_run() == 1);
+    UNIT_CHECK_STR(unit_sched_log, "baca");
+
+    UNIT_CHECK(sched_get_stats(a, &stats) == 0);
+    UNIT_CHECK((stats.runs == 2) && (stats.period_ms == 0) && !strcmp(stats.name, "a"));
+    UNIT_CHECK(sched_get_idle_ticks() == SCHED_IDLE_FOREVER);
+}
+
+static void test_sched_periodic(void){
+
+    uint8_t p = sched_add("p", unit_task_a, 10);
+    uint8_t s = sched_add("s", unit_task_self_stop, 1);
+    sched_stats_t stats;
+
+    UNIT_CHECK((p != SCHED_INVALID_ID) && (s != SCHED_INVALID_ID));
+
+    unit_sched_log[0] = '\0';
+    sched_start(p, 0);
+    UNIT_CHECK(sched_run() == 1);
+    UNIT_CHECK(sched_get_idle_ticks() == 10);
+
+    /* On time */
+    sched_advance(10);
+    UNIT_CHECK(sched_run() == 1);
+    UNIT_CHECK(sched_get_idle_ticks() == 10);
+
+    /* Late by less than a period: the next deadline keeps the phase */
+    sched_advance(14);
+    UNIT_CHECK(sched_run() == 1);
+    UNIT_CHECK(sched_get_idle_ticks() == 6);
+
+    /* Late by a whole period: one run and one overrun, the next deadline is a period from now */
+    sched_advance(6 + 25);
+    UNIT_CHECK(sched_run() == 1);
+    UNIT_CHECK(sched_get_idle_ticks() == 10);
+    UNIT_CHECK(sched_get_stats(p, &stats) == 0);
+    UNIT_CHECK((stats.runs == 4) && (stats.overruns == 1) && (stats.period_ms == 10));
+    UNIT_CHECK_STR(unit_sched_log, "aaaa");
+
+    sched_stop(p);
+    UNIT_CHECK(sched_get_idle_ticks() == SCHED_IDLE_FOREVER);
+
+    /* A periodic task can stop itself */
+    unit_sched_self = s;
+    sched_start(s, 0);
+    UNIT_CHECK(sched_run() == 1);
+    sched_advance(5);
+    UNIT_CHECK(sched_run() == 0);
+    UNIT_CHECK_STR(unit_sched_log, "aaaas");
+    UNIT_CHECK(sched_get_idle_ticks() == SCHED_IDLE_FOREVER);
+}
+
+static void test_sched_wrap(void){
+
+    uint8_t a = sched_add("wrap", unit_task_a, 0);
+    uint8_t b = sched_add("wrap2", unit_task_b, 0);
+
+    UNIT_CHECK((a != SCHED_INVALID_ID) && (b != SCHED_INVALID_ID));
+
+    /* Deadlines past the wraparound of the tick counter */
+    sched_advance(0xFFFFFFF0U - sched_get_ticks());
+    unit_sched_log[0] = '\0';
+    sched_start(a, 0x20);
+    sched_start(b, 0x08);
+    UNIT_CHECK(sched_get_idle_ticks() == 0x08);
+
+    sched_advance(0x1F);
+    UNIT_CHECK(sched_get_ticks() == 0x0F);
+    UNIT_CHECK(sched_run() == 1);
+    UNIT_CHECK(sched_get_idle_ticks() == 1);
+    sched_tick();
+    UNIT_CHECK(sched_run() == 1);
+    UNIT_CHECK_STR(unit_sched_log, "ba");
+    UNIT_CHECK(sched_get_idle_ticks() == SCHED_IDLE_FOREVER);
+}
+
+static void test_sched_event(void){
+
+    uint8_t a = sched_add("event", unit_task_a, 0);
+
+    UNIT_CHECK(a != SCHED_INVALID_ID);
+
+    /* Drop the events posted by the other tests */
+    event_register(SCHED_EVENT, unit_sched_handler);
+    event_dispatch();
+    unit_sched_events = 0;
+    unit_sched_log[0] = '\0';
+
+    /* Posted by the tick which reaches the deadline, and by every tick until the task runs */
+    sched_start(a, 2);
+    UNIT_CHECK(!event_is_pending());
+    sched_tick();
+    UNIT_CHECK(!event_is_pending());
+    sched_tick();
+    UNIT_CHECK(event_is_pending());
+    sched_tick();
+    UNIT_CHECK(event_dispatch() == 1);
+    UNIT_CHECK(unit_sched_events == 1);
+    UNIT_CHECK(event_get_coalesced() >= 1);
+    UNIT_CHECK(sched_run() == 1);
+    sched_tick();
+    UNIT_CHECK(!event_is_pending());
+
+    /* Posted at once by a start without delay and by an advance past the deadline */
+    sched_start(a, 0);
+    UNIT_CHECK(event_dispatch() == 1);
+    UNIT_CHECK(sched_run() == 1);
+    sched_start(a, 10);
+    sched_advance(9);
+    UNIT_CHECK(!event_is_pending());
+    sched_advance(1);
+    UNIT_CHECK(event_dispatch() == 1);
+    UNIT_CHECK(sched_run() == 1);
+    UNIT_CHECK_STR(unit_sched_log, "aaa");
+    UNIT_CHECK(unit_sched_events == 3);
+
+    event_register(SCHED_EVENT, NULL);
+}
+
+static void test_sched_limits(void){
+
+    sched_stats_t stats;
+    uint8_t id = 0;
+
+    /* Every task left is taken, then sched_add fails */
+    while((id = sched_add("fill", unit_task_a, 0)) != SCHED_INVALID_ID){
+        UNIT_CHECK(id < SCHED_MAX_TASKS);
+    }
+    UNIT_CHECK(sched_get_stats(SCHED_MAX_TASKS - 1, &stats) == 0);
+    UNIT_CHECK(sched_get_stats(SCHED_MAX_TASKS, &stats) == 1);
+    UNIT_CHECK(sched_get_stats(SCHED_INVALID_ID, &stats) == 1);
+
+    /* Invalid ids are ignored */
+    sched_start(SCHED_MAX_TASKS, 0);
+    sched_start(SCHED_INVALID_ID, 0);
+    sched_stop(SCHED_INVALID_ID);
+    UNIT_CHECK(sched_get_idle_ticks() == SCHED_IDLE_FOREVER);
+    UNIT_CHECK(sched_run() == 0);
+}
+
+static void test_timesnap_sequence(void){
+
+    RTC_time_t time = {1, 2, 3, T_FORMAT_24HRS};
+    RTC_date_t date = {4, 5, 6, 7};
+    RTC_time_t got_time;
+    RTC_date_t got_date;
+    uint32_t seq = timesnap_read(&got_time, &got_date);
+
+    timesnap_publish(&time, &date);
+    UNIT_CHECK(timesnap_read(&got_time, &got_date) == seq + 1);
+    UNIT_CHECK(!memcmp(&got_time, &time, sizeof(time)) && !memcmp(&got_date, &date, sizeof(date)));
+
+    /* Reads do not move the sequence */
+    UNIT_CHECK(timesnap_read(&got_time, &got_date) == seq + 1);
+
+    time.seconds = 59;
+    date.year = 99;
+    timesnap_publish(&time, &date);
+    UNIT_CHECK(timesnap_read(&got_time, &got_date) == seq + 2);
+    UNIT_CHECK((got_time.seconds == 59) && (got_date.year == 99) && (got_time.hours == 3));
+}
+
+static void test_timesnap_concurrent(void){
+
+    RTC_time_t time;
+    RTC_date_t date;
+    pthread_t thread;
+    uint32_t seq = 0;
+    uint32_t last = 0;
+    uint32_t torn = 0;
+    uint32_t backwards = 0;
+    uint32_t reads = 0;
+
+    /* The reader checks that every snapshot is one publication, and that they never go back */
+    unit_snap_publish(0);
+    last = timesnap_read(&time, &date);
+    unit_snap_done = 0;
+    UNIT_CHECK(pthread_create(&thread, NULL, unit_snap_writer, NULL) == 0);
+
+    while(!unit_snap_done){
+        seq = timesnap_read(&time, &date);
+        torn += ((time.minutes != time.seconds) || (time.hours != (uint8_t)(time.seconds + 1)) ||
+                 (date.date != (uint8_t)(time.seconds + 2)) || (date.year != (uint8_t)(time.seconds + 3))) ? 1 : 0;
+        backwards += (seq < last) ? 1 : 0;
+        last = seq;
+        reads++;
+        if((reads & 0xFF) == 0){
+            usleep(0);
+        }
+    }
+    pthread_join(thread, NULL);
+
+    UNIT_CHECK(torn == 0);
+    UNIT_CHECK(backwards == 0);
+    UNIT_CHECK(timesnap_read(&time, &date) >= UNIT_SNAP_PUBLISHES);
+}
+
+static void test_app_frames(void){
+
+    RTC_time_t time = {0, 0, 15, T_FORMAT_24HRS};
+    RTC_date_t date = {17, 7, 21, 6};
+    char buf[64];
+    char line[HD44780_EMU_COLUMNS + 1];
+    fmt_buf_sink_t sink;
+
+    /* The console and the LCD follow the hour mode of the RTC */
+    fmt_buf_sink_init(&sink, buf, sizeof(buf));
+    app_console_show(&sink.sink, &time, &date);
+    UNIT_CHECK_STR(buf, "Current time: 15:00:00\nCurrent date: 17/07/21 <Sat>\n");
+
+    gpio_sim_reset();
+    hd44780_init();
+    app_lcd_invalidate();
+    app_lcd_show(&time, &date);
+    hd44780_emu_get_line(1, line);
+    UNIT_CHECK_STR(line, "15:00:00        ");
+    hd44780_emu_get_line(2, line);
+    UNIT_CHECK_STR(line, "17/07/21<Sat>   ");
+
+    time.hours = 3;
+    time.time_format = T_FORMAT_12HRS_PM;
+    fmt_buf_sink_init(&sink, buf, sizeof(buf));
+    app_console_show(&sink.sink, &time, &date);
+    UNIT_CHECK_STR(buf, "Current time: 03:00:00 PM\nCurrent date: 17/07/21 <Sat>\n");
+
+    app_lcd_show(&time, &date);
+    hd44780_emu_get_line(1, line);
+    UNIT_CHECK_STR(line, "03:00:00 PM     ");
+
+    UNIT_CHECK(hd44780_emu_violations() == 0);
+}
+
+static void test_hd44780_pages(void){
+
+    char line[HD44780_EMU_COLUMNS + 1];
+    uint8_t i = 0;
+
+    gpio_sim_reset();
+    hd44780_init();
+
+    /* Page 0 is shown after the init, page 1 is rendered off-screen */
+    UNIT_CHECK(hd44780_page_get_hidden() == 1);
+    hd44780_page_set_cursor(0, 1, 1);
+    hd44780_print_string("page 0, row 1   ");
+    hd44780_page_set_cursor(0, 2, 1);
+    hd44780_print_string("page 0, row 2   ");
+    hd44780_page_set_cursor(1, 1, 1);
+    hd44780_print_string("page 1, row 1   ");
+    hd44780_page_set_cursor(1, 2, 1);
+    hd44780_print_string("page 1, row 2   ");
+    hd44780_set_cursor(1, 33);
+    hd44780_print_string("abcdefgh");
+    hd44780_emu_get_line(1, line);
+    UNIT_CHECK_STR(line, "page 0, row 1   ");
+
+    /* 16 shifts either way, not 24 the other way */
+    UNIT_CHECK(unit_lcd_flip(1) == 16);
+    hd44780_emu_get_line(1, line);
+    UNIT_CHECK_STR(line, "page 1, row 1   ");
+    hd44780_emu_get_line(2, line);
+    UNIT_CHECK_STR(line, "page 1, row 2   ");
+    UNIT_CHECK(hd44780_page_get_hidden() == 0);
+    UNIT_CHECK(unit_lcd_flip(1) == 0);
+
+    UNIT_CHECK(unit_lcd_flip(0) == 16);
+    hd44780_emu_get_line(1, line);
+    UNIT_CHECK_STR(line, "page 0, row 1   ");
+    hd44780_emu_get_line(2, line);
+    UNIT_CHECK_STR(line, "page 0, row 2   ");
+    UNIT_CHECK(hd44780_page_get_hidden() == 1);
+
+    /* The window wraps around the 40 columns: one column right shows the 40th column first */
+    hd44780_display_shift(HD44780_SHIFT_RIGHT);
+    hd44780_emu_get_line(1, line);
+    UNIT_CHECK_STR(line, "hpage 0, row 1  ");
+    UNIT_CHECK(hd44780_page_get_hidden() == 1);
+
+    /* 17 shifts left through the wrap, not 23 right */
+    UNIT_CHECK(unit_lcd_flip(1) == 17);
+    hd44780_emu_get_line(1, line);
+    UNIT_CHECK_STR(line, "page 1, row 1   ");
+    UNIT_CHECK(hd44780_page_get_hidden() == 0);
+
+    /* Half way to the end of the line page 1 is still the closest one, then page 0 */
+    for(i = 0; i < 8; i++){
+        hd44780_display_shift(HD44780_SHIFT_LEFT);
+    }
+    hd44780_emu_get_line(1, line);
+    UNIT_CHECK_STR(line, "row 1   abcdefgh");
+    UNIT_CHECK(hd44780_page_get_hidden() == 0);
+    for(i = 0; i < 8; i++){
+        hd44780_display_shift(HD44780_SHIFT_LEFT);
+    }
+    hd44780_emu_get_line(1, line);
+    UNIT_CHECK_STR(line, "abcdefghpage 0, ");
+    UNIT_CHECK(hd44780_page_get_hidden() == 1);
+
+    /* 8 shifts left through the wrap */
+    UNIT_CHECK(unit_lcd_flip(0) == 8);
+    hd44780_emu_get_line(1, line);
+    UNIT_CHECK_STR(line, "page 0, row 1   ");
+    UNIT_CHECK(hd44780_page_get_hidden() == 1);
+
+    /* Return home cancels the shift and keeps the content */
+    UNIT_CHECK(unit_lcd_flip(1) == 16);
+    hd44780_display_return_home();
+    hd44780_emu_get_line(1, line);
+    UNIT_CHECK_STR(line, "page 0, row 1   ");
+    UNIT_CHECK(hd44780_page_get_hidden() == 1);
+    UNIT_CHECK(unit_lcd_flip(0) == 0);
+    UNIT_CHECK(unit_lcd_flip(1) == 16);
+
+    /* Clear cancels the shift too */
+    hd44780_display_clear();
+    hd44780_emu_get_line(1, line);
+    UNIT_CHECK_STR(line, "                ");
+    UNIT_CHECK(hd44780_page_get_hidden() == 1);
+    UNIT_CHECK(unit_lcd_flip(0) == 0);
+    UNIT_CHECK(unit_lcd_flip(1) == 16);
+    UNIT_CHECK(unit_lcd_flip(0) == 16);
+
+    /* The marquee fills the 40 columns of its row, padded with spaces */
+    hd44780_marquee_load(2, "The quick brown fox jumps over the dog");
+    hd44780_emu_get_line(2, line);
+    UNIT_CHECK_STR(line, "The quick brown ");
+    for(i = 0; i < 30; i++){
+        hd44780_display_shift(HD44780_SHIFT_LEFT);
+    }
+    hd44780_emu_get_line(2, line);
+    UNIT_CHECK_STR(line, " the dog  The qu");
+    hd44780_emu_get_line(1, line);
+    UNIT_CHECK_STR(line, "                ");
+    hd44780_display_return_home();
+
+    UNIT_CHECK(hd44780_emu_violations() == 0);
+}
+
+static uint32_t unit_lcd_flip(uint8_t page){
+
+    hd44780_emu_stats_t stats;
+
+    hd44780_emu_frame_begin(gpio_sim_now());
+    hd44780_page_flip(page);
+    hd44780_emu_frame_end(gpio_sim_now(), &stats);
+
+    return stats.commands;
+}
+
+static void unit_emit(void* ctx, uint8_t pos, const char* str, uint8_t len){
+
+    unit_emits_t* emits = (unit_emits_t*)ctx;
+
+    if(emits->count < UNIT_MAX_EMITS){
+        emits->pos[emits->count] = pos;
+        memcpy(emits->str[emits->count], str, len);
+        emits->str[emits->count][len] = '\0';
+    }
+    emits->count++;
+}
+
+static void unit_task_a(void){
+
+    strcat(unit_sched_log, "a");
+}
+
+static void unit_task_b(void){
+
+    strcat(unit_sched_log, "b");
+}
+
+static void unit_task_c(void){
+
+    strcat(unit_sched_log, "c");
+}
+
+static void unit_task_self_stop(void){
+
+    strcat(unit_sched_log, "s");
+    sched_stop(unit_sched_self);
+}
+
+static void unit_sched_handler(void){
+
+    unit_sched_events++;
+}
+
+static void unit_snap_publish(uint32_t n){
+
+    RTC_time_t time;
+    RTC_date_t date;
+
+    time.seconds = (uint8_t)n;
+    time.minutes = (uint8_t)n;
+    time.hours = (uint8_t)(n + 1);
+    time.time_format = T_FORMAT_24HRS;
+    date.date = (uint8_t)(n + 2);
+    date.month = 1;
+    date.year = (uint8_t)(n + 3);
+    date.day = 1;
+    timesnap_publish(&time, &date);
+}
+
+static void* unit_snap_writer(void* arg){
+
+    uint32_t n = 0;
+
+    (void)arg;
+
+    for(n = 1; n <= UNIT_SNAP_PUBLISHES; n++){
+        unit_snap_publish(n);
+        if((n & 0xFF) == 0){
+            usleep(0);
+        }
+    }
+    unit_snap_done = 1;
+
+    return NULL;
+}
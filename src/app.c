@@ -0,0 +1,149 @@
+/*****************************************************************************************************
+* FILENAME :        app.c
+*
+* DESCRIPTION :
+*       File containing the application frames: the date and time shown in the LCD and in the
+*       console.
+*
+* PUBLIC FUNCTIONS :
+*       void    app_lcd_show(const RTC_time_t* time, const RTC_date_t* date)
+*       void    app_lcd_render(const RTC_time_t* time, const RTC_date_t* date, app_lcd_frame_t* frame)
+*       void    app_lcd_write(const app_lcd_frame_t* frame)
+*       void    app_lcd_invalidate(void)
+*       void    app_console_show(fmt_sink_t* sink, const RTC_time_t* time, const RTC_date_t* date)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+**/
+
+#include "app.h"
+#include "hd44780.h"
+#include "clockfmt.h"
+#include "fmt.h"
+#include "prof.h"
+#include <stdint.h>
+
+/* LCD date line, format "dd/mm/yy<Day>", the time line is clockfmt_time12 or clockfmt_time24 */
+CLOCKFMT_DEFINE(lcd_date_line, CLOCKFMT_DAY CLOCKFMT_LIT('/') CLOCKFMT_MON CLOCKFMT_LIT('/') CLOCKFMT_YY
+                               CLOCKFMT_LIT('<') CLOCKFMT_WDAY CLOCKFMT_LIT('>'))
+
+/* Characters shown in the LCD, blank after the display clear */
+static char lcd_shown[2][HD44780_COLUMNS] = {
+    {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '},
+    {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '}
+};
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn lcd_emit
+ *
+ * @brief function to print a run of characters of an LCD row, called by clockfmt_emit_changes.
+ *
+ * @param[in] ctx is the row number (1 to 2).
+ * @param[in] pos is the position of the first character in the row (0 to 15).
+ * @param[in] str is the first character.
+ * @param[in] len is the number of characters.
+ *
+ * @return void.
+ */
+static void lcd_emit(void* ctx, uint8_t pos, const char* str, uint8_t len);
+
+/**
+ * @fn lcd_pad_row
+ *
+ * @brief function to fill the end of a row with blanks.
+ *
+ * @param[in] row is the row content, len characters are set.
+ * @param[in] len is the number of characters set.
+ *
+ * @return void.
+ */
+static void lcd_pad_row(char* row, uint8_t len);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void app_lcd_show(const RTC_time_t* time, const RTC_date_t* date){
+
+    app_lcd_frame_t frame;
+
+    app_lcd_render(time, date, &frame);
+    app_lcd_write(&frame);
+}
+
+void app_lcd_render(const RTC_time_t* time, const RTC_date_t* date, app_lcd_frame_t* frame){
+
+    if(time->time_format == T_FORMAT_24HRS){
+        lcd_pad_row(frame->rows[0], clockfmt_time24(time, date, frame->rows[0]));
+    }
+    else{
+        lcd_pad_row(frame->rows[0], clockfmt_time12(time, date, frame->rows[0]));
+    }
+    lcd_pad_row(frame->rows[1], lcd_date_line(time, date, frame->rows[1]));
+}
+
+void app_lcd_write(const app_lcd_frame_t* frame){
+
+    clockfmt_emit_changes(lcd_shown[0], frame->rows[0], HD44780_COLUMNS, lcd_emit, (void*)(uintptr_t)1);
+    clockfmt_emit_changes(lcd_shown[1], frame->rows[1], HD44780_COLUMNS, lcd_emit, (void*)(uintptr_t)2);
+}
+
+void app_lcd_invalidate(void){
+
+    uint8_t i = 0;
+
+    /* No line has a null character, so every character differs */
+    for(i = 0; i < HD44780_COLUMNS; i++){
+        lcd_shown[0][i] = '\0';
+        lcd_shown[1][i] = '\0';
+    }
+}
+
+void app_console_show(fmt_sink_t* sink, const RTC_time_t* time, const RTC_date_t* date){
+
+    char time_str[CLOCKFMT_TIME12_LEN + 1];
+    char date_str[CLOCKFMT_DATE_LEN + 1];
+    char day_str[CLOCKFMT_WEEKDAY_LEN + 1];
+
+    if(time->time_format == T_FORMAT_24HRS){
+        clockfmt_time24(time, date, time_str);
+    }
+    else{
+        clockfmt_time12(time, date, time_str);
+    }
+    clockfmt_date(time, date, date_str);
+    clockfmt_weekday(time, date, day_str);
+
+    fmt_printf(sink, "Current time: %s\n", time_str);
+    fmt_printf(sink, "Current date: %s <%s>\n", date_str, day_str);
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static void lcd_emit(void* ctx, uint8_t pos, const char* str, uint8_t len){
+
+    char run[HD44780_COLUMNS + 1];
+    uint8_t i = 0;
+
+    for(i = 0; i < len; i++){
+        run[i] = str[i];
+    }
+    run[len] = '\0';
+
+    hd44780_set_cursor((uint8_t)(uintptr_t)ctx, pos + 1);
+    PROF_CALL("hd44780_print_string", hd44780_print_string(run));
+}
+
+static void lcd_pad_row(char* row, uint8_t len){
+
+    for(; len < HD44780_COLUMNS; len++){
+        row[len] = ' ';
+    }
+}
@@ -0,0 +1,110 @@
+/*****************************************************************************************************
+* FILENAME :        app.h
+*
+* DESCRIPTION :
+*       Header file containing the application frames: the date and time shown in the LCD and in the
+*       console.
+*
+* PUBLIC FUNCTIONS :
+*       void    app_lcd_show(const RTC_time_t* time, const RTC_date_t* date)
+*       void    app_lcd_render(const RTC_time_t* time, const RTC_date_t* date, app_lcd_frame_t* frame)
+*       void    app_lcd_write(const app_lcd_frame_t* frame)
+*       void    app_lcd_invalidate(void)
+*       void    app_console_show(fmt_sink_t* sink, const RTC_time_t* time, const RTC_date_t* date)
+*
+* NOTES :
+*       These functions only use the BSP (hd44780.h) and the formatters, so the same code runs in the
+*       target tasks (src/main.c) and in the host build (host/app_host.c).
+*
+*       app_lcd_show is app_lcd_render followed by app_lcd_write, the benchmark (src/bench.c) calls
+*       them one by one to time every stage.
+*
+**/
+
+#ifndef APP_H
+#define APP_H
+
+#include <stdint.h>
+#include "ds1307.h"
+#include "fmt.h"
+#include "hd44780.h"
+
+/**
+ * LCD content, one row per line, blank padded and not null terminated.
+ */
+typedef struct
+{
+    char rows[2][HD44780_COLUMNS];
+}app_lcd_frame_t;
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn app_lcd_show
+ *
+ * @brief function to print a date and time in the LCD, format "hh:mm:ss AM" ("hh:mm:ss" if the
+ *        time is in 24 hours format) in the first row and "dd/mm/yy<Day>" in the second one. Only
+ *        the characters which changed since the last call are sent.
+ *
+ * @param[in] time is the time to show.
+ * @param[in] date is the date to show.
+ *
+ * @return void
+ *
+ * @note the LCD must be blank (display clear) before the first call.
+ */
+void app_lcd_show(const RTC_time_t* time, const RTC_date_t* date);
+
+/**
+ * @fn app_lcd_render
+ *
+ * @brief function to format the LCD content of a date and time, as app_lcd_show, without sending
+ *        anything to the LCD.
+ *
+ * @param[in] time is the time to show.
+ * @param[in] date is the date to show.
+ * @param[out] frame is the LCD content.
+ *
+ * @return void
+ */
+void app_lcd_render(const RTC_time_t* time, const RTC_date_t* date, app_lcd_frame_t* frame);
+
+/**
+ * @fn app_lcd_write
+ *
+ * @brief function to send to the LCD the characters of a frame which changed since the last write.
+ *
+ * @param[in] frame is the LCD content, from app_lcd_render.
+ *
+ * @return void
+ */
+void app_lcd_write(const app_lcd_frame_t* frame);
+
+/**
+ * @fn app_lcd_invalidate
+ *
+ * @brief function to forget the LCD content, the next write sends every character.
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+void app_lcd_invalidate(void);
+
+/**
+ * @fn app_console_show
+ *
+ * @brief function to print a date and time in the console, one line each, the time as "hh:mm:ss AM"
+ *        ("hh:mm:ss" if the time is in 24 hours format).
+ *
+ * @param[in] sink is the output.
+ * @param[in] time is the time to show.
+ * @param[in] date is the date to show.
+ *
+ * @return void
+ */
+void app_console_show(fmt_sink_t* sink, const RTC_time_t* time, const RTC_date_t* date);
+
+#endif /* APP_H */
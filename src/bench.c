@@ -0,0 +1,206 @@
+/*****************************************************************************************************
+* FILENAME :        bench.c
+*
+* DESCRIPTION :
+*       File containing the display path benchmark.
+*
+* PUBLIC FUNCTIONS :
+*       void        bench_init(uint32_t clock_hz)
+*       void        bench_run(fmt_sink_t* sink, uint32_t runs)
+*       uint32_t    bench_now(void)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+**/
+
+#include "bench.h"
+#include "app.h"
+#include "ds1307.h"
+#include "i2c_driver.h"
+#include "fmt.h"
+#include "stm32f446xx.h"
+#include <stdint.h>
+
+/* Duration of a stage over the runs of a scenario, in ns */
+typedef struct
+{
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+}bench_stat_t;
+
+/* Measured scenario */
+typedef struct
+{
+    uint8_t format;
+    uint32_t speed;
+    uint8_t redraw;
+    bench_stat_t stats[BENCH_STAGES];
+}bench_result_t;
+
+static uint32_t bench_clock_hz = 1000000000UL;
+
+static const uint8_t bench_formats[] = {T_FORMAT_12HRS_PM, T_FORMAT_24HRS};
+static const uint32_t bench_speeds[] = {I2C_SCL_SPEED_SM, I2C_SCL_SPEED_FM4K};
+static const char* const bench_stage_names[BENCH_STAGES] = {"read", "render", "write", "total"};
+
+/* Results of every scenario, printed once the measurements are done */
+static bench_result_t bench_results[BENCH_SCENARIOS];
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn bench_scenario
+ *
+ * @brief function to run one scenario.
+ *
+ * @param[in,out] result has the scenario settings, the stats are written.
+ * @param[in] runs is the number of runs.
+ *
+ * @return void.
+ */
+static void bench_scenario(bench_result_t* result, uint32_t runs);
+
+/**
+ * @fn bench_ns
+ *
+ * @brief function to convert a bench_now interval to ns.
+ *
+ * @param[in] ticks is the interval.
+ *
+ * @return interval in ns, saturated to 32 bits.
+ */
+static uint32_t bench_ns(uint32_t ticks);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void bench_init(uint32_t clock_hz){
+
+    bench_clock_hz = clock_hz;
+}
+
+void bench_run(fmt_sink_t* sink, uint32_t runs){
+
+    bench_result_t* result = bench_results;
+    uint8_t f = 0;
+    uint8_t s = 0;
+    uint8_t redraw = 0;
+    uint8_t stage = 0;
+
+    /* Nothing is printed while measuring, so the console does not add to the stages */
+    for(f = 0; f < (sizeof(bench_formats) / sizeof(bench_formats[0])); f++){
+        for(s = 0; s < (sizeof(bench_speeds) / sizeof(bench_speeds[0])); s++){
+            ds1307_set_i2c_speed(bench_speeds[s]);
+            for(redraw = 0; redraw < 2; redraw++){
+                result->format = bench_formats[f];
+                result->speed = bench_speeds[s];
+                result->redraw = !redraw;
+                bench_scenario(result, runs);
+                result++;
+            }
+        }
+    }
+
+    ds1307_set_i2c_speed(DS1307_I2C_SPEED);
+
+    fmt_printf(sink, "format,i2c_hz,redraw,stage,runs,min_ns,mean_ns,max_ns\n");
+    for(result = bench_results; result < &bench_results[BENCH_SCENARIOS]; result++){
+        for(stage = 0; stage < BENCH_STAGES; stage++){
+            fmt_printf(sink, "%s,%u,%s,%s,%u,%u,%u,%u\n", (result->format == T_FORMAT_24HRS) ? "24h" : "12h",
+                       (unsigned int)result->speed, result->redraw ? "full" : "digit", bench_stage_names[stage],
+                       (unsigned int)runs, (unsigned int)(runs ? result->stats[stage].min : 0),
+                       (unsigned int)(runs ? (result->stats[stage].total / runs) : 0),
+                       (unsigned int)result->stats[stage].max);
+        }
+    }
+}
+
+__attribute__((weak)) uint32_t bench_now(void){
+
+    return *DWT_CYCCNT;
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static void bench_scenario(bench_result_t* result, uint32_t runs){
+
+    bench_stat_t* stats = result->stats;
+    uint32_t stamp[BENCH_STAGES];
+    uint32_t ns = 0;
+    app_lcd_frame_t frame;
+    RTC_time_t time;
+    RTC_date_t date;
+    uint32_t i = 0;
+    uint8_t stage = 0;
+
+    for(stage = 0; stage < BENCH_STAGES; stage++){
+        stats[stage].min = UINT32_MAX;
+        stats[stage].max = 0;
+        stats[stage].total = 0;
+    }
+
+    /* Saturday 17/07/21, 11:59:10 PM or 23:59:10 */
+    date.day = SATURDAY;
+    date.date = 17;
+    date.month = 7;
+    date.year = 21;
+    ds1307_set_current_date(&date);
+    time.hours = (result->format == T_FORMAT_24HRS) ? 23 : 11;
+    time.minutes = 59;
+    time.time_format = result->format;
+
+    /* Untimed run, so the first digit run starts from the content of this scenario */
+    time.seconds = 11;
+    ds1307_set_current_time(&time);
+    ds1307_get_current_time(&time);
+    app_lcd_render(&time, &date, &frame);
+    app_lcd_write(&frame);
+
+    for(i = 0; i < runs; i++){
+        /* 10 and 11 seconds only differ in the last digit */
+        time.seconds = 10 + (i & 0x1);
+        ds1307_set_current_time(&time);
+        if(result->redraw){
+            app_lcd_invalidate();
+        }
+
+        stamp[0] = bench_now();
+        ds1307_get_current_time(&time);
+        ds1307_get_current_date(&date);
+        stamp[1] = bench_now();
+        app_lcd_render(&time, &date, &frame);
+        stamp[2] = bench_now();
+        app_lcd_write(&frame);
+        stamp[3] = bench_now();
+
+        for(stage = 0; stage < BENCH_STAGES; stage++){
+            if(stage == BENCH_STAGE_TOTAL){
+                ns = bench_ns(stamp[BENCH_STAGE_TOTAL] - stamp[BENCH_STAGE_READ]);
+            }
+            else{
+                ns = bench_ns(stamp[stage + 1] - stamp[stage]);
+            }
+            stats[stage].total += ns;
+            if(ns < stats[stage].min){
+                stats[stage].min = ns;
+            }
+            if(ns > stats[stage].max){
+                stats[stage].max = ns;
+            }
+        }
+    }
+}
+
+static uint32_t bench_ns(uint32_t ticks){
+
+    uint64_t ns = ((uint64_t)ticks * 1000000000ULL) / bench_clock_hz;
+
+    return (ns > UINT32_MAX) ? UINT32_MAX : (uint32_t)ns;
+}
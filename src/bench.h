@@ -0,0 +1,102 @@
+/*****************************************************************************************************
+* FILENAME :        bench.h
+*
+* DESCRIPTION :
+*       Header file containing the display path benchmark: it times the RTC read, the LCD frame
+*       rendering and the LCD write, and their total, over a set of scenarios, and prints the results
+*       as CSV.
+*
+* PUBLIC FUNCTIONS :
+*       void        bench_init(uint32_t clock_hz)
+*       void        bench_run(fmt_sink_t* sink, uint32_t runs)
+*       uint32_t    bench_now(void)
+*
+* NOTES :
+*       The scenarios are every combination of:
+*           - RTC and LCD in 12 or 24 hours format.
+*           - I2C at I2C_SCL_SPEED_SM or I2C_SCL_SPEED_FM4K.
+*           - full redraw (app_lcd_invalidate before the write) or one digit changed (the seconds
+*             alternate between two values which only differ in the last digit).
+*
+*       Every run sets the RTC (not timed), then times ds1307_get_current_time and
+*       ds1307_get_current_date (read), app_lcd_render (render) and app_lcd_write (write). The output
+*       is one CSV line per scenario and stage, after a header line, printed once every scenario
+*       has run:
+*
+*           format,i2c_hz,redraw,stage,runs,min_ns,mean_ns,max_ns
+*           12h,100000,full,read,100,...
+*
+*       The RTC and the LCD must be initialized (ds1307_init, hd44780_init) before bench_run; the RTC
+*       is left with the last time of the benchmark and the I2C bus at DS1307_I2C_SPEED.
+*
+*       The times come from bench_now, the DWT cycle counter on the target (clock_hz given to
+*       bench_init). A host build replaces it with its own clock. Interrupt handlers running in the
+*       middle of a stage are included, the benchmark firmware (src/bench_main.c) runs none.
+*
+**/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include "fmt.h"
+
+/**
+ * Application configurable items
+ */
+#define BENCH_RUNS              100     /* Default number of runs per scenario */
+
+/**
+ * @BENCH_STAGE
+ * Measured stages, the last one is the sum of the others.
+ */
+#define BENCH_STAGE_READ        0
+#define BENCH_STAGE_RENDER      1
+#define BENCH_STAGE_WRITE       2
+#define BENCH_STAGE_TOTAL       3
+#define BENCH_STAGES            4
+
+/**
+ * Number of scenarios: 2 formats, 2 I2C speeds, full redraw or one digit.
+ */
+#define BENCH_SCENARIOS         8
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn bench_init
+ *
+ * @brief function to set the frequency of the bench_now clock.
+ *
+ * @param[in] clock_hz is the number of bench_now ticks per second.
+ *
+ * @return void
+ */
+void bench_init(uint32_t clock_hz);
+
+/**
+ * @fn bench_run
+ *
+ * @brief function to run every scenario and print the results.
+ *
+ * @param[in] sink is the output of the CSV lines.
+ * @param[in] runs is the number of runs per scenario.
+ *
+ * @return void
+ */
+void bench_run(fmt_sink_t* sink, uint32_t runs);
+
+/**
+ * @fn bench_now
+ *
+ * @brief function to read the benchmark clock, weak so a host build can replace it.
+ *
+ * @param[in] void
+ *
+ * @return clock value in ticks of bench_init clock_hz, wrapping at 32 bits.
+ */
+uint32_t bench_now(void);
+
+#endif /* BENCH_H */
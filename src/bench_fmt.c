@@ -0,0 +1,134 @@
+/*****************************************************************************************************
+* FILENAME :        bench_fmt.c
+*
+* DESCRIPTION :
+*       File containing the formatter benchmark.
+*
+* PUBLIC FUNCTIONS :
+*       void    bench_fmt_run(fmt_sink_t* sink, uint32_t runs)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+*       BENCH_FMT_CASE generates one function per formatter for every case, so both formatters get
+*       the same format string and arguments from a direct call. The functions are not inlined, so
+*       the stack depth measured is the one of a normal call site.
+*
+*       Interrupts are masked from the stack painting to the last timed call, so no handler frame
+*       is counted in the stack depth and no handler run in the cycles; the UART console drains the
+*       results while the next formatter is not measured.
+*
+**/
+
+#include "bench_fmt.h"
+#include "bench.h"
+#include "stack.h"
+#include "fmt.h"
+#include "stm32f446xx.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#define BENCH_FMT_BUF_LEN       96
+#define BENCH_FMT_FORMATTERS    2
+
+/**
+ * Generate name_fmt and name_newlib, which format the case into buf.
+ */
+#define BENCH_FMT_CASE(name, ...)                                                                   \
+    __attribute__((noinline)) static int name##_fmt(char* buf){                                     \
+        return fmt_snprintf(buf, BENCH_FMT_BUF_LEN, __VA_ARGS__);                                   \
+    }                                                                                               \
+    __attribute__((noinline)) static int name##_newlib(char* buf){                                  \
+        return snprintf(buf, BENCH_FMT_BUF_LEN, __VA_ARGS__);                                       \
+    }
+
+/* Formatter call of a case */
+typedef int (*bench_fmt_fn_t)(char* buf);
+
+/* Case, one function per formatter */
+typedef struct
+{
+    const char* name;
+    bench_fmt_fn_t fn[BENCH_FMT_FORMATTERS];
+}bench_fmt_case_t;
+
+/* Arguments read at run time, so the compiler cannot fold the calls */
+static volatile uint32_t bench_fmt_args[4] = {11, 59, 15, 0xBEEF};
+
+BENCH_FMT_CASE(bench_fmt_time, "%02u:%02u:%02u %s", (unsigned int)bench_fmt_args[0],
+               (unsigned int)bench_fmt_args[1], (unsigned int)bench_fmt_args[2], "PM")
+
+BENCH_FMT_CASE(bench_fmt_stats, "Power: awake %u ms, sleep %u ms (%u), stop %u ms (%u), %u early wakes\n",
+               (unsigned int)bench_fmt_args[3] * 1000, (unsigned int)bench_fmt_args[3] * 20,
+               (unsigned int)bench_fmt_args[0], (unsigned int)bench_fmt_args[3] * 7000,
+               (unsigned int)bench_fmt_args[1], (unsigned int)bench_fmt_args[2])
+
+BENCH_FMT_CASE(bench_fmt_mixed, "%-8s|%5d|%08x|%X|%c|%ld", "idle", -(int)bench_fmt_args[1],
+               (unsigned int)bench_fmt_args[3], (unsigned int)bench_fmt_args[3], '#',
+               -(long)bench_fmt_args[3])
+
+static const bench_fmt_case_t bench_fmt_cases[] = {
+    {"time", {bench_fmt_time_fmt, bench_fmt_time_newlib}},
+    {"stats", {bench_fmt_stats_fmt, bench_fmt_stats_newlib}},
+    {"mixed", {bench_fmt_mixed_fmt, bench_fmt_mixed_newlib}},
+};
+
+static const char* const bench_fmt_names[BENCH_FMT_FORMATTERS] = {"fmt", "newlib"};
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void bench_fmt_run(fmt_sink_t* sink, uint32_t runs){
+
+    char buf[BENCH_FMT_BUF_LEN];
+    const bench_fmt_case_t* bcase = NULL;
+    uint32_t min = 0;
+    uint32_t max = 0;
+    uint64_t total = 0;
+    uint32_t start = 0;
+    uint32_t cycles = 0;
+    uint32_t base = 0;
+    uint32_t stack = 0;
+    uint32_t primask = 0;
+    uint32_t i = 0;
+    uint8_t f = 0;
+
+    fmt_printf(sink, "formatter,case,runs,min_cycles,mean_cycles,max_cycles,stack_bytes\n");
+
+    for(bcase = bench_fmt_cases; bcase < &bench_fmt_cases[sizeof(bench_fmt_cases) / sizeof(bench_fmt_cases[0])];
+        bcase++){
+        for(f = 0; f < BENCH_FMT_FORMATTERS; f++){
+            primask = irq_lock();
+
+            /* Stack depth of one call, from the painted stack below this function */
+            stack_paint();
+            base = stack_get_used();
+            bcase->fn[f](buf);
+            stack = stack_get_used() - base;
+
+            min = UINT32_MAX;
+            max = 0;
+            total = 0;
+            for(i = 0; i < runs; i++){
+                start = bench_now();
+                bcase->fn[f](buf);
+                cycles = bench_now() - start;
+
+                total += cycles;
+                if(cycles < min){
+                    min = cycles;
+                }
+                if(cycles > max){
+                    max = cycles;
+                }
+            }
+
+            irq_unlock(primask);
+
+            fmt_printf(sink, "%s,%s,%u,%u,%u,%u,%u\n", bench_fmt_names[f], bcase->name, (unsigned int)runs,
+                       (unsigned int)(runs ? min : 0), (unsigned int)(runs ? (total / runs) : 0),
+                       (unsigned int)max, (unsigned int)stack);
+        }
+    }
+}
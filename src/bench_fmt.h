@@ -0,0 +1,55 @@
+/*****************************************************************************************************
+* FILENAME :        bench_fmt.h
+*
+* DESCRIPTION :
+*       Header file containing the formatter benchmark: it compares fmt_snprintf (src/fmt.c) with the
+*       snprintf of the C library (newlib nano) on the same format strings, in CPU cycles and stack
+*       depth, and prints the results as CSV.
+*
+* PUBLIC FUNCTIONS :
+*       void    bench_fmt_run(fmt_sink_t* sink, uint32_t runs)
+*
+* NOTES :
+*       The cases are the kinds of lines the application prints: the clock face ("time"), a console
+*       statistics line ("stats") and the flags and widths of the other conversions ("mixed"). The
+*       output is one CSV line per formatter and case, after a header line:
+*
+*           formatter,case,runs,min_cycles,mean_cycles,max_cycles,stack_bytes
+*           fmt,time,100,...
+*           newlib,time,100,...
+*
+*       The cycles come from bench_now (DWT cycle counter). The stack depth is measured once per
+*       formatter and case: the stack below the caller is painted (stack_paint), the formatter is
+*       called and the deepest word written is read back (stack_get_used), so it includes the call
+*       itself and is accurate to a few words. Interrupts are masked while a formatter is measured.
+*       It only builds for the target (make bench).
+*
+*       The flash used by each formatter is reported by make fmtsize (src/fmt_size.c).
+*
+**/
+
+#ifndef BENCH_FMT_H
+#define BENCH_FMT_H
+
+#include <stdint.h>
+#include "fmt.h"
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn bench_fmt_run
+ *
+ * @brief function to time both formatters on every case and print the CSV results.
+ *
+ * @param[in] sink where the results are printed.
+ * @param[in] runs is the number of runs per formatter and case.
+ *
+ * @return void
+ *
+ * @note interrupts are masked while each formatter and case is measured.
+ */
+void bench_fmt_run(fmt_sink_t* sink, uint32_t runs);
+
+#endif /* BENCH_FMT_H */
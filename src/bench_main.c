@@ -0,0 +1,111 @@
+/*****************************************************************************************************
+* FILENAME :        bench_main.c
+*
+* DESCRIPTION :
+*       File containing the main function of the benchmark firmware (make bench): it initializes the
+*       console, the LCD and the RTC as src/main.c does, runs every benchmark scenario (src/bench.h)
+*       and the formatter comparison (src/bench_fmt.h) once and prints the CSV results in the
+*       console.
+*
+* NOTES :
+*       The lines starting with '#' are comments, the rest of the output is the CSV file, e.g.:
+*           picocom -b 115200 /dev/ttyACM0 | tee bench.log
+*           grep -v '^#' bench.log > bench.csv
+*
+*       Every line waits for the UART console to be idle before it is written, so the results are not
+*       dropped when they do not fit in the console buffer. No scheduler, SysTick or task runs.
+*
+**/
+
+#include <stdint.h>
+#include <unistd.h>
+#include "ds1307.h"
+#include "hd44780.h"
+#include "fmt.h"
+#include "bench.h"
+#include "bench_fmt.h"
+#include "rcc_driver.h"
+#include "uart_console.h"
+
+/* Console sink which waits for the UART console before every line */
+typedef struct
+{
+    fmt_sink_t sink;
+    uint32_t len;
+    char line[FMT_CONSOLE_LINE_LEN];
+}bench_sink_t;
+
+extern void initialise_monitor_handles(void);
+
+/**
+ * @fn bench_putc
+ *
+ * @brief function to add a character to the line, called by fmt_printf.
+ *
+ * @param[in] sink is the bench sink.
+ * @param[in] c is the character.
+ *
+ * @return void.
+ */
+static void bench_putc(fmt_sink_t* sink, char c){
+
+    bench_sink_t* bench = (bench_sink_t*)sink;
+
+    bench->line[bench->len++] = c;
+
+    if((c == '\n') || (bench->len == sizeof(bench->line))){
+        sink->flush(sink);
+    }
+}
+
+/**
+ * @fn bench_flush
+ *
+ * @brief function to write the line once the UART console is idle.
+ *
+ * @param[in] sink is the bench sink.
+ *
+ * @return void.
+ */
+static void bench_flush(fmt_sink_t* sink){
+
+    bench_sink_t* bench = (bench_sink_t*)sink;
+
+    if(bench->len > 0){
+        while(uart_console_is_busy());
+        write(1, bench->line, bench->len);
+        bench->len = 0;
+    }
+}
+
+int main(void){
+
+    bench_sink_t console = {.sink = {bench_putc, bench_flush}};
+
+    initialise_monitor_handles();
+
+    uart_console_init();
+
+    fmt_printf(&console.sink, "# Benchmark: HCLK %u Hz, PCLK1 %u Hz, %u runs per scenario\n",
+               (unsigned int)RCC_GetHCLKValue(), (unsigned int)RCC_GetPCLK1Value(), (unsigned int)BENCH_RUNS);
+
+    hd44780_init();
+    hd44780_display_clear();
+    hd44780_display_return_home();
+
+    if(ds1307_init()){
+        fmt_printf(&console.sink, "# RTC init failed, please reset manually\n");
+        while(1);
+    }
+
+    /* Times in DWT cycles, the counter is started by Reset_Handler */
+    bench_init(RCC_GetHCLKValue());
+    bench_run(&console.sink, BENCH_RUNS);
+    bench_fmt_run(&console.sink, BENCH_RUNS);
+
+    fmt_printf(&console.sink, "# Benchmark done\n");
+
+    for(;;);
+
+    return 0;
+}
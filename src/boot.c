@@ -0,0 +1,72 @@
+/*****************************************************************************************************
+* FILENAME :        boot.c
+*
+* DESCRIPTION :
+*       File containing the boot phase timestamps.
+*
+* PUBLIC FUNCTIONS :
+*       void        boot_mark(uint8_t phase)
+*       uint8_t     boot_is_marked(uint8_t phase)
+*       uint32_t    boot_get_cycles(uint8_t phase)
+*       uint32_t    boot_get_us(uint8_t phase, uint32_t cycles_per_us)
+*       const char* boot_get_name(uint8_t phase)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+**/
+
+#include "boot.h"
+#include "sched.h"
+#include "stm32f446xx.h"
+#include <stdint.h>
+
+volatile uint32_t boot_cycles[BOOT_PHASES];
+volatile uint32_t boot_ticks[BOOT_PHASES];
+
+static const char* const boot_names[BOOT_PHASES] = {
+    "data", "bss", "main", "lcd", "rtc", "sched", "first frame"
+};
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void boot_mark(uint8_t phase){
+
+    uint32_t now = *DWT_CYCCNT;
+
+    if((phase < BOOT_PHASES) && (boot_cycles[phase] == 0)){
+        boot_cycles[phase] = now;
+        boot_ticks[phase] = sched_get_ticks();
+    }
+}
+
+uint8_t boot_is_marked(uint8_t phase){
+
+    return ((phase < BOOT_PHASES) && (boot_cycles[phase] != 0)) ? 1 : 0;
+}
+
+uint32_t boot_get_cycles(uint8_t phase){
+
+    return (phase < BOOT_PHASES) ? boot_cycles[phase] : 0;
+}
+
+uint32_t boot_get_us(uint8_t phase, uint32_t cycles_per_us){
+
+    if(!boot_is_marked(phase)){
+        return 0;
+    }
+
+    if((phase <= BOOT_PHASE_SCHED) || !boot_is_marked(BOOT_PHASE_SCHED)){
+        return boot_cycles[phase] / cycles_per_us;
+    }
+
+    return (boot_cycles[BOOT_PHASE_SCHED] / cycles_per_us) +
+           ((boot_ticks[phase] - boot_ticks[BOOT_PHASE_SCHED]) * (1000000UL / SCHED_TICK_HZ));
+}
+
+const char* boot_get_name(uint8_t phase){
+
+    return (phase < BOOT_PHASES) ? boot_names[phase] : "?";
+}
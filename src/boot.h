@@ -0,0 +1,110 @@
+/*****************************************************************************************************
+* FILENAME :        boot.h
+*
+* DESCRIPTION :
+*       Header file containing the boot phase timestamps.
+*
+* PUBLIC FUNCTIONS :
+*       void        boot_mark(uint8_t phase)
+*       uint8_t     boot_is_marked(uint8_t phase)
+*       uint32_t    boot_get_cycles(uint8_t phase)
+*       uint32_t    boot_get_us(uint8_t phase, uint32_t cycles_per_us)
+*       const char* boot_get_name(uint8_t phase)
+*
+* NOTES :
+*       The DWT cycle counter is started by Reset_Handler once the system clock is configured, so
+*       every timestamp is the number of CPU cycles since then. Only the first mark of every phase is
+*       kept. The timestamps stay in
+*       boot_cycles, where they can also be read by the debugger after boot.
+*
+*       The cycle counter does not count in Stop mode, which may be entered once the main loop runs,
+*       so the scheduler tick is recorded too and boot_get_us uses it for the later phases.
+*
+**/
+
+#ifndef BOOT_H
+#define BOOT_H
+
+#include <stdint.h>
+
+/**
+ * @BOOT_PHASE
+ * Boot phases, in the order they happen.
+ */
+#define BOOT_PHASE_DATA         0   /* .data copied */
+#define BOOT_PHASE_BSS          1   /* .bss zeroed */
+#define BOOT_PHASE_MAIN         2   /* Constructors run, main entered */
+#define BOOT_PHASE_LCD          3   /* LCD initialized, splash message shown */
+#define BOOT_PHASE_RTC          4   /* RTC initialized and set */
+#define BOOT_PHASE_SCHED        5   /* Main loop entered */
+#define BOOT_PHASE_FIRST_FRAME  6   /* First date and time shown in the LCD */
+#define BOOT_PHASES             7
+
+/* Timestamps in CPU cycles since reset, 0 if the phase is not reached yet */
+extern volatile uint32_t boot_cycles[BOOT_PHASES];
+
+/* Scheduler tick of every timestamp */
+extern volatile uint32_t boot_ticks[BOOT_PHASES];
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn boot_mark
+ *
+ * @brief function to record the end of a boot phase.
+ *
+ * @param[in] phase from @BOOT_PHASE.
+ *
+ * @return void
+ */
+void boot_mark(uint8_t phase);
+
+/**
+ * @fn boot_is_marked
+ *
+ * @brief function to know if a boot phase is recorded.
+ *
+ * @param[in] phase from @BOOT_PHASE.
+ *
+ * @return 1 if recorded, 0 otherwise.
+ */
+uint8_t boot_is_marked(uint8_t phase);
+
+/**
+ * @fn boot_get_cycles
+ *
+ * @brief function to get the timestamp of a boot phase.
+ *
+ * @param[in] phase from @BOOT_PHASE.
+ *
+ * @return CPU cycles since reset, 0 if not recorded.
+ */
+uint32_t boot_get_cycles(uint8_t phase);
+
+/**
+ * @fn boot_get_us
+ *
+ * @brief function to get the time since reset of a boot phase.
+ *
+ * @param[in] phase from @BOOT_PHASE.
+ * @param[in] cycles_per_us is the CPU clock in MHz.
+ *
+ * @return microseconds since reset, with a 1 ms resolution after BOOT_PHASE_SCHED; 0 if not
+ *         recorded.
+ */
+uint32_t boot_get_us(uint8_t phase, uint32_t cycles_per_us);
+
+/**
+ * @fn boot_get_name
+ *
+ * @brief function to get the name of a boot phase.
+ *
+ * @param[in] phase from @BOOT_PHASE.
+ *
+ * @return name, "?" for an invalid phase.
+ */
+const char* boot_get_name(uint8_t phase);
+
+#endif /* BOOT_H */
@@ -0,0 +1,77 @@
+/*****************************************************************************************************
+* FILENAME :        clockfmt.c
+*
+* DESCRIPTION :
+*       File containing the lookup tables of the clock face formatter and the change emitter.
+*
+* PUBLIC FUNCTIONS :
+*       uint8_t clockfmt_emit_changes(char* shown, const char* next, uint8_t len, clockfmt_emit_fn_t emit,
+*                                     void* ctx)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+**/
+
+#include "clockfmt.h"
+#include <stdint.h>
+
+const char clockfmt_lut[100][2] = {
+    {'0','0'}, {'0','1'}, {'0','2'}, {'0','3'}, {'0','4'}, {'0','5'}, {'0','6'}, {'0','7'}, {'0','8'}, {'0','9'},
+    {'1','0'}, {'1','1'}, {'1','2'}, {'1','3'}, {'1','4'}, {'1','5'}, {'1','6'}, {'1','7'}, {'1','8'}, {'1','9'},
+    {'2','0'}, {'2','1'}, {'2','2'}, {'2','3'}, {'2','4'}, {'2','5'}, {'2','6'}, {'2','7'}, {'2','8'}, {'2','9'},
+    {'3','0'}, {'3','1'}, {'3','2'}, {'3','3'}, {'3','4'}, {'3','5'}, {'3','6'}, {'3','7'}, {'3','8'}, {'3','9'},
+    {'4','0'}, {'4','1'}, {'4','2'}, {'4','3'}, {'4','4'}, {'4','5'}, {'4','6'}, {'4','7'}, {'4','8'}, {'4','9'},
+    {'5','0'}, {'5','1'}, {'5','2'}, {'5','3'}, {'5','4'}, {'5','5'}, {'5','6'}, {'5','7'}, {'5','8'}, {'5','9'},
+    {'6','0'}, {'6','1'}, {'6','2'}, {'6','3'}, {'6','4'}, {'6','5'}, {'6','6'}, {'6','7'}, {'6','8'}, {'6','9'},
+    {'7','0'}, {'7','1'}, {'7','2'}, {'7','3'}, {'7','4'}, {'7','5'}, {'7','6'}, {'7','7'}, {'7','8'}, {'7','9'},
+    {'8','0'}, {'8','1'}, {'8','2'}, {'8','3'}, {'8','4'}, {'8','5'}, {'8','6'}, {'8','7'}, {'8','8'}, {'8','9'},
+    {'9','0'}, {'9','1'}, {'9','2'}, {'9','3'}, {'9','4'}, {'9','5'}, {'9','6'}, {'9','7'}, {'9','8'}, {'9','9'}
+};
+
+const char clockfmt_wday_names[8][3] = {
+    {'?','?','?'},
+    {'M','o','n'}, {'T','u','e'}, {'W','e','d'}, {'T','h','u'}, {'F','r','i'}, {'S','a','t'}, {'S','u','n'}
+};
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+uint8_t clockfmt_emit_changes(char* shown, const char* next, uint8_t len, clockfmt_emit_fn_t emit, void* ctx){
+
+    uint8_t pos = 0;
+    uint8_t start = 0;
+    uint8_t end = 0;
+    uint8_t count = 0;
+
+    while(pos < len){
+
+        /* Find the next changed character */
+        if(shown[pos] == next[pos]){
+            pos++;
+            continue;
+        }
+
+        /* Extend the run while the gaps are short */
+        start = pos;
+        end = pos + 1;
+        for(pos = end; pos < len; pos++){
+            if(shown[pos] != next[pos]){
+                end = pos + 1;
+            }
+            else if((pos - end) >= CLOCKFMT_MERGE_GAP){
+                break;
+            }
+        }
+
+        emit(ctx, start, &next[start], end - start);
+        count += end - start;
+
+        for(pos = start; pos < end; pos++){
+            shown[pos] = next[pos];
+        }
+    }
+
+    return count;
+}
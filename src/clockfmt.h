@@ -0,0 +1,179 @@
+/*****************************************************************************************************
+* FILENAME :        clockfmt.h
+*
+* DESCRIPTION :
+*       Header file containing the clock face formatter. The formats are described with field macros
+*       and CLOCKFMT_DEFINE turns every description into its own straight line function at compile
+*       time, which writes into a caller buffer.
+*
+* PUBLIC FUNCTIONS :
+*       uint8_t clockfmt_time24(const RTC_time_t* time, const RTC_date_t* date, char* buf)
+*       uint8_t clockfmt_time12(const RTC_time_t* time, const RTC_date_t* date, char* buf)
+*       uint8_t clockfmt_date(const RTC_time_t* time, const RTC_date_t* date, char* buf)
+*       uint8_t clockfmt_iso8601(const RTC_time_t* time, const RTC_date_t* date, char* buf)
+*       uint8_t clockfmt_weekday(const RTC_time_t* time, const RTC_date_t* date, char* buf)
+*       uint8_t clockfmt_emit_changes(char* shown, const char* next, uint8_t len, clockfmt_emit_fn_t emit,
+*                                     void* ctx)
+*
+* NOTES :
+*       Example, "hh:mm:ss AM" with a space instead of the seconds separator:
+*
+*           CLOCKFMT_DEFINE(my_time, CLOCKFMT_H12 CLOCKFMT_LIT(':') CLOCKFMT_MIN CLOCKFMT_LIT(' ')
+*                                    CLOCKFMT_SEC CLOCKFMT_LIT(' ') CLOCKFMT_AMPM)
+*
+*       The generated functions are reentrant, the values must be in range (as read from the DS1307).
+*
+**/
+
+#ifndef CLOCKFMT_H
+#define CLOCKFMT_H
+
+#include <stdint.h>
+#include "ds1307.h"
+
+/**
+ * Application configurable items
+ */
+#define CLOCKFMT_MERGE_GAP      1   /* Unchanged characters rewritten instead of moving the cursor */
+
+/**
+ * Output length of the predefined formats, the buffers need one more character for the NUL.
+ */
+#define CLOCKFMT_TIME24_LEN     8   /* hh:mm:ss */
+#define CLOCKFMT_TIME12_LEN     11  /* hh:mm:ss AM */
+#define CLOCKFMT_DATE_LEN       8   /* dd/mm/yy */
+#define CLOCKFMT_ISO8601_LEN    19  /* yyyy-mm-ddThh:mm:ss */
+#define CLOCKFMT_WEEKDAY_LEN    3   /* Sat */
+
+/**
+ * Lookup tables, defined in clockfmt.c.
+ */
+extern const char clockfmt_lut[100][2];     /* "00" to "99" */
+extern const char clockfmt_wday_names[8][3];  /* Index 1 (MONDAY) to 7 (SUNDAY), index 0 is "???" */
+
+/**
+ * Format fields, every field writes a fixed number of characters.
+ */
+#define CLOCKFMT_H24            p = clockfmt_put2(p, clockfmt_hour24(time));
+#define CLOCKFMT_H12            p = clockfmt_put2(p, clockfmt_hour12(time));
+#define CLOCKFMT_AMPM           *p++ = clockfmt_is_pm(time) ? 'P' : 'A'; *p++ = 'M';
+#define CLOCKFMT_MIN            p = clockfmt_put2(p, time->minutes);
+#define CLOCKFMT_SEC            p = clockfmt_put2(p, time->seconds);
+#define CLOCKFMT_DAY            p = clockfmt_put2(p, date->date);
+#define CLOCKFMT_MON            p = clockfmt_put2(p, date->month);
+#define CLOCKFMT_YY             p = clockfmt_put2(p, date->year);
+#define CLOCKFMT_YYYY           *p++ = '2'; *p++ = '0'; p = clockfmt_put2(p, date->year);
+#define CLOCKFMT_WDAY           p = clockfmt_put_wday(p, date->day);
+#define CLOCKFMT_LIT(c)         *p++ = (c);
+
+/**
+ * Generate a formatter function: uint8_t name(const RTC_time_t*, const RTC_date_t*, char* buf), which
+ * returns the number of characters written, not counting the NUL terminator.
+ */
+#define CLOCKFMT_DEFINE(name, fields)                                                               \
+    static inline uint8_t name(const RTC_time_t* time, const RTC_date_t* date, char* buf){          \
+        char* p = buf;                                                                              \
+        (void)time;                                                                                 \
+        (void)date;                                                                                 \
+        fields                                                                                      \
+        *p = '\0';                                                                                  \
+        return (uint8_t)(p - buf);                                                                  \
+    }
+
+/**
+ * Called by clockfmt_emit_changes for every run of characters to be sent to the output device.
+ */
+typedef void (*clockfmt_emit_fn_t)(void* ctx, uint8_t pos, const char* str, uint8_t len);
+
+/*****************************************************************************************************/
+/*                                       Field helpers                                               */
+/*****************************************************************************************************/
+
+static inline char* clockfmt_put2(char* p, uint8_t value){
+
+    p[0] = clockfmt_lut[value][0];
+    p[1] = clockfmt_lut[value][1];
+
+    return p + 2;
+}
+
+static inline char* clockfmt_put_wday(char* p, uint8_t day){
+
+    const char* name = clockfmt_wday_names[(day <= SUNDAY) ? day : 0];
+
+    p[0] = name[0];
+    p[1] = name[1];
+    p[2] = name[2];
+
+    return p + 3;
+}
+
+static inline uint8_t clockfmt_hour24(const RTC_time_t* time){
+
+    if(time->time_format == T_FORMAT_24HRS){
+        return time->hours;
+    }
+
+    return (time->hours % 12) + ((time->time_format == T_FORMAT_12HRS_PM) ? 12 : 0);
+}
+
+static inline uint8_t clockfmt_hour12(const RTC_time_t* time){
+
+    uint8_t hours = time->hours % 12;
+
+    if(time->time_format != T_FORMAT_24HRS){
+        return time->hours;
+    }
+
+    return hours ? hours : 12;
+}
+
+static inline uint8_t clockfmt_is_pm(const RTC_time_t* time){
+
+    if(time->time_format == T_FORMAT_24HRS){
+        return (time->hours >= 12) ? 1 : 0;
+    }
+
+    return (time->time_format == T_FORMAT_12HRS_PM) ? 1 : 0;
+}
+
+/*****************************************************************************************************/
+/*                                       Predefined formats                                          */
+/*****************************************************************************************************/
+
+CLOCKFMT_DEFINE(clockfmt_time24, CLOCKFMT_H24 CLOCKFMT_LIT(':') CLOCKFMT_MIN CLOCKFMT_LIT(':') CLOCKFMT_SEC)
+
+CLOCKFMT_DEFINE(clockfmt_time12, CLOCKFMT_H12 CLOCKFMT_LIT(':') CLOCKFMT_MIN CLOCKFMT_LIT(':') CLOCKFMT_SEC
+                                 CLOCKFMT_LIT(' ') CLOCKFMT_AMPM)
+
+CLOCKFMT_DEFINE(clockfmt_date, CLOCKFMT_DAY CLOCKFMT_LIT('/') CLOCKFMT_MON CLOCKFMT_LIT('/') CLOCKFMT_YY)
+
+CLOCKFMT_DEFINE(clockfmt_iso8601, CLOCKFMT_YYYY CLOCKFMT_LIT('-') CLOCKFMT_MON CLOCKFMT_LIT('-') CLOCKFMT_DAY
+                                  CLOCKFMT_LIT('T') CLOCKFMT_H24 CLOCKFMT_LIT(':') CLOCKFMT_MIN
+                                  CLOCKFMT_LIT(':') CLOCKFMT_SEC)
+
+CLOCKFMT_DEFINE(clockfmt_weekday, CLOCKFMT_WDAY)
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn clockfmt_emit_changes
+ *
+ * @brief function to send only the characters which differ from the ones already shown.
+ *
+ * @param[in,out] shown is the text in the output device, it is updated to next.
+ * @param[in] next is the new text.
+ * @param[in] len is the number of characters to compare.
+ * @param[in] emit is called for every run of changed characters, with its position in the text.
+ * @param[in] ctx is passed to emit.
+ *
+ * @return number of characters emitted.
+ *
+ * @note runs separated by CLOCKFMT_MERGE_GAP unchanged characters or less are emitted together, as
+ *       moving the cursor costs as much as rewriting one character on the HD44780.
+ */
+uint8_t clockfmt_emit_changes(char* shown, const char* next, uint8_t len, clockfmt_emit_fn_t emit, void* ctx);
+
+#endif /* CLOCKFMT_H */
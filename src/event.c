@@ -0,0 +1,83 @@
+/*****************************************************************************************************
+* FILENAME :        event.c
+*
+* DESCRIPTION :
+*       File containing the deferred event dispatcher.
+*
+* PUBLIC FUNCTIONS :
+*       void        event_register(uint8_t event, event_handler_t handler)
+*       void        event_post(uint8_t event)
+*       uint8_t     event_dispatch(void)
+*       uint32_t    event_get_coalesced(void)
+*       uint8_t     event_is_pending(void)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*       The pending word is updated with the GCC atomic builtins, which the Cortex-M4 implements with
+*       LDREX/STREX, so posting never disables interrupts.
+*
+**/
+
+#include "event.h"
+#include <stdint.h>
+#include <stddef.h>
+
+static event_handler_t event_handlers[EVENT_MAX_EVENTS];
+static volatile uint32_t event_pending = 0;
+static volatile uint32_t event_coalesced = 0;
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void event_register(uint8_t event, event_handler_t handler){
+
+    if(event < EVENT_MAX_EVENTS){
+        event_handlers[event] = handler;
+    }
+}
+
+void event_post(uint8_t event){
+
+    uint32_t mask = (1U << event);
+
+    if(event >= EVENT_MAX_EVENTS){
+        return;
+    }
+
+    if(__atomic_fetch_or(&event_pending, mask, __ATOMIC_RELEASE) & mask){
+        __atomic_fetch_add(&event_coalesced, 1, __ATOMIC_RELAXED);
+    }
+}
+
+uint8_t event_dispatch(void){
+
+    uint32_t pending = 0;
+    uint8_t event = 0;
+    uint8_t count = 0;
+
+    /* Take all the pending events at once, posts from now on are seen in the next call */
+    pending = __atomic_exchange_n(&event_pending, 0, __ATOMIC_ACQUIRE);
+
+    while(pending != 0){
+        event = (uint8_t)__builtin_ctz(pending);
+        pending &= ~(1U << event);
+
+        if(event_handlers[event] != NULL){
+            event_handlers[event]();
+            count++;
+        }
+    }
+
+    return count;
+}
+
+uint32_t event_get_coalesced(void){
+
+    return event_coalesced;
+}
+
+uint8_t event_is_pending(void){
+
+    return (event_pending != 0) ? 1 : 0;
+}
@@ -0,0 +1,100 @@
+/*****************************************************************************************************
+* FILENAME :        event.h
+*
+* DESCRIPTION :
+*       Header file containing the prototypes of the APIs for the deferred event dispatcher.
+*
+* PUBLIC FUNCTIONS :
+*       void        event_register(uint8_t event, event_handler_t handler)
+*       void        event_post(uint8_t event)
+*       uint8_t     event_dispatch(void)
+*       uint32_t    event_get_coalesced(void)
+*       uint8_t     event_is_pending(void)
+*
+* NOTES :
+*       Interrupt handlers only post events, which is a single atomic operation, and the handlers are
+*       run later from the main loop by event_dispatch. An event posted again before it is dispatched
+*       runs its handler once and is counted as coalesced.
+*
+**/
+
+#ifndef EVENT_H
+#define EVENT_H
+
+#include <stdint.h>
+
+/**
+ * Application configurable items
+ */
+#define EVENT_MAX_EVENTS        32  /* Events are bits of a 32 bit pending word */
+
+/**
+ * Handler run from the main loop when its event is pending.
+ */
+typedef void (*event_handler_t)(void);
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn event_register
+ *
+ * @brief function to register the handler of an event.
+ *
+ * @param[in] event is the event number (0 to EVENT_MAX_EVENTS - 1), lower numbers are dispatched first.
+ * @param[in] handler is the function called by event_dispatch, NULL to unregister.
+ *
+ * @return void
+ */
+void event_register(uint8_t event, event_handler_t handler);
+
+/**
+ * @fn event_post
+ *
+ * @brief function to mark an event as pending.
+ *
+ * @param[in] event is the event number.
+ *
+ * @return void
+ *
+ * @note this function can be called from interrupt handlers.
+ */
+void event_post(uint8_t event);
+
+/**
+ * @fn event_dispatch
+ *
+ * @brief function to run the handlers of all the pending events.
+ *
+ * @param[in] void
+ *
+ * @return number of handlers run.
+ *
+ * @note this function must be called from the main loop only.
+ */
+uint8_t event_dispatch(void);
+
+/**
+ * @fn event_get_coalesced
+ *
+ * @brief function to get the number of posts which found the event already pending.
+ *
+ * @param[in] void
+ *
+ * @return number of coalesced posts.
+ */
+uint32_t event_get_coalesced(void);
+
+/**
+ * @fn event_is_pending
+ *
+ * @brief function to know if any event is waiting to be dispatched.
+ *
+ * @param[in] void
+ *
+ * @return 1 if there are pending events, 0 otherwise.
+ */
+uint8_t event_is_pending(void);
+
+#endif /* EVENT_H */
@@ -0,0 +1,373 @@
+/*****************************************************************************************************
+* FILENAME :        fmt.c
+*
+* DESCRIPTION :
+*       File containing the integer only formatted output engine and its sinks.
+*
+* PUBLIC FUNCTIONS :
+*       int     fmt_printf(fmt_sink_t* sink, const char* format, ...)
+*       int     fmt_vprintf(fmt_sink_t* sink, const char* format, va_list args)
+*       int     fmt_snprintf(char* buf, uint32_t size, const char* format, ...)
+*       void    fmt_buf_sink_init(fmt_buf_sink_t* sink, char* buf, uint32_t size)
+*       void    fmt_console_sink_init(fmt_console_sink_t* sink, int fd)
+*       void    fmt_lcd_sink_init(fmt_lcd_sink_t* sink, uint8_t row, uint8_t column)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+**/
+
+#include "fmt.h"
+#include "hd44780.h"
+#include <stdint.h>
+#include <stdarg.h>
+#include <unistd.h>
+
+#define FMT_FLAG_LEFT       (1 << 0)
+#define FMT_FLAG_ZERO       (1 << 1)
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn fmt_put_field
+ *
+ * @brief function to write a string padded to a field width.
+ *
+ * @param[in] sink where the output is written.
+ * @param[in] str is the string to write.
+ * @param[in] len is the length of the string.
+ * @param[in] width is the minimum field width.
+ * @param[in] flags is a combination of FMT_FLAG_LEFT and FMT_FLAG_ZERO.
+ * @param[in] sign is '-' for negative numbers or 0.
+ *
+ * @return number of characters written.
+ */
+static int fmt_put_field(fmt_sink_t* sink, const char* str, uint32_t len, uint32_t width, uint8_t flags,
+                         char sign);
+
+/**
+ * @fn fmt_utoa
+ *
+ * @brief function to convert an unsigned number to ASCII digits.
+ *
+ * @param[in] value is the number to be converted.
+ * @param[in] base is 10 or 16.
+ * @param[in] upper is 1 for upper case hexadecimal digits.
+ * @param[out] end is the end of a buffer of at least 10 characters, digits are written backwards.
+ *
+ * @return pointer to the first digit.
+ */
+static char* fmt_utoa(uint32_t value, uint32_t base, uint8_t upper, char* end);
+
+/**
+ * @fn buf_putc
+ *
+ * @brief putc function of the RAM buffer sink.
+ */
+static void buf_putc(fmt_sink_t* sink, char c);
+
+/**
+ * @fn console_putc
+ *
+ * @brief putc function of the console sink.
+ */
+static void console_putc(fmt_sink_t* sink, char c);
+
+/**
+ * @fn console_flush
+ *
+ * @brief flush function of the console sink.
+ */
+static void console_flush(fmt_sink_t* sink);
+
+/**
+ * @fn lcd_putc
+ *
+ * @brief putc function of the LCD sink.
+ */
+static void lcd_putc(fmt_sink_t* sink, char c);
+
+/**
+ * @fn lcd_flush
+ *
+ * @brief flush function of the LCD sink.
+ */
+static void lcd_flush(fmt_sink_t* sink);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+int fmt_printf(fmt_sink_t* sink, const char* format, ...){
+
+    va_list args;
+    int count = 0;
+
+    va_start(args, format);
+    count = fmt_vprintf(sink, format, args);
+    va_end(args);
+
+    return count;
+}
+
+int fmt_vprintf(fmt_sink_t* sink, const char* format, va_list args){
+
+    char digits[10];
+    char* str = NULL;
+    uint32_t width = 0;
+    uint32_t value = 0;
+    uint8_t flags = 0;
+    char sign = 0;
+    int count = 0;
+
+    while(*format != '\0'){
+
+        if(*format != '%'){
+            sink->putc(sink, *format++);
+            count++;
+            continue;
+        }
+        format++;
+
+        /* Flags */
+        flags = 0;
+        for(;;){
+            if(*format == '-'){
+                flags |= FMT_FLAG_LEFT;
+            }
+            else if(*format == '0'){
+                flags |= FMT_FLAG_ZERO;
+            }
+            else{
+                break;
+            }
+            format++;
+        }
+
+        /* Field width */
+        width = 0;
+        while((*format >= '0') && (*format <= '9')){
+            width = (width * 10) + (uint32_t)(*format++ - '0');
+        }
+
+        /* Length modifier, int and long have the same size */
+        if(*format == 'l'){
+            format++;
+        }
+
+        sign = 0;
+        switch(*format){
+            case 'd':
+            case 'i':
+                value = (uint32_t)va_arg(args, int);
+                if((int32_t)value < 0){
+                    sign = '-';
+                    value = 0U - value;
+                }
+                str = fmt_utoa(value, 10, 0, &digits[sizeof(digits)]);
+                count += fmt_put_field(sink, str, (uint32_t)(&digits[sizeof(digits)] - str), width, flags, sign);
+                break;
+            case 'u':
+                str = fmt_utoa(va_arg(args, unsigned int), 10, 0, &digits[sizeof(digits)]);
+                count += fmt_put_field(sink, str, (uint32_t)(&digits[sizeof(digits)] - str), width, flags, 0);
+                break;
+            case 'x':
+            case 'X':
+                str = fmt_utoa(va_arg(args, unsigned int), 16, (*format == 'X'), &digits[sizeof(digits)]);
+                count += fmt_put_field(sink, str, (uint32_t)(&digits[sizeof(digits)] - str), width, flags, 0);
+                break;
+            case 'c':
+                digits[0] = (char)va_arg(args, int);
+                count += fmt_put_field(sink, digits, 1, width, flags & ~FMT_FLAG_ZERO, 0);
+                break;
+            case 's':
+                str = va_arg(args, char*);
+                if(str == NULL){
+                    str = "(null)";
+                }
+                for(value = 0; str[value] != '\0'; value++);
+                count += fmt_put_field(sink, str, value, width, flags & ~FMT_FLAG_ZERO, 0);
+                break;
+            case '%':
+                sink->putc(sink, '%');
+                count++;
+                break;
+            case '\0':
+                /* Truncated conversion at the end of the format string */
+                format--;
+                break;
+            default:
+                /* Unsupported conversion, print it as is */
+                sink->putc(sink, '%');
+                sink->putc(sink, *format);
+                count += 2;
+                break;
+        }
+        format++;
+    }
+
+    if(sink->flush != NULL){
+        sink->flush(sink);
+    }
+
+    return count;
+}
+
+int fmt_snprintf(char* buf, uint32_t size, const char* format, ...){
+
+    fmt_buf_sink_t sink;
+    va_list args;
+
+    fmt_buf_sink_init(&sink, buf, size);
+
+    va_start(args, format);
+    fmt_vprintf(&sink.sink, format, args);
+    va_end(args);
+
+    return (int)sink.len;
+}
+
+void fmt_buf_sink_init(fmt_buf_sink_t* sink, char* buf, uint32_t size){
+
+    sink->sink.putc = buf_putc;
+    sink->sink.flush = NULL;
+    sink->buf = buf;
+    sink->size = size;
+    sink->len = 0;
+
+    if(size > 0){
+        buf[0] = '\0';
+    }
+}
+
+void fmt_console_sink_init(fmt_console_sink_t* sink, int fd){
+
+    sink->sink.putc = console_putc;
+    sink->sink.flush = console_flush;
+    sink->fd = fd;
+    sink->len = 0;
+}
+
+void fmt_lcd_sink_init(fmt_lcd_sink_t* sink, uint8_t row, uint8_t column){
+
+    sink->sink.putc = lcd_putc;
+    sink->sink.flush = lcd_flush;
+    sink->row = row;
+    sink->column = column;
+    sink->len = 0;
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static int fmt_put_field(fmt_sink_t* sink, const char* str, uint32_t len, uint32_t width, uint8_t flags,
+                         char sign){
+
+    uint32_t total = len + (sign ? 1 : 0);
+    uint32_t pad = (width > total) ? (width - total) : 0;
+    uint32_t i = 0;
+
+    if(!(flags & FMT_FLAG_LEFT) && !(flags & FMT_FLAG_ZERO)){
+        for(i = 0; i < pad; i++){
+            sink->putc(sink, ' ');
+        }
+    }
+
+    if(sign){
+        sink->putc(sink, sign);
+    }
+
+    if(!(flags & FMT_FLAG_LEFT) && (flags & FMT_FLAG_ZERO)){
+        for(i = 0; i < pad; i++){
+            sink->putc(sink, '0');
+        }
+    }
+
+    for(i = 0; i < len; i++){
+        sink->putc(sink, str[i]);
+    }
+
+    if(flags & FMT_FLAG_LEFT){
+        for(i = 0; i < pad; i++){
+            sink->putc(sink, ' ');
+        }
+    }
+
+    return (int)(total + pad);
+}
+
+static char* fmt_utoa(uint32_t value, uint32_t base, uint8_t upper, char* end){
+
+    const char* hex = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+
+    do{
+        *--end = hex[value % base];
+        value /= base;
+    }
+    while(value != 0);
+
+    return end;
+}
+
+static void buf_putc(fmt_sink_t* sink, char c){
+
+    fmt_buf_sink_t* buf_sink = (fmt_buf_sink_t*)sink;
+
+    if((buf_sink->len + 1) < buf_sink->size){
+        buf_sink->buf[buf_sink->len++] = c;
+        buf_sink->buf[buf_sink->len] = '\0';
+    }
+}
+
+static void console_putc(fmt_sink_t* sink, char c){
+
+    fmt_console_sink_t* console = (fmt_console_sink_t*)sink;
+
+    console->line[console->len++] = c;
+
+    if((c == '\n') || (console->len == sizeof(console->line))){
+        console_flush(sink);
+    }
+}
+
+static void console_flush(fmt_sink_t* sink){
+
+    fmt_console_sink_t* console = (fmt_console_sink_t*)sink;
+
+    if(console->len > 0){
+        write(console->fd, console->line, console->len);
+        console->len = 0;
+    }
+}
+
+static void lcd_putc(fmt_sink_t* sink, char c){
+
+    fmt_lcd_sink_t* lcd = (fmt_lcd_sink_t*)sink;
+    uint8_t end = (uint8_t)((((lcd->column - 1) / FMT_LCD_COLUMNS) + 1) * FMT_LCD_COLUMNS);
+
+    /* Clip at the end of the 16 column page the output started in, the last page ends with the
+     * 40 DDRAM columns as the next address is the first column of the other line */
+    if(end > HD44780_DDRAM_COLUMNS){
+        end = HD44780_DDRAM_COLUMNS;
+    }
+
+    if(((lcd->column - 1) + lcd->len) < end){
+        lcd->line[lcd->len++] = c;
+    }
+}
+
+static void lcd_flush(fmt_sink_t* sink){
+
+    fmt_lcd_sink_t* lcd = (fmt_lcd_sink_t*)sink;
+
+    if(lcd->len > 0){
+        lcd->line[lcd->len] = '\0';
+        hd44780_set_cursor(lcd->row, lcd->column);
+        hd44780_print_string(lcd->line);
+        lcd->column += lcd->len;
+        lcd->len = 0;
+    }
+}
@@ -0,0 +1,160 @@
+/*****************************************************************************************************
+* FILENAME :        fmt.h
+*
+* DESCRIPTION :
+*       Header file containing the prototypes of the APIs for the integer only formatted output engine.
+*
+* PUBLIC FUNCTIONS :
+*       int     fmt_printf(fmt_sink_t* sink, const char* format, ...)
+*       int     fmt_vprintf(fmt_sink_t* sink, const char* format, va_list args)
+*       int     fmt_snprintf(char* buf, uint32_t size, const char* format, ...)
+*       void    fmt_buf_sink_init(fmt_buf_sink_t* sink, char* buf, uint32_t size)
+*       void    fmt_console_sink_init(fmt_console_sink_t* sink, int fd)
+*       void    fmt_lcd_sink_init(fmt_lcd_sink_t* sink, uint8_t row, uint8_t column)
+*
+* NOTES :
+*       Supported conversions: %d %i %u %x %X %c %s %%, with the '-' and '0' flags, a field width and
+*       the 'l' length modifier. There is no floating point support and no heap usage, and all the
+*       state lives in the sink so the functions are reentrant.
+*
+**/
+
+#ifndef FMT_H
+#define FMT_H
+
+#include <stdint.h>
+#include <stdarg.h>
+
+/**
+ * Application configurable items
+ */
+#define FMT_CONSOLE_LINE_LEN    64  /* Console sink buffer, flushed on '\n' or when full */
+#define FMT_LCD_COLUMNS         16  /* LCD sink line length */
+
+/**
+ * Output sink. Specific sinks embed this structure as their first member.
+ */
+typedef struct fmt_sink fmt_sink_t;
+struct fmt_sink
+{
+    void (*putc)(fmt_sink_t* sink, char c);     /* Called for every output character */
+    void (*flush)(fmt_sink_t* sink);            /* Called at the end of every fmt_printf, may be NULL */
+};
+
+/**
+ * Sink writing into a RAM buffer, always NUL terminated.
+ */
+typedef struct
+{
+    fmt_sink_t sink;
+    char* buf;
+    uint32_t size;
+    uint32_t len;
+}fmt_buf_sink_t;
+
+/**
+ * Sink writing to a file descriptor of the C library (debug console).
+ */
+typedef struct
+{
+    fmt_sink_t sink;
+    int fd;
+    uint32_t len;
+    char line[FMT_CONSOLE_LINE_LEN];
+}fmt_console_sink_t;
+
+/**
+ * Sink writing into a line buffer which is sent to the LCD at a given position on flush.
+ */
+typedef struct
+{
+    fmt_sink_t sink;
+    uint8_t row;
+    uint8_t column;
+    uint8_t len;
+    char line[FMT_LCD_COLUMNS + 1];
+}fmt_lcd_sink_t;
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn fmt_printf
+ *
+ * @brief function to write formatted output to a sink.
+ *
+ * @param[in] sink where the output is written.
+ * @param[in] format is the format string.
+ *
+ * @return number of characters written.
+ */
+int fmt_printf(fmt_sink_t* sink, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+ * @fn fmt_vprintf
+ *
+ * @brief function to write formatted output to a sink from a variable argument list.
+ *
+ * @param[in] sink where the output is written.
+ * @param[in] format is the format string.
+ * @param[in] args is the variable argument list.
+ *
+ * @return number of characters written.
+ */
+int fmt_vprintf(fmt_sink_t* sink, const char* format, va_list args);
+
+/**
+ * @fn fmt_snprintf
+ *
+ * @brief function to write formatted output into a RAM buffer.
+ *
+ * @param[out] buf is the buffer where the output is stored, always NUL terminated if size > 0.
+ * @param[in] size of the buffer.
+ * @param[in] format is the format string.
+ *
+ * @return number of characters stored, not counting the NUL terminator.
+ */
+int fmt_snprintf(char* buf, uint32_t size, const char* format, ...) __attribute__((format(printf, 3, 4)));
+
+/**
+ * @fn fmt_buf_sink_init
+ *
+ * @brief function to initialize a RAM buffer sink.
+ *
+ * @param[out] sink is the sink to be initialized.
+ * @param[in] buf is the buffer where the output is stored.
+ * @param[in] size of the buffer.
+ *
+ * @return void
+ */
+void fmt_buf_sink_init(fmt_buf_sink_t* sink, char* buf, uint32_t size);
+
+/**
+ * @fn fmt_console_sink_init
+ *
+ * @brief function to initialize a console sink.
+ *
+ * @param[out] sink is the sink to be initialized.
+ * @param[in] fd is the file descriptor passed to write() (1 for stdout).
+ *
+ * @return void
+ */
+void fmt_console_sink_init(fmt_console_sink_t* sink, int fd);
+
+/**
+ * @fn fmt_lcd_sink_init
+ *
+ * @brief function to initialize an LCD sink.
+ *
+ * @param[out] sink is the sink to be initialized.
+ * @param[in] row where the output is printed (1 to 2).
+ * @param[in] column where the output starts, a DDRAM column (1 to 40, see hd44780_page_set_cursor).
+ *
+ * @return void
+ *
+ * @note output beyond the end of the 16 column page, or of the 40 DDRAM columns, is discarded.
+ */
+void fmt_lcd_sink_init(fmt_lcd_sink_t* sink, uint8_t row, uint8_t column);
+
+#endif /* FMT_H */
@@ -0,0 +1,45 @@
+/*****************************************************************************************************
+* FILENAME :        fmt_size.c
+*
+* DESCRIPTION :
+*       File containing the entry point of the formatter size images (make fmtsize). It formats the
+*       conversions used by the application with fmt_snprintf, or with the snprintf of the C library
+*       (newlib nano) when built with FMT_SIZE_LIBC = 1.
+*
+* NOTES :
+*       Each image is linked with fmt_size_entry as its only root and --gc-sections, without the
+*       startup code, so its text and data are the formatter and what it pulls in, plus this file.
+*       The images are only measured, never run.
+*
+**/
+
+#include <stdint.h>
+
+#ifndef FMT_SIZE_LIBC
+#define FMT_SIZE_LIBC           0
+#endif
+
+#if FMT_SIZE_LIBC
+#include <stdio.h>
+#define FMT_SIZE_SNPRINTF       snprintf
+#else
+#include "fmt.h"
+#define FMT_SIZE_SNPRINTF       fmt_snprintf
+#endif
+
+char fmt_size_buf[96];
+volatile uint32_t fmt_size_args[3];
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void fmt_size_entry(void){
+
+    FMT_SIZE_SNPRINTF(fmt_size_buf, sizeof(fmt_size_buf), "%02u:%-8s|%5d|%08x|%X|%c|%ld|%i",
+                      (unsigned int)fmt_size_args[0], "idle", (int)fmt_size_args[1],
+                      (unsigned int)fmt_size_args[2], (unsigned int)fmt_size_args[2], '#',
+                      (long)fmt_size_args[1], (int)fmt_size_args[0]);
+
+    for(;;);
+}
@@ -0,0 +1,386 @@
+/*****************************************************************************************************
+* FILENAME :        idle.c
+*
+* DESCRIPTION :
+*       File containing the tickless low power idle manager.
+*
+* PUBLIC FUNCTIONS :
+*       void    idle_init(uint32_t systick_clk)
+*       void    idle_enter(void)
+*       void    idle_get_stats(idle_stats_t* stats)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+*       Sleep mode: SysTick is reloaded with the time to the next deadline, so the only interrupt is
+*       the wake up one. If another interrupt wakes the core earlier, the elapsed time is read back
+*       from SysTick, the scheduler is advanced by the suppressed ticks and SysTick is realigned with
+*       the tick boundaries.
+*
+*       Stop mode: every clock but LSI is off, so the RTC wakeup timer (LSI / 16) is programmed with
+*       the time to the next deadline and it is the only enabled wakeup source. The scheduler is
+*       advanced by the programmed time, so its accuracy is the LSI one; the RTC task reads the time
+*       from the DS1307, so the displayed time is not affected. The wakeup timer counter cannot be
+*       read, so if another interrupt wakes the core earlier the time actually spent is measured
+*       with the RTC calendar, also clocked by LSI, read before and after Stop mode with a
+*       resolution of 1 / IDLE_RTC_SS_HZ; the part below one tick is carried to the next early
+*       wake. Stop mode is skipped while the LCD or the UART console are sending data, as their
+*       clocks would be stopped in the middle. The core leaves Stop mode on HSI, so the wakeup also
+*       takes the time of sysclk_restore (HSE start, PLL lock and over-drive switch), during which
+*       neither SysTick nor the wakeup timer count. It is measured once with the DWT cycle counter,
+*       on the first wakeup, and added to the part of a tick carried by idle_stop_rem on every
+*       wakeup; the Stop mode exit latency before the first instruction is not counted.
+*
+**/
+
+#include "idle.h"
+#include "trace.h"
+#include "sched.h"
+#include "event.h"
+#include "hd44780.h"
+#include "uart_console.h"
+#include "sysclk.h"
+#include "rcc_driver.h"
+#include "tickmon.h"
+#include "stm32f446xx.h"
+#include <stdint.h>
+
+#define IDLE_MIN_SLEEP_CYCLES       64      /* Do not reprogram SysTick if the tick is this close */
+#define IDLE_WUT_HZ                 (IDLE_LSI_HZ / 16)
+#define IDLE_RTC_PREDIV_A           7       /* Calendar subseconds at LSI / 8 */
+#define IDLE_RTC_SS_HZ              (IDLE_LSI_HZ / (IDLE_RTC_PREDIV_A + 1))
+#define IDLE_RTC_DAY                (86400UL * IDLE_RTC_SS_HZ)
+
+static uint32_t idle_tick_cycles = 0;       /* SysTick cycles per scheduler tick */
+static uint32_t idle_max_sleep_ticks = 0;   /* Longest SysTick reload, 24 bits */
+static uint64_t idle_sleep_cycles = 0;
+static uint32_t idle_stop_ticks = 0;
+static uint32_t idle_sleeps = 0;
+static uint32_t idle_stops = 0;
+static uint32_t idle_early_wakes = 0;
+static uint32_t idle_stop_rem = 0;          /* Part of a tick left by the wakes, in ms * SS_HZ */
+static uint32_t idle_wake_cycles = 0;       /* Cycles of sysclk_restore, 0 until the first Stop wake */
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn idle_sleep
+ *
+ * @brief function to wait in Sleep mode with the SysTick interrupt suppressed.
+ *
+ * @param[in] ticks until the next deadline.
+ *
+ * @return void.
+ *
+ * @note it must be called with interrupts disabled.
+ */
+static void idle_sleep(uint32_t ticks);
+
+/**
+ * @fn idle_stop
+ *
+ * @brief function to wait in Stop mode until the RTC wakeup timer expires.
+ *
+ * @param[in] ticks until the next deadline.
+ *
+ * @return void.
+ *
+ * @note it must be called with interrupts disabled.
+ */
+static void idle_stop(uint32_t ticks);
+
+/**
+ * @fn idle_rtc_init
+ *
+ * @brief function to clock the RTC from LSI and prepare its wakeup timer and interrupt.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ */
+static void idle_rtc_init(void);
+
+/**
+ * @fn idle_rtc_now
+ *
+ * @brief function to read the time of day of the RTC calendar.
+ *
+ * @param[in] void.
+ *
+ * @return time in 1 / IDLE_RTC_SS_HZ units since 00:00:00.
+ */
+static uint32_t idle_rtc_now(void);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void idle_init(uint32_t systick_clk){
+
+    idle_tick_cycles = systick_clk / SCHED_TICK_HZ;
+    idle_max_sleep_ticks = 0x00FFFFFF / idle_tick_cycles;
+
+#if IDLE_DEBUG_LOW_POWER
+    *DBGMCU_CR |= (1 << DBGMCU_CR_DBG_SLEEP) | (1 << DBGMCU_CR_DBG_STOP);
+#endif
+
+#if IDLE_STOP_ENABLE
+    idle_rtc_init();
+#endif
+}
+
+void idle_enter(void){
+
+    uint32_t ticks = 0;
+
+    __asm volatile("cpsid i" ::: "memory");
+
+    /* An interrupt may have posted an event or the tick may have made a task due */
+    ticks = sched_get_idle_ticks();
+
+    if(!event_is_pending() && (ticks != 0)){
+        if(IDLE_STOP_ENABLE && (ticks >= IDLE_STOP_MIN_MS) && !hd44780_is_busy() && !uart_console_is_busy()){
+            idle_stop(ticks);
+        }
+        else{
+            idle_sleep(ticks);
+        }
+    }
+
+    /* The pending interrupt which woke up the core is served here */
+    __asm volatile("cpsie i" ::: "memory");
+}
+
+void idle_get_stats(idle_stats_t* stats){
+
+    stats->sleep_ms = (uint32_t)(idle_sleep_cycles / idle_tick_cycles);
+    stats->stop_ms = idle_stop_ticks;
+    stats->awake_ms = sched_get_ticks() - stats->sleep_ms - stats->stop_ms;
+    stats->sleeps = idle_sleeps;
+    stats->stops = idle_stops;
+    stats->early_wakes = idle_early_wakes;
+    stats->wake_us = idle_wake_cycles / (RCC_HSI_VALUE / 1000000U);
+}
+
+void RTC_WKUP_Handler(void){
+
+    /* Flags are normally cleared by idle_stop, this only serves the pending interrupt */
+    RTC->ISR &= ~(1 << RTC_ISR_WUTF);
+    EXTI->PR = (1 << EXTI_LINE_RTC_WKUP);
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static void idle_sleep(uint32_t ticks){
+
+    uint32_t cvr = 0;
+    uint32_t reload = 0;
+    uint32_t elapsed = 0;
+    uint32_t remaining = 0;
+    uint32_t suppressed = 0;
+    uint32_t csr = 0;
+
+    if(ticks > idle_max_sleep_ticks){
+        ticks = idle_max_sleep_ticks;
+    }
+
+    *SYST_CSR &= ~(1 << SYST_CSR_ENABLE);
+    cvr = *SYST_CVR;
+
+    if((*SCB_ICSR & (1 << SCB_ICSR_PENDSTSET)) || (cvr < IDLE_MIN_SLEEP_CYCLES)){
+        /* The tick is already pending or about to happen */
+        *SYST_CSR |= (1 << SYST_CSR_ENABLE);
+        return;
+    }
+
+    /* The current tick ends in cvr cycles, then ticks - 1 more */
+    reload = cvr + ((ticks - 1) * idle_tick_cycles);
+    *SYST_RVR = reload;
+    *SYST_CVR = 0;
+    *SYST_CSR |= (1 << SYST_CSR_ENABLE);
+
+    __asm volatile("dsb" ::: "memory");
+    __asm volatile("wfi");
+    __asm volatile("isb" ::: "memory");
+
+    csr = *SYST_CSR;
+    *SYST_CSR &= ~(1 << SYST_CSR_ENABLE);
+
+    if(csr & (1 << SYST_CSR_COUNTFLAG)){
+        /* Woken up by SysTick, Systick_Handler accounts for the last tick */
+        elapsed = reload + 1;
+        suppressed = ticks - 1;
+        remaining = idle_tick_cycles;
+    }
+    else{
+        /* Woken up earlier by another interrupt */
+        elapsed = reload - *SYST_CVR;
+        if(elapsed < cvr){
+            suppressed = 0;
+            remaining = cvr - elapsed;
+        }
+        else{
+            suppressed = 1 + ((elapsed - cvr) / idle_tick_cycles);
+            remaining = idle_tick_cycles - ((elapsed - cvr) % idle_tick_cycles);
+        }
+    }
+
+    /* Finish the current tick and go back to the periodic reload */
+    *SYST_RVR = ((remaining > 1) ? remaining : 2) - 1;
+    *SYST_CVR = 0;
+    *SYST_CSR |= (1 << SYST_CSR_ENABLE);
+    *SYST_RVR = idle_tick_cycles - 1;
+    TICKMON_RESYNC();
+
+    sched_advance(suppressed);
+
+    idle_sleep_cycles += elapsed;
+    idle_sleeps++;
+}
+
+static void idle_stop(uint32_t ticks){
+
+    uint32_t max_ticks = (0x10000UL * 1000) / IDLE_WUT_HZ;
+    uint32_t start = 0;
+    uint32_t elapsed = 0;
+    uint32_t cycles = 0;
+    uint8_t woken = 0;
+
+    if(ticks > max_ticks){
+        ticks = max_ticks;
+    }
+
+    /* SysTick does not run in Stop mode */
+    *SYST_CSR &= ~(1 << SYST_CSR_ENABLE);
+
+    /* Program the wakeup timer */
+    RTC->CR &= ~((1 << RTC_CR_WUTE) | (1 << RTC_CR_WUTIE));
+    while(!(RTC->ISR & (1 << RTC_ISR_WUTWF)));
+    RTC->WUTR = ((ticks * IDLE_WUT_HZ) / 1000) - 1;
+    RTC->ISR &= ~(1 << RTC_ISR_WUTF);
+    EXTI->PR = (1 << EXTI_LINE_RTC_WKUP);
+    RTC->CR |= (1 << RTC_CR_WUTE) | (1 << RTC_CR_WUTIE);
+
+    start = idle_rtc_now();
+
+    /* Stop mode with the regulator in low power mode */
+    PWR->CR &= ~(1 << PWR_CR_PDDS);
+    PWR->CR |= (1 << PWR_CR_LPDS) | (1 << PWR_CR_CWUF);
+    *SCB_SCR |= (1 << SCB_SCR_SLEEPDEEP);
+
+    __asm volatile("dsb" ::: "memory");
+    __asm volatile("wfi");
+    __asm volatile("isb" ::: "memory");
+
+    cycles = *DWT_CYCCNT;
+    *SCB_SCR &= ~(1 << SCB_SCR_SLEEPDEEP);
+
+    woken = (RTC->ISR & (1 << RTC_ISR_WUTF)) ? 1 : 0;
+    elapsed = (idle_rtc_now() + IDLE_RTC_DAY - start) % IDLE_RTC_DAY;
+    RTC->CR &= ~((1 << RTC_CR_WUTE) | (1 << RTC_CR_WUTIE));
+    RTC->ISR &= ~(1 << RTC_ISR_WUTF);
+    EXTI->PR = (1 << EXTI_LINE_RTC_WKUP);
+
+    /* The system clock is HSI when leaving Stop mode, the boot clock source and the PLL are started
+     * again. The cycles are counted on HSI, the core only runs at 180 MHz after the last one */
+    sysclk_restore();
+    if(idle_wake_cycles == 0){
+        idle_wake_cycles = *DWT_CYCCNT - cycles;
+    }
+
+    /* Neither SysTick nor the wakeup timer counted the restore, it is carried as part of a tick */
+    idle_stop_rem += (uint32_t)(((uint64_t)idle_wake_cycles * 1000 * IDLE_RTC_SS_HZ) / RCC_HSI_VALUE);
+
+    if(woken){
+        elapsed = ticks + (idle_stop_rem / IDLE_RTC_SS_HZ);
+        idle_stop_rem %= IDLE_RTC_SS_HZ;
+        sched_advance(elapsed);
+        idle_stop_ticks += elapsed;
+    }
+    else{
+        /* Advance by the time spent until the wakeup interrupt, less than the programmed one */
+        idle_stop_rem += elapsed * 1000;
+        elapsed = idle_stop_rem / IDLE_RTC_SS_HZ;
+        idle_stop_rem %= IDLE_RTC_SS_HZ;
+        if(elapsed >= ticks){
+            elapsed = ticks - 1;
+        }
+        sched_advance(elapsed);
+        idle_stop_ticks += elapsed;
+        idle_early_wakes++;
+        TRACE("idle: early wake from stop, %u of %u ms", elapsed, ticks);
+    }
+    idle_stops++;
+
+    /* Start a new tick */
+    *SYST_CVR = 0;
+    *SYST_CSR |= (1 << SYST_CSR_ENABLE);
+    TICKMON_RESYNC();
+}
+
+static void idle_rtc_init(void){
+
+    /* Enable the write access to the backup domain */
+    PWR_PCLK_EN();
+    PWR->CR |= (1 << PWR_CR_DBP);
+
+    /* LSI is the only clock running in Stop mode */
+    RCC->CSR |= (1 << RCC_CSR_LSION);
+    while(!(RCC->CSR & (1 << RCC_CSR_LSIRDY)));
+
+    /* The RTC clock source can only be changed after a backup domain reset, the internal RTC is
+     * not used for timekeeping (it is the DS1307) */
+    if(((RCC->BDCR >> RCC_BDCR_RTCSEL) & 0x3) != 0x2){
+        RCC->BDCR |= (1 << RCC_BDCR_BDRST);
+        RCC->BDCR &= ~(1 << RCC_BDCR_BDRST);
+        RCC->BDCR |= (0x2 << RCC_BDCR_RTCSEL);
+    }
+    RCC->BDCR |= (1 << RCC_BDCR_RTCEN);
+
+    /* Unlock the RTC registers */
+    RTC->WPR = 0xCA;
+    RTC->WPR = 0x53;
+
+    /* Calendar subseconds counted at IDLE_RTC_SS_HZ, the two prescalers are written separately. The
+     * counters are read directly (BYPSHAD), the shadow registers are not updated in Stop mode */
+    RTC->ISR |= (1 << RTC_ISR_INIT);
+    while(!(RTC->ISR & (1 << RTC_ISR_INITF)));
+    RTC->PRER = (IDLE_RTC_SS_HZ - 1) << RTC_PRER_PREDIV_S;
+    RTC->PRER |= IDLE_RTC_PREDIV_A << RTC_PRER_PREDIV_A;
+    RTC->ISR &= ~(1 << RTC_ISR_INIT);
+    RTC->CR |= (1 << RTC_CR_BYPSHAD);
+
+    /* Wakeup timer clocked by RTCCLK / 16 */
+    RTC->CR &= ~((1 << RTC_CR_WUTE) | (1 << RTC_CR_WUTIE));
+    while(!(RTC->ISR & (1 << RTC_ISR_WUTWF)));
+    RTC->CR &= ~(0x7 << RTC_CR_WUCKSEL);
+
+    /* The wakeup timer reaches the NVIC through the EXTI line 22 */
+    EXTI->IMR |= (1 << EXTI_LINE_RTC_WKUP);
+    EXTI->RTSR |= (1 << EXTI_LINE_RTC_WKUP);
+    *NVIC_ISER0 |= (1 << IRQ_NO_RTC_WKUP);
+}
+
+static uint32_t idle_rtc_now(void){
+
+    uint32_t ssr = 0;
+    uint32_t tr = 0;
+    uint32_t secs = 0;
+
+    /* The counters are read directly (BYPSHAD), read again if a second ended in the meantime */
+    do{
+        ssr = RTC->SSR;
+        tr = RTC->TR;
+    }while(RTC->SSR > ssr);
+
+    secs = ((((tr >> RTC_TR_HT) & 0x3) * 10) + ((tr >> RTC_TR_HU) & 0xF)) * 3600;
+    secs += ((((tr >> RTC_TR_MNT) & 0x7) * 10) + ((tr >> RTC_TR_MNU) & 0xF)) * 60;
+    secs += (((tr >> RTC_TR_ST) & 0x7) * 10) + ((tr >> RTC_TR_SU) & 0xF);
+
+    /* SSR counts down from PREDIV_S to 0 during each second */
+    return (secs * IDLE_RTC_SS_HZ) + ((IDLE_RTC_SS_HZ - 1) - (ssr & 0xFFFF));
+}
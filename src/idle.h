@@ -0,0 +1,91 @@
+/*****************************************************************************************************
+* FILENAME :        idle.h
+*
+* DESCRIPTION :
+*       Header file containing the prototypes of the APIs for the tickless low power idle manager.
+*
+* PUBLIC FUNCTIONS :
+*       void    idle_init(uint32_t systick_clk)
+*       void    idle_enter(void)
+*       void    idle_get_stats(idle_stats_t* stats)
+*
+* NOTES :
+*       idle_enter is called from the main loop once the events and the due tasks have been handled.
+*       The SysTick interrupt is suppressed until the next task deadline and the core waits in Sleep
+*       mode (WFI), or in Stop mode woken up by the RTC wakeup timer when the next deadline is far
+*       enough and no peripheral transfer is in progress.
+*
+**/
+
+#ifndef IDLE_H
+#define IDLE_H
+
+#include <stdint.h>
+
+/**
+ * Application configurable items
+ */
+#define IDLE_STOP_ENABLE            1       /* Use Stop mode for long idle periods */
+#define IDLE_STOP_MIN_MS            20      /* Shortest idle period using Stop mode */
+#define IDLE_LSI_HZ                 32000   /* Nominal LSI frequency, clock of the RTC wakeup timer */
+#ifndef IDLE_DEBUG_LOW_POWER
+#define IDLE_DEBUG_LOW_POWER        0       /* 1 keeps the debugger connected in Sleep and Stop mode, set
+                                               by the debug build profile */
+#endif
+
+/**
+ * Time spent in each power state since idle_init.
+ */
+typedef struct
+{
+    uint32_t awake_ms;
+    uint32_t sleep_ms;
+    uint32_t stop_ms;
+    uint32_t sleeps;        /* Number of Sleep mode periods */
+    uint32_t stops;         /* Number of Stop mode periods */
+    uint32_t early_wakes;   /* Stop mode periods ended by another wakeup source */
+    uint32_t wake_us;       /* Time to restore the clocks after Stop mode, measured on the first one */
+}idle_stats_t;
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn idle_init
+ *
+ * @brief function to initialize the idle manager and the RTC wakeup timer.
+ *
+ * @param[in] systick_clk is the SysTick clock frequency in Hz.
+ *
+ * @return void
+ *
+ * @note SysTick must be already running at SCHED_TICK_HZ.
+ */
+void idle_init(uint32_t systick_clk);
+
+/**
+ * @fn idle_enter
+ *
+ * @brief function to wait in a low power mode until the next task deadline or interrupt.
+ *
+ * @param[in] void
+ *
+ * @return void
+ *
+ * @note it returns immediately if an event is pending or a task is due.
+ */
+void idle_enter(void);
+
+/**
+ * @fn idle_get_stats
+ *
+ * @brief function to get the time spent awake and in each low power mode.
+ *
+ * @param[out] stats where the accounting is copied.
+ *
+ * @return void
+ */
+void idle_get_stats(idle_stats_t* stats);
+
+#endif /* IDLE_H */
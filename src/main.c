@@ -6,104 +6,229 @@
 *
 **/
 
-#include <stdio.h>
 #include <stdint.h>
 #include "ds1307.h"
 #include "hd44780.h"
-
-#define SYSTICK_TIM_CLK     16000000UL
+#include "fmt.h"
+#include "event.h"
+#include "sched.h"
+#include "idle.h"
+#include "app.h"
+#include "rtt.h"
+#include "uart_console.h"
+#include "trace.h"
+#include "boot.h"
+#include "rcc_driver.h"
+#include "stack.h"
+#include "prof.h"
+#include "bustrace.h"
+#include "tickmon.h"
+#include "timesnap.h"
+#include "stm32f446xx.h"
+
+#define SPLASH_TIME_MS      2000
+#define RTC_PERIOD_MS       1000
+#define STATS_PERIOD_MS     60000
+#define COMMAND_PERIOD_MS   200
+
+/* Scheduler tasks */
+static uint8_t rtc_task_id = SCHED_INVALID_ID;
+static uint8_t lcd_task_id = SCHED_INVALID_ID;
+static uint8_t console_task_id = SCHED_INVALID_ID;
+static uint8_t boot_task_id = SCHED_INVALID_ID;
 
 extern void initialise_monitor_handles(void);
 
 /**
- * @fn get_day_week
+ * @fn rtc_task
  *
- * @brief function to convert the number of the day of the week into the name.
+ * @brief task to read the date and time from the RTC, publish them (timesnap.h) and trigger the LCD
+ *        and console tasks.
  *
- * @param[in] number of the day of the week.
+ * @param[in] void.
  *
- * @return string with the name of the day of the week.
+ * @return void.
  */
-static char* get_day_week(uint8_t day){
+static void rtc_task(void){
+
+    RTC_time_t current_time;
+    RTC_date_t current_date;
 
-    char* days[] = {"Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"};
+    PROF_CALL("ds1307_get_current_time", ds1307_get_current_time(&current_time));
+    ds1307_get_current_date(&current_date);
+    timesnap_publish(&current_time, &current_date);
 
-    return days[day-1];
+    TRACE("rtc: %02u:%02u:%02u", current_time.hours, current_time.minutes, current_time.seconds);
+
+    sched_start(lcd_task_id, 0);
+    sched_start(console_task_id, 0);
 }
 
 /**
- * @fn number_to_str
+ * @fn lcd_task
  *
- * @brief function to convert a number into a string.
+ * @brief task to print the last date and time read from the RTC in the LCD.
  *
- * @param[in] number in integer 8bits format.
- * @param[out] string with the converted number.
+ * @param[in] void.
  *
  * @return void.
  */
-static void number_to_str(uint8_t num, char* buf){
+static void lcd_task(void){
 
-    if(num < 10){
-        buf[0] = '0';
-        buf[1] = num + 48; /* Conver to ASCII */
-    }
-    else if((num >= 10) && (num < 99)){
-        buf[0] = (num / 10) + 48;
-        buf[1] = (num % 10) + 48;
-    }
-    else{
-        /* do nothing */
+    RTC_time_t current_time;
+    RTC_date_t current_date;
+
+    timesnap_read(&current_time, &current_date);
+    app_lcd_show(&current_time, &current_date);
+
+    if(!boot_is_marked(BOOT_PHASE_FIRST_FRAME)){
+        boot_mark(BOOT_PHASE_FIRST_FRAME);
+        sched_start(boot_task_id, 0);
     }
 }
 
 /**
- * @fn time_to_str
+ * @fn console_task
  *
- * @brief function to create a string with time values.
+ * @brief task to print the last date and time read from the RTC in the console.
  *
- * @param[in] time struct with the time values.
+ * @param[in] void.
  *
- * @return string with the time values in format hh:mm:ss.
+ * @return void.
  */
-static char* time_to_str(RTC_time_t* time){
+static void console_task(void){
 
-    static char buf[9] = {0};
+    fmt_console_sink_t console;
+    RTC_time_t current_time;
+    RTC_date_t current_date;
 
-    buf[2] = ':';
-    buf[5] = ':';
+    timesnap_read(&current_time, &current_date);
+    fmt_console_sink_init(&console, 1);
+    app_console_show(&console.sink, &current_time, &current_date);
+}
 
-    number_to_str(time->hours, buf);
-    number_to_str(time->minutes, &buf[3]);
-    number_to_str(time->seconds, &buf[6]);
+/**
+ * @fn splash_task
+ *
+ * @brief one-shot task to clear the splash message and start the RTC refresh.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ */
+static void splash_task(void){
 
-    buf[8] = '\0';
+    hd44780_display_clear();
+    hd44780_display_return_home();
 
-    return buf;
+    sched_start(rtc_task_id, 0);
 }
 
 /**
- * @fn date_to_str
+ * @fn boot_task
  *
- * @brief function to create a string with date values.
+ * @brief one-shot task to print the time of every boot phase in the console, once the first frame
+ *        is shown.
  *
- * @param[in] date struct with the date values.
+ * @param[in] void.
  *
- * @return string with the date values in format dd/mm/yy.
+ * @return void.
  */
-static char* date_to_str(RTC_date_t* date){
+static void boot_task(void){
 
-    static char buf[9] = {0};
+    fmt_console_sink_t console;
+    uint32_t cycles_per_us = RCC_GetHCLKValue() / 1000000UL;
+    uint8_t phase = 0;
 
-    buf[2] = '/';
-    buf[5] = '/';
+    fmt_console_sink_init(&console, 1);
+    for(phase = 0; phase < BOOT_PHASES; phase++){
+        fmt_printf(&console.sink, "Boot %s: %u us\n", boot_get_name(phase),
+                   (unsigned int)boot_get_us(phase, cycles_per_us));
+    }
 
-    number_to_str(date->date, buf);
-    number_to_str(date->month, &buf[3]);
-    number_to_str(date->year, &buf[6]);
+    TRACE("boot: first frame at %u us", boot_get_us(BOOT_PHASE_FIRST_FRAME, cycles_per_us));
+}
+
+/**
+ * @fn stats_task
+ *
+ * @brief task to print the runtime accounting of every task in the console.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ */
+static void stats_task(void){
+
+    fmt_console_sink_t console;
+    sched_stats_t stats;
+    idle_stats_t idle;
+    uint8_t id = 0;
+
+    fmt_console_sink_init(&console, 1);
+    fmt_printf(&console.sink, "Stack: %u of %u bytes used\n", (unsigned int)stack_get_used(),
+               (unsigned int)stack_get_size());
+    fmt_printf(&console.sink, "Dropped: RTT %u bytes, UART %u bytes, trace %u records\n",
+               (unsigned int)rtt_get_dropped(RTT_CHANNEL_TERMINAL), (unsigned int)uart_console_get_dropped(),
+               (unsigned int)trace_get_dropped());
+
+    idle_get_stats(&idle);
+    fmt_printf(&console.sink, "Power: awake %u ms, sleep %u ms (%u), stop %u ms (%u), %u early wakes, wake %u us\n",
+               (unsigned int)idle.awake_ms, (unsigned int)idle.sleep_ms, (unsigned int)idle.sleeps,
+               (unsigned int)idle.stop_ms, (unsigned int)idle.stops, (unsigned int)idle.early_wakes,
+               (unsigned int)idle.wake_us);
+
+    for(id = 0; sched_get_stats(id, &stats) == 0; id++){
+        fmt_printf(&console.sink, "Task %s: %u runs, %u overruns, max %u cycles, avg %u cycles\n", stats.name,
+                   (unsigned int)stats.runs, (unsigned int)stats.overruns, (unsigned int)stats.cycles_max,
+                   (unsigned int)(stats.runs ? (stats.cycles_total / stats.runs) : 0));
+    }
+
+#if TICKMON_ENABLE
+    tickmon_dump(&console.sink);
+#endif
+}
+
+#if PROF_ENABLE || TICKMON_ENABLE
+/**
+ * @fn command_task
+ *
+ * @brief task to run the profiler and tick monitor commands received from the debug console (RTT
+ *        down channel).
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ */
+static void command_task(void){
+
+    fmt_console_sink_t console;
+    char cmd = 0;
+
+    fmt_console_sink_init(&console, 1);
+    while(rtt_read(&cmd, 1) != 0){
+#if PROF_ENABLE
+        prof_command(cmd, &console.sink);
+#endif
+#if TICKMON_ENABLE
+        tickmon_command(cmd, &console.sink);
+#endif
+    }
+}
+#endif
 
-    buf[8] = '\0';
+/**
+ * @fn sched_handler
+ *
+ * @brief function to run the due tasks, handler of SCHED_EVENT.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ */
+static void sched_handler(void){
 
-    return buf;
+    sched_run();
 }
 
 /**
@@ -123,8 +248,8 @@ static void init_systick_timer(uint32_t tick_hz){
     uint32_t* pSTK_LOAD = (uint32_t*)0xE000E014;
     uint32_t* pSTK_CTRL = (uint32_t*)0xE000E010;
 
-    /* Calculation of reload value */
-    count_value = (SYSTICK_TIM_CLK / tick_hz) - 1;
+    /* Calculation of reload value, SysTick is clocked by HCLK */
+    count_value = (RCC_GetHCLKValue() / tick_hz) - 1;
 
     /* Clear the value of SVR */
     *pSTK_LOAD &= ~(0x00FFFFFF);
@@ -139,49 +264,35 @@ static void init_systick_timer(uint32_t tick_hz){
     *pSTK_CTRL |= (1 << 0);
 }
 
-/**
- * @fn mdelay
- *
- * @brief function to count a number of miliseconds.
- *
- * @param[in] cnt is the number of miliseconds.
- *
- * @return void.
- */
-static void mdelay(uint32_t cnt){
-
-    uint32_t i = 0;
-
-    for(i = 0; i < (cnt * 1000); i++);
-}
-
 int main(void){
 
+    fmt_console_sink_t console;
     RTC_time_t current_time;
     RTC_date_t current_date;
-    char* am_pm = NULL;
 
     initialise_monitor_handles();
 
-    printf("Starting program!!!\n");
+#if BUSTRACE_ENABLE
+    bustrace_init(RCC_GetHCLKValue());
+#endif
 
-    hd44780_init();
+    uart_console_init();
 
-    hd44780_print_string("RTC Test ...");
+    fmt_console_sink_init(&console, 1);
+    fmt_printf(&console.sink, "Starting program!!!\n");
+    fmt_printf(&console.sink, "Clocks: HCLK %u Hz, PCLK1 %u Hz, PCLK2 %u Hz\n", (unsigned int)RCC_GetHCLKValue(),
+               (unsigned int)RCC_GetPCLK1Value(), (unsigned int)RCC_GetPCLK2Value());
 
-    mdelay(2000); /* Set a delay before clean the LCD screen */
+    hd44780_init();
 
-    hd44780_display_clear();
-    hd44780_display_return_home();
+    hd44780_print_string("RTC Test ...");
+    boot_mark(BOOT_PHASE_LCD);
 
     if(ds1307_init()){
-        printf("RTC init failed, please reset manually\n");
+        fmt_printf(&console.sink, "RTC init failed, please reset manually\n");
         while(1);
     }
 
-    /* Initialize the systick timer */
-    init_systick_timer(1);
-
     /* Configure date */
     current_date.day = SATURDAY;
     current_date.date = 17;
@@ -197,67 +308,51 @@ int main(void){
     /* Set date and time into DS1307 */
     ds1307_set_current_date(&current_date);
     ds1307_set_current_time(&current_time);
+    boot_mark(BOOT_PHASE_RTC);
 
-    /* Get date and time from DS1307 */
-    ds1307_get_current_date(&current_date);
-    ds1307_get_current_time(&current_time);
-
-    /* Print time */
-    if(current_time.time_format != T_FORMAT_24HRS){
-        am_pm = current_time.time_format ? "PM" : "AM";
-        printf("Current time: %s %s\n", time_to_str(&current_time), am_pm); /* Format hh:mm:ss <A/P>M */
-        hd44780_print_string(time_to_str(&current_time));
-        hd44780_print_char(' ');
-        hd44780_print_string(am_pm);
-    }
-    else{
-        printf("Current time: %s\n", time_to_str(&current_time)); /* Format hh:mm:ss */
-        hd44780_print_string(time_to_str(&current_time));
-    }
+    /* Stream the trace log by RTT, timestamped by the cycle counter started by Reset_Handler */
+    trace_init();
+
+    /* Create the tasks, the RTC refresh starts when the splash message is cleared */
+    rtc_task_id = sched_add("rtc", rtc_task, RTC_PERIOD_MS);
+    lcd_task_id = sched_add("lcd", lcd_task, 0);
+    console_task_id = sched_add("console", console_task, 0);
+    boot_task_id = sched_add("boot", boot_task, 0);
+    sched_start(sched_add("splash", splash_task, 0), SPLASH_TIME_MS);
+    sched_start(sched_add("stats", stats_task, STATS_PERIOD_MS), STATS_PERIOD_MS);
+#if PROF_ENABLE || TICKMON_ENABLE
+    sched_start(sched_add("command", command_task, COMMAND_PERIOD_MS), COMMAND_PERIOD_MS);
+#endif
 
-    /* Print date */
-    printf("Current date: %s <%s>\n", date_to_str(&current_date), get_day_week(current_date.day));
-    hd44780_set_cursor(2, 1); /* Change to 2 row before print date in LCD */
-    hd44780_print_string(date_to_str(&current_date));
-    hd44780_print_char('<');
-    hd44780_print_string(get_day_week(current_date.day));
-    hd44780_print_char('>');
+#if TICKMON_ENABLE
+    tickmon_init(RCC_GetHCLKValue() / SCHED_TICK_HZ);
+#endif
+
+    /* Systick_Handler only posts SCHED_EVENT, the tasks run from the main loop */
+    event_register(SCHED_EVENT, sched_handler);
+
+    /* Initialize the systick timer as the scheduler time base */
+    init_systick_timer(SCHED_TICK_HZ);
+
+    /* Sleep between the scheduled tasks */
+    idle_init(RCC_GetHCLKValue());
+
+    boot_mark(BOOT_PHASE_SCHED);
 
     for(;;){
+        event_dispatch();
+        idle_enter();
     }
 
     return 0;
 }
 
-void Systick_Handler(void){
+__RAMFUNC void Systick_Handler(void){
 
-    RTC_date_t current_date;
-    RTC_time_t current_time;
-    char* am_pm = NULL;
-
-    /* Get time */
-    ds1307_get_current_time(&current_time);
-    /* Print time */
-    if(current_time.time_format != T_FORMAT_24HRS){
-        am_pm = current_time.time_format ? "PM" : "AM";
-        printf("Current time: %s %s\n", time_to_str(&current_time), am_pm); /* Format hh:mm:ss <A/P>M */
-        hd44780_set_cursor(1, 1); /* Change to 1 row before print time in LCD */
-        hd44780_print_string(time_to_str(&current_time));
-        hd44780_print_char(' ');
-        hd44780_print_string(am_pm);
-    }
-    else{
-        printf("Current time: %s\n", time_to_str(&current_time)); /* Format hh:mm:ss */
-        hd44780_print_string(time_to_str(&current_time));
-    }
+    TICKMON_ENTRY();
+    PROF_SCOPE("Systick_Handler");
 
-    /* Get date */
-    ds1307_get_current_date(&current_date);
-    /* Print date */
-    printf("Current date: %s <%s>\n", date_to_str(&current_date), get_day_week(current_date.day));
-    hd44780_set_cursor(2, 1); /* Change to 2 row before print date in LCD */
-    hd44780_print_string(date_to_str(&current_date));
-    hd44780_print_char('<');
-    hd44780_print_string(get_day_week(current_date.day));
-    hd44780_print_char('>');
+    sched_tick();
+
+    TICKMON_EXIT();
 }
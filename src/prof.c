@@ -0,0 +1,147 @@
+/*****************************************************************************************************
+* FILENAME :        prof.c
+*
+* DESCRIPTION :
+*       File containing the cycle counter profiler.
+*
+* PUBLIC FUNCTIONS :
+*       void        prof_record(prof_site_t* site, uint32_t cycles)
+*       void        prof_dump(fmt_sink_t* sink)
+*       void        prof_reset(void)
+*       void        prof_command(char cmd, fmt_sink_t* sink)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+**/
+
+#include "prof.h"
+#include "fmt.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#if PROF_ENABLE
+
+/* Sites which recorded at least once, most recent first */
+static prof_site_t* prof_sites = NULL;
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn prof_link
+ *
+ * @brief function to add a site to the dump list.
+ *
+ * @param[in] site is the profiling site.
+ *
+ * @return void.
+ */
+static void prof_link(prof_site_t* site);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void prof_record(prof_site_t* site, uint32_t cycles){
+
+    uint32_t bin = 0;
+
+    if(!site->linked){
+        prof_link(site);
+    }
+
+    /* Bin n holds 2^n to 2^(n+1)-1 cycles, 0 cycles goes with 1 */
+    if(cycles != 0){
+        bin = 31 - __builtin_clz(cycles);
+        if(bin >= PROF_HIST_BINS){
+            bin = PROF_HIST_BINS - 1;
+        }
+    }
+
+    site->count++;
+    site->total += cycles;
+    site->hist[bin]++;
+    if(cycles < site->min){
+        site->min = cycles;
+    }
+    if(cycles > site->max){
+        site->max = cycles;
+    }
+}
+
+void prof_dump(fmt_sink_t* sink){
+
+    prof_site_t* site = NULL;
+    uint32_t bin = 0;
+
+    for(site = prof_sites; site != NULL; site = site->next){
+        if(site->count == 0){
+            fmt_printf(sink, "Prof %s: no runs\n", site->name);
+            continue;
+        }
+
+        fmt_printf(sink, "Prof %s: %u runs, min %u, max %u, mean %u cycles\n", site->name,
+                   (unsigned int)site->count, (unsigned int)site->min, (unsigned int)site->max,
+                   (unsigned int)(site->total / site->count));
+
+        for(bin = 0; bin < PROF_HIST_BINS; bin++){
+            if(site->hist[bin] != 0){
+                fmt_printf(sink, "  %s%u cycles: %u\n", (bin == (PROF_HIST_BINS - 1)) ? ">= " : "< ",
+                           (unsigned int)((bin == (PROF_HIST_BINS - 1)) ? (1UL << bin) : (2UL << bin)),
+                           (unsigned int)site->hist[bin]);
+            }
+        }
+    }
+}
+
+void prof_reset(void){
+
+    prof_site_t* site = NULL;
+    uint32_t bin = 0;
+    uint32_t primask = 0;
+
+    for(site = prof_sites; site != NULL; site = site->next){
+        primask = irq_lock();
+        site->count = 0;
+        site->total = 0;
+        site->min = UINT32_MAX;
+        site->max = 0;
+        for(bin = 0; bin < PROF_HIST_BINS; bin++){
+            site->hist[bin] = 0;
+        }
+        irq_unlock(primask);
+    }
+}
+
+void prof_command(char cmd, fmt_sink_t* sink){
+
+    if(cmd == PROF_CMD_DUMP){
+        prof_dump(sink);
+    }
+    else if(cmd == PROF_CMD_RESET){
+        prof_reset();
+        fmt_printf(sink, "Prof: cleared\n");
+    }
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static void prof_link(prof_site_t* site){
+
+    uint32_t primask = irq_lock();
+
+    /* A handler may have linked it between the check and the lock */
+    if(!site->linked){
+        site->next = prof_sites;
+        prof_sites = site;
+        site->linked = 1;
+    }
+
+    irq_unlock(primask);
+}
+
+#endif /* PROF_ENABLE */
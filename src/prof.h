@@ -0,0 +1,171 @@
+/*****************************************************************************************************
+* FILENAME :        prof.h
+*
+* DESCRIPTION :
+*       Header file containing the cycle counter profiler. Every profiling site keeps the number of
+*       runs, the minimum, maximum and mean duration in CPU cycles and a log2 histogram of the
+*       durations.
+*
+* PUBLIC FUNCTIONS :
+*       void        prof_record(prof_site_t* site, uint32_t cycles)
+*       void        prof_dump(fmt_sink_t* sink)
+*       void        prof_reset(void)
+*       void        prof_command(char cmd, fmt_sink_t* sink)
+*
+* NOTES :
+*       Example, time a block or a single call:
+*
+*           void lcd_task(void){
+*               PROF_SCOPE("lcd_task");
+*               ...
+*           }
+*
+*           PROF_CALL("ds1307_get_current_time", ds1307_get_current_time(&current_time));
+*
+*       PROF_SCOPE measures from its declaration to the end of the enclosing block (any return
+*       included, with the GCC cleanup attribute). Each site is a static variable which is linked
+*       in the dump list the first time it records, so only the sites which ran are shown.
+*
+*       The durations come from the DWT cycle counter started by Reset_Handler; the time taken by
+*       interrupt handlers in the middle of a measured block is included. A site must record from a
+*       single context (thread or one handler), the dump may show a record being written.
+*
+*       PROF_ENABLE 0 (default) removes every site, the measurement code and the command. The debug
+*       build profile of the Makefile sets it from the command line (-DPROF_ENABLE=1).
+*
+**/
+
+#ifndef PROF_H
+#define PROF_H
+
+#include <stdint.h>
+#include "fmt.h"
+#include "stm32f446xx.h"
+
+/**
+ * Application configurable items
+ */
+#ifndef PROF_ENABLE
+#define PROF_ENABLE             0       /* 1 builds the profiling sites */
+#endif
+#define PROF_HIST_BINS          24      /* Bin n counts durations of 2^n to 2^(n+1)-1 cycles */
+
+/**
+ * @PROF_CMD
+ * Console commands handled by prof_command.
+ */
+#define PROF_CMD_DUMP           'p'     /* Print every site */
+#define PROF_CMD_RESET          'r'     /* Clear every site */
+
+/**
+ * Profiling site, the last histogram bin also counts the longer durations.
+ */
+typedef struct prof_site
+{
+    const char* name;               /* Name shown in the dump */
+    struct prof_site* next;         /* Next site in the dump list */
+    uint8_t linked;                 /* 1 once the site is in the dump list */
+    uint32_t count;                 /* Number of records */
+    uint32_t min;                   /* Shortest duration in CPU cycles */
+    uint32_t max;                   /* Longest duration in CPU cycles */
+    uint64_t total;                 /* Sum of all durations in CPU cycles */
+    uint32_t hist[PROF_HIST_BINS];  /* log2 histogram of the durations */
+}prof_site_t;
+
+/**
+ * Running measurement of a PROF_SCOPE.
+ */
+typedef struct
+{
+    prof_site_t* site;
+    uint32_t start;
+}prof_scope_t;
+
+#define PROF_SITE_INIT(site_name)   {.name = (site_name), .min = UINT32_MAX}
+#define PROF_CONCAT_(a, b)          a##b
+#define PROF_CONCAT(a, b)           PROF_CONCAT_(a, b)
+
+/**
+ * Time the rest of the enclosing block, or a single statement.
+ */
+#if PROF_ENABLE
+#define PROF_SCOPE(site_name)                                                                       \
+    static prof_site_t PROF_CONCAT(prof_site_, __LINE__) = PROF_SITE_INIT(site_name);               \
+    prof_scope_t PROF_CONCAT(prof_scope_, __LINE__) __attribute__((cleanup(prof_scope_end))) =      \
+        prof_scope_begin(&PROF_CONCAT(prof_site_, __LINE__))
+#define PROF_CALL(site_name, stmt)  do{ PROF_SCOPE(site_name); stmt; }while(0)
+#else
+#define PROF_SCOPE(site_name)       do{}while(0)
+#define PROF_CALL(site_name, stmt)  do{ stmt; }while(0)
+#endif
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn prof_record
+ *
+ * @brief function to add a duration to a site, it is called at the end of PROF_SCOPE.
+ *
+ * @param[in] site is the profiling site.
+ * @param[in] cycles is the duration in CPU cycles.
+ *
+ * @return void
+ *
+ * @note it never waits and it can be called from interrupt handlers.
+ */
+void prof_record(prof_site_t* site, uint32_t cycles);
+
+/**
+ * @fn prof_dump
+ *
+ * @brief function to print every site which recorded: runs, min, max and mean cycles, and the non
+ *        empty histogram bins.
+ *
+ * @param[in] sink is the output.
+ *
+ * @return void
+ */
+void prof_dump(fmt_sink_t* sink);
+
+/**
+ * @fn prof_reset
+ *
+ * @brief function to clear the records of every site, the sites stay in the dump list.
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+void prof_reset(void);
+
+/**
+ * @fn prof_command
+ *
+ * @brief function to run a console command.
+ *
+ * @param[in] cmd is the command, from @PROF_CMD, other characters are ignored.
+ * @param[in] sink is the output of the dump.
+ *
+ * @return void
+ */
+void prof_command(char cmd, fmt_sink_t* sink);
+
+/*****************************************************************************************************/
+/*                                       Scope helpers                                               */
+/*****************************************************************************************************/
+
+static inline prof_scope_t prof_scope_begin(prof_site_t* site){
+
+    prof_scope_t scope = {site, *DWT_CYCCNT};
+
+    return scope;
+}
+
+static inline void prof_scope_end(prof_scope_t* scope){
+
+    prof_record(scope->site, *DWT_CYCCNT - scope->start);
+}
+
+#endif /* PROF_H */
@@ -0,0 +1,211 @@
+/*****************************************************************************************************
+* FILENAME :        rtt.c
+*
+* DESCRIPTION :
+*       File containing the RAM ring buffer debug console.
+*
+* PUBLIC FUNCTIONS :
+*       void        rtt_init(void)
+*       void        rtt_config_up(uint8_t channel, const char* name, void* buf, uint32_t size, uint32_t flags)
+*       uint32_t    rtt_write(const char* buf, uint32_t len)
+*       uint32_t    rtt_write_up(uint8_t channel, const void* buf, uint32_t len)
+*       uint32_t    rtt_read(char* buf, uint32_t len)
+*       uint32_t    rtt_get_dropped(uint8_t channel)
+*       int         __io_putchar(int ch)
+*       int         __io_getchar(void)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*       __io_putchar and __io_getchar are the character hooks used by syscalls.c.
+*
+**/
+
+#include "rtt.h"
+#include "stm32f446xx.h"
+#include <stdint.h>
+#include <stddef.h>
+
+static char rtt_up_buf[RTT_UP_BUFFER_SIZE];
+static char rtt_down_buf[RTT_DOWN_BUFFER_SIZE];
+static uint32_t rtt_dropped[RTT_NUM_UP_BUFFERS];
+
+/* Found by the probe scanning the RAM for its ID */
+rtt_cb_t rtt_cb;
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void rtt_init(void){
+
+    static const char id[] = "SEGGER RTT";
+    uint8_t i = 0;
+
+    rtt_cb.MaxNumUpBuffers = RTT_NUM_UP_BUFFERS;
+    rtt_cb.MaxNumDownBuffers = RTT_NUM_DOWN_BUFFERS;
+
+    /* Channels other than the terminal stay empty until configured */
+    for(i = 0; i < RTT_NUM_UP_BUFFERS; i++){
+        rtt_cb.aUp[i].sName = NULL;
+        rtt_cb.aUp[i].pBuffer = NULL;
+        rtt_cb.aUp[i].SizeOfBuffer = 0;
+        rtt_cb.aUp[i].WrOff = 0;
+        rtt_cb.aUp[i].RdOff = 0;
+        rtt_cb.aUp[i].Flags = RTT_MODE_NO_BLOCK_SKIP;
+    }
+
+    rtt_cb.aUp[RTT_CHANNEL_TERMINAL].sName = "Terminal";
+    rtt_cb.aUp[RTT_CHANNEL_TERMINAL].pBuffer = rtt_up_buf;
+    rtt_cb.aUp[RTT_CHANNEL_TERMINAL].SizeOfBuffer = sizeof(rtt_up_buf);
+    rtt_cb.aUp[RTT_CHANNEL_TERMINAL].Flags = RTT_MODE_NO_BLOCK_TRIM;
+
+    rtt_cb.aDown[0].sName = "Terminal";
+    rtt_cb.aDown[0].pBuffer = rtt_down_buf;
+    rtt_cb.aDown[0].SizeOfBuffer = sizeof(rtt_down_buf);
+    rtt_cb.aDown[0].WrOff = 0;
+    rtt_cb.aDown[0].RdOff = 0;
+    rtt_cb.aDown[0].Flags = RTT_MODE_NO_BLOCK_SKIP;
+
+    /* The ID is written last, so the probe never finds a half initialized control block */
+    __asm volatile("dmb" ::: "memory");
+    for(i = 0; i < sizeof(id); i++){
+        rtt_cb.acID[i] = id[i];
+    }
+}
+
+void rtt_config_up(uint8_t channel, const char* name, void* buf, uint32_t size, uint32_t flags){
+
+    rtt_buffer_t* up = NULL;
+    uint32_t primask = 0;
+
+    if((channel == RTT_CHANNEL_TERMINAL) || (channel >= RTT_NUM_UP_BUFFERS)){
+        return;
+    }
+
+    up = &rtt_cb.aUp[channel];
+
+    if(rtt_cb.acID[0] == '\0'){
+        rtt_init();
+    }
+
+    primask = irq_lock();
+
+    /* The size is cleared first, so the probe never reads a half configured buffer */
+    up->SizeOfBuffer = 0;
+    __asm volatile("dmb" ::: "memory");
+    up->sName = name;
+    up->pBuffer = buf;
+    up->WrOff = 0;
+    up->RdOff = 0;
+    up->Flags = flags;
+    __asm volatile("dmb" ::: "memory");
+    up->SizeOfBuffer = size;
+
+    irq_unlock(primask);
+}
+
+uint32_t rtt_write(const char* buf, uint32_t len){
+
+    return rtt_write_up(RTT_CHANNEL_TERMINAL, buf, len);
+}
+
+uint32_t rtt_write_up(uint8_t channel, const void* buf, uint32_t len){
+
+    rtt_buffer_t* up = NULL;
+    const char* data = buf;
+    uint32_t primask = 0;
+    uint32_t rd = 0;
+    uint32_t wr = 0;
+    uint32_t avail = 0;
+    uint32_t i = 0;
+
+    if(channel >= RTT_NUM_UP_BUFFERS){
+        return 0;
+    }
+
+    up = &rtt_cb.aUp[channel];
+    primask = irq_lock();
+
+    if(rtt_cb.acID[0] == '\0'){
+        rtt_init();
+    }
+
+    if(up->SizeOfBuffer == 0){
+        irq_unlock(primask);
+        return 0;
+    }
+
+    rd = up->RdOff;
+    wr = up->WrOff;
+
+    /* One byte is kept free to tell a full buffer from an empty one */
+    avail = (rd > wr) ? (rd - wr - 1) : (up->SizeOfBuffer - (wr - rd) - 1);
+    if(len > avail){
+        rtt_dropped[channel] += (up->Flags == RTT_MODE_NO_BLOCK_SKIP) ? len : (len - avail);
+        len = (up->Flags == RTT_MODE_NO_BLOCK_SKIP) ? 0 : avail;
+    }
+
+    for(i = 0; i < len; i++){
+        up->pBuffer[wr++] = data[i];
+        if(wr == up->SizeOfBuffer){
+            wr = 0;
+        }
+    }
+
+    /* Publish the data before the new write offset */
+    __asm volatile("dmb" ::: "memory");
+    up->WrOff = wr;
+
+    irq_unlock(primask);
+
+    return len;
+}
+
+uint32_t rtt_read(char* buf, uint32_t len){
+
+    rtt_buffer_t* down = &rtt_cb.aDown[0];
+    uint32_t rd = down->RdOff;
+    uint32_t wr = down->WrOff;
+    uint32_t count = 0;
+
+    if(rtt_cb.acID[0] == '\0'){
+        return 0;
+    }
+
+    __asm volatile("dmb" ::: "memory");
+
+    while((rd != wr) && (count < len)){
+        buf[count++] = down->pBuffer[rd++];
+        if(rd == down->SizeOfBuffer){
+            rd = 0;
+        }
+    }
+
+    down->RdOff = rd;
+
+    return count;
+}
+
+uint32_t rtt_get_dropped(uint8_t channel){
+
+    return (channel < RTT_NUM_UP_BUFFERS) ? rtt_dropped[channel] : 0;
+}
+
+int __io_putchar(int ch){
+
+    char c = (char)ch;
+
+    rtt_write(&c, 1);
+
+    return ch;
+}
+
+int __io_getchar(void){
+
+    char c = 0;
+
+    /* Wait for the host */
+    while(rtt_read(&c, 1) == 0);
+
+    return c;
+}
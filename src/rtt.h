@@ -0,0 +1,171 @@
+/*****************************************************************************************************
+* FILENAME :        rtt.h
+*
+* DESCRIPTION :
+*       Header file containing the prototypes of the APIs for the RAM ring buffer debug console.
+*
+* PUBLIC FUNCTIONS :
+*       void        rtt_init(void)
+*       void        rtt_config_up(uint8_t channel, const char* name, void* buf, uint32_t size, uint32_t flags)
+*       uint32_t    rtt_write(const char* buf, uint32_t len)
+*       uint32_t    rtt_write_up(uint8_t channel, const void* buf, uint32_t len)
+*       uint32_t    rtt_read(char* buf, uint32_t len)
+*       uint32_t    rtt_get_dropped(uint8_t channel)
+*
+* NOTES :
+*       The control block uses the SEGGER RTT layout, so it can be read in the background by OpenOCD
+*       (rtt setup/start/server commands) or any RTT capable probe, without halting the core. The
+*       target only writes WrOff of the up buffer and the probe only writes RdOff, so no lock is
+*       shared with the probe. When an up buffer is full the output is trimmed or skipped, as set in
+*       its flags, and the dropped bytes are counted. Up channel 0 is the console, the others are
+*       configured by their users with rtt_config_up.
+*
+*       Layout (32 bit words):
+*           char acID[16]               "SEGGER RTT"
+*           int MaxNumUpBuffers         RTT_NUM_UP_BUFFERS
+*           int MaxNumDownBuffers       RTT_NUM_DOWN_BUFFERS
+*           rtt_buffer_t aUp[]          sName, pBuffer, SizeOfBuffer, WrOff, RdOff, Flags
+*           rtt_buffer_t aDown[]        same layout, the probe writes WrOff and the target RdOff
+*
+**/
+
+#ifndef RTT_H
+#define RTT_H
+
+#include <stdint.h>
+
+/**
+ * Application configurable items
+ */
+#define RTT_UP_BUFFER_SIZE          1024    /* Target to host console buffer */
+#define RTT_DOWN_BUFFER_SIZE        16      /* Host to target console buffer */
+
+#define RTT_NUM_UP_BUFFERS          2
+#define RTT_NUM_DOWN_BUFFERS        1
+
+/**
+ * @RTT_CHANNEL
+ * Up channels.
+ */
+#define RTT_CHANNEL_TERMINAL        0   /* Console, written by rtt_write */
+#define RTT_CHANNEL_TRACE           1   /* Binary trace log, see trace.h */
+
+/**
+ * @RTT_MODE
+ * Flags of the up buffer, what to do when it is full.
+ */
+#define RTT_MODE_NO_BLOCK_SKIP      0   /* Drop the whole write */
+#define RTT_MODE_NO_BLOCK_TRIM      1   /* Write what fits and drop the rest */
+#define RTT_MODE_BLOCK_IF_FULL      2   /* Wait for the probe, not supported by rtt_write */
+
+/**
+ * Ring buffer descriptor, SEGGER RTT layout.
+ */
+typedef struct
+{
+    const char* sName;
+    char* pBuffer;
+    uint32_t SizeOfBuffer;
+    volatile uint32_t WrOff;
+    volatile uint32_t RdOff;
+    uint32_t Flags;
+}rtt_buffer_t;
+
+/**
+ * Control block, SEGGER RTT layout.
+ */
+typedef struct
+{
+    char acID[16];
+    int32_t MaxNumUpBuffers;
+    int32_t MaxNumDownBuffers;
+    rtt_buffer_t aUp[RTT_NUM_UP_BUFFERS];
+    rtt_buffer_t aDown[RTT_NUM_DOWN_BUFFERS];
+}rtt_cb_t;
+
+/* Control block, defined in rtt.c */
+extern rtt_cb_t rtt_cb;
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn rtt_init
+ *
+ * @brief function to initialize the control block, it is also done by the first rtt_write.
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+void rtt_init(void);
+
+/**
+ * @fn rtt_config_up
+ *
+ * @brief function to set the buffer of an up channel.
+ *
+ * @param[in] channel from @RTT_CHANNEL, not the terminal one.
+ * @param[in] name shown by the probe.
+ * @param[in] buf is the ring buffer.
+ * @param[in] size of buf in bytes.
+ * @param[in] flags from @RTT_MODE.
+ *
+ * @return void
+ */
+void rtt_config_up(uint8_t channel, const char* name, void* buf, uint32_t size, uint32_t flags);
+
+/**
+ * @fn rtt_write
+ *
+ * @brief function to write data into the terminal up buffer (console output).
+ *
+ * @param[in] buf is the data to be written.
+ * @param[in] len is the number of bytes.
+ *
+ * @return number of bytes written, the rest is dropped.
+ *
+ * @note it never waits for the probe and it can be called from interrupt handlers.
+ */
+uint32_t rtt_write(const char* buf, uint32_t len);
+
+/**
+ * @fn rtt_write_up
+ *
+ * @brief function to write data into an up buffer.
+ *
+ * @param[in] channel from @RTT_CHANNEL.
+ * @param[in] buf is the data to be written.
+ * @param[in] len is the number of bytes.
+ *
+ * @return number of bytes written, 0 if the channel is not configured.
+ *
+ * @note it never waits for the probe and it can be called from interrupt handlers.
+ */
+uint32_t rtt_write_up(uint8_t channel, const void* buf, uint32_t len);
+
+/**
+ * @fn rtt_read
+ *
+ * @brief function to read data from the down buffer (console input).
+ *
+ * @param[out] buf where the data is stored.
+ * @param[in] len is the size of buf.
+ *
+ * @return number of bytes read, 0 if there is no data.
+ */
+uint32_t rtt_read(char* buf, uint32_t len);
+
+/**
+ * @fn rtt_get_dropped
+ *
+ * @brief function to get the number of bytes dropped because an up buffer was full.
+ *
+ * @param[in] channel from @RTT_CHANNEL.
+ *
+ * @return number of dropped bytes.
+ */
+uint32_t rtt_get_dropped(uint8_t channel);
+
+#endif /* RTT_H */
@@ -0,0 +1,268 @@
+/*****************************************************************************************************
+* FILENAME :        sched.c
+*
+* DESCRIPTION :
+*       File containing the cooperative task scheduler.
+*
+* PUBLIC FUNCTIONS :
+*       uint8_t     sched_add(const char* name, sched_task_fn_t fn, uint32_t period_ms)
+*       void        sched_start(uint8_t id, uint32_t delay_ms)
+*       void        sched_stop(uint8_t id)
+*       void        sched_tick(void)
+*       uint32_t    sched_get_ticks(void)
+*       uint8_t     sched_run(void)
+*       uint8_t     sched_get_stats(uint8_t id, sched_stats_t* stats)
+*       uint32_t    sched_get_idle_ticks(void)
+*       void        sched_advance(uint32_t ticks)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*       The ready queue is a list linked by task index and sorted by deadline. Deadlines are compared
+*       with a signed difference so the tick counter can wrap around. Run times are measured with the
+*       DWT cycle counter, which must be enabled by the application. sched_tick reads the first
+*       deadline while the main loop may be changing the queue: a stale value only moves the post
+*       of SCHED_EVENT to the next tick.
+*
+**/
+
+#include "sched.h"
+#include "event.h"
+#include "trace.h"
+#include "stm32f446xx.h"
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct
+{
+    sched_task_fn_t fn;
+    uint32_t deadline;
+    uint8_t next;       /* Next task in the ready queue */
+    uint8_t queued;
+    sched_stats_t stats;
+}sched_task_t;
+
+static sched_task_t sched_tasks[SCHED_MAX_TASKS];
+static uint8_t sched_num_tasks = 0;
+static volatile uint8_t sched_head = SCHED_INVALID_ID;
+static volatile uint32_t sched_ticks = 0;
+
+/*****************************************************************************************************/
+/*                                       Static Function Prototypes                                  */
+/*****************************************************************************************************/
+
+/**
+ * @fn sched_insert
+ *
+ * @brief function to insert a task in the ready queue by deadline, after the tasks with the same one.
+ *
+ * @param[in] id of the task.
+ *
+ * @return void.
+ */
+static void sched_insert(uint8_t id);
+
+/**
+ * @fn sched_remove
+ *
+ * @brief function to remove a task from the ready queue if it is queued.
+ *
+ * @param[in] id of the task.
+ *
+ * @return void.
+ */
+static void sched_remove(uint8_t id);
+
+/**
+ * @fn sched_post_due
+ *
+ * @brief function to post SCHED_EVENT if the first task of the ready queue is due.
+ *
+ * @param[in] void.
+ *
+ * @return void.
+ */
+static void sched_post_due(void);
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+uint8_t sched_add(const char* name, sched_task_fn_t fn, uint32_t period_ms){
+
+    sched_task_t* task = NULL;
+
+    if(sched_num_tasks >= SCHED_MAX_TASKS){
+        return SCHED_INVALID_ID;
+    }
+
+    task = &sched_tasks[sched_num_tasks];
+    task->fn = fn;
+    task->next = SCHED_INVALID_ID;
+    task->queued = 0;
+    task->stats.name = name;
+    task->stats.period_ms = period_ms;
+    task->stats.runs = 0;
+    task->stats.overruns = 0;
+    task->stats.cycles_max = 0;
+    task->stats.cycles_total = 0;
+
+    return sched_num_tasks++;
+}
+
+void sched_start(uint8_t id, uint32_t delay_ms){
+
+    if(id >= sched_num_tasks){
+        return;
+    }
+
+    sched_remove(id);
+    sched_tasks[id].deadline = sched_ticks + ((delay_ms * SCHED_TICK_HZ) / 1000);
+    sched_insert(id);
+
+    sched_post_due();
+}
+
+void sched_stop(uint8_t id){
+
+    if(id < sched_num_tasks){
+        sched_remove(id);
+    }
+}
+
+__RAMFUNC void sched_tick(void){
+
+    sched_ticks++;
+
+    sched_post_due();
+}
+
+uint32_t sched_get_ticks(void){
+
+    return sched_ticks;
+}
+
+uint8_t sched_run(void){
+
+    uint32_t now = sched_ticks;
+    uint32_t period = 0;
+    uint32_t start = 0;
+    uint32_t cycles = 0;
+    sched_task_t* task = NULL;
+    uint8_t id = 0;
+    uint8_t count = 0;
+
+    while(sched_head != SCHED_INVALID_ID){
+
+        id = sched_head;
+        task = &sched_tasks[id];
+
+        if((int32_t)(now - task->deadline) < 0){
+            break;
+        }
+
+        /* Pop the task */
+        sched_head = task->next;
+        task->queued = 0;
+
+        /* Periodic tasks are queued again before running, so they can stop themselves */
+        period = (task->stats.period_ms * SCHED_TICK_HZ) / 1000;
+        if(period != 0){
+            task->deadline += period;
+            if((int32_t)(now - task->deadline) >= 0){
+                /* A whole period was missed, do not try to catch up */
+                task->stats.overruns++;
+                TRACE("sched: task %u overrun at tick %u", id, now);
+                task->deadline = now + period;
+            }
+            sched_insert(id);
+        }
+
+        start = *DWT_CYCCNT;
+        task->fn();
+        cycles = *DWT_CYCCNT - start;
+
+        task->stats.runs++;
+        task->stats.cycles_total += cycles;
+        if(cycles > task->stats.cycles_max){
+            task->stats.cycles_max = cycles;
+        }
+
+        count++;
+    }
+
+    return count;
+}
+
+uint8_t sched_get_stats(uint8_t id, sched_stats_t* stats){
+
+    if(id >= sched_num_tasks){
+        return 1;
+    }
+
+    *stats = sched_tasks[id].stats;
+
+    return 0;
+}
+
+uint32_t sched_get_idle_ticks(void){
+
+    int32_t ticks = 0;
+
+    if(sched_head == SCHED_INVALID_ID){
+        return SCHED_IDLE_FOREVER;
+    }
+
+    ticks = (int32_t)(sched_tasks[sched_head].deadline - sched_ticks);
+
+    return (ticks > 0) ? (uint32_t)ticks : 0;
+}
+
+void sched_advance(uint32_t ticks){
+
+    sched_ticks += ticks;
+
+    sched_post_due();
+}
+
+/*****************************************************************************************************/
+/*                                       Static Function Definitions                                 */
+/*****************************************************************************************************/
+
+static void sched_insert(uint8_t id){
+
+    sched_task_t* task = &sched_tasks[id];
+    volatile uint8_t* link = &sched_head;
+
+    while((*link != SCHED_INVALID_ID) && ((int32_t)(task->deadline - sched_tasks[*link].deadline) >= 0)){
+        link = &sched_tasks[*link].next;
+    }
+
+    task->next = *link;
+    *link = id;
+    task->queued = 1;
+}
+
+static void sched_remove(uint8_t id){
+
+    volatile uint8_t* link = &sched_head;
+
+    if(!sched_tasks[id].queued){
+        return;
+    }
+
+    while(*link != id){
+        link = &sched_tasks[*link].next;
+    }
+
+    *link = sched_tasks[id].next;
+    sched_tasks[id].queued = 0;
+}
+
+static void sched_post_due(void){
+
+    uint8_t head = sched_head;
+
+    if((head != SCHED_INVALID_ID) && ((int32_t)(sched_ticks - sched_tasks[head].deadline) >= 0)){
+        event_post(SCHED_EVENT);
+    }
+}
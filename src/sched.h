@@ -0,0 +1,175 @@
+/*****************************************************************************************************
+* FILENAME :        sched.h
+*
+* DESCRIPTION :
+*       Header file containing the prototypes of the APIs for the cooperative task scheduler.
+*
+* PUBLIC FUNCTIONS :
+*       uint8_t     sched_add(const char* name, sched_task_fn_t fn, uint32_t period_ms)
+*       void        sched_start(uint8_t id, uint32_t delay_ms)
+*       void        sched_stop(uint8_t id)
+*       void        sched_tick(void)
+*       uint32_t    sched_get_ticks(void)
+*       uint8_t     sched_run(void)
+*       uint8_t     sched_get_stats(uint8_t id, sched_stats_t* stats)
+*       uint32_t    sched_get_idle_ticks(void)
+*       void        sched_advance(uint32_t ticks)
+*
+* NOTES :
+*       Tasks run to completion from the main loop (sched_run), so they must not block. The started
+*       tasks are kept in a ready queue ordered by deadline. sched_tick is the only function which can
+*       be called from an interrupt handler.
+*
+*       The scheduler is a source of the event dispatcher (event.h): SCHED_EVENT is posted whenever
+*       the first deadline is reached, by sched_tick, sched_start or sched_advance, and the
+*       application runs sched_run from its handler.
+*
+**/
+
+#ifndef SCHED_H
+#define SCHED_H
+
+#include <stdint.h>
+
+/**
+ * Application configurable items
+ */
+#define SCHED_MAX_TASKS         8
+#define SCHED_TICK_HZ           1000    /* sched_tick call rate, 1 tick is 1 ms */
+#define SCHED_EVENT             0       /* Event posted when a task is due */
+
+#define SCHED_INVALID_ID        0xFF
+#define SCHED_IDLE_FOREVER      0xFFFFFFFF
+
+/**
+ * Task function, run to completion.
+ */
+typedef void (*sched_task_fn_t)(void);
+
+/**
+ * Runtime accounting of a task.
+ */
+typedef struct
+{
+    const char* name;
+    uint32_t period_ms;     /* 0 for one-shot tasks */
+    uint32_t runs;          /* Number of runs */
+    uint32_t overruns;      /* Periodic runs started one period or more after their deadline */
+    uint32_t cycles_max;    /* Longest run in CPU cycles */
+    uint64_t cycles_total;  /* Sum of all runs in CPU cycles */
+}sched_stats_t;
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn sched_add
+ *
+ * @brief function to create a task, the task does not run until sched_start is called.
+ *
+ * @param[in] name of the task, used in the runtime accounting.
+ * @param[in] fn is the task function.
+ * @param[in] period_ms is the period of the task in ms, 0 for a one-shot task.
+ *
+ * @return task id or SCHED_INVALID_ID if there are no free tasks.
+ */
+uint8_t sched_add(const char* name, sched_task_fn_t fn, uint32_t period_ms);
+
+/**
+ * @fn sched_start
+ *
+ * @brief function to (re)start a task.
+ *
+ * @param[in] id of the task.
+ * @param[in] delay_ms is the time until the first run in ms, 0 to run in the next sched_run.
+ *
+ * @return void
+ *
+ * @note SCHED_EVENT is posted if the task is due at once.
+ */
+void sched_start(uint8_t id, uint32_t delay_ms);
+
+/**
+ * @fn sched_stop
+ *
+ * @brief function to remove a task from the ready queue.
+ *
+ * @param[in] id of the task.
+ *
+ * @return void
+ */
+void sched_stop(uint8_t id);
+
+/**
+ * @fn sched_tick
+ *
+ * @brief function to advance the scheduler time base, called from the SysTick handler.
+ *
+ * @param[in] void
+ *
+ * @return void
+ *
+ * @note SCHED_EVENT is posted on every tick while the first task is due.
+ */
+void sched_tick(void);
+
+/**
+ * @fn sched_get_ticks
+ *
+ * @brief function to get the scheduler time.
+ *
+ * @param[in] void
+ *
+ * @return number of ticks (ms) since start, it wraps around after 49 days.
+ */
+uint32_t sched_get_ticks(void);
+
+/**
+ * @fn sched_run
+ *
+ * @brief function to run all the tasks whose deadline has been reached, in deadline order.
+ *
+ * @param[in] void
+ *
+ * @return number of tasks run.
+ */
+uint8_t sched_run(void);
+
+/**
+ * @fn sched_get_stats
+ *
+ * @brief function to get the runtime accounting of a task.
+ *
+ * @param[in] id of the task.
+ * @param[out] stats where the accounting is copied.
+ *
+ * @return 0 if OK, 1 if the id is not valid.
+ */
+uint8_t sched_get_stats(uint8_t id, sched_stats_t* stats);
+
+/**
+ * @fn sched_get_idle_ticks
+ *
+ * @brief function to get the time until the next task deadline.
+ *
+ * @param[in] void
+ *
+ * @return number of ticks, 0 if a task is due or SCHED_IDLE_FOREVER if no task is started.
+ */
+uint32_t sched_get_idle_ticks(void);
+
+/**
+ * @fn sched_advance
+ *
+ * @brief function to advance the scheduler time base by the ticks suppressed during a tickless sleep.
+ *
+ * @param[in] ticks is the number of ticks to add.
+ *
+ * @return void
+ *
+ * @note it must be called with interrupts disabled, SCHED_EVENT is posted if a task is due.
+ */
+void sched_advance(uint32_t ticks);
+
+#endif /* SCHED_H */
@@ -0,0 +1,129 @@
+/*****************************************************************************************************
+* FILENAME :        spsc.c
+*
+* DESCRIPTION :
+*       File containing the single producer, single consumer lock-free ring buffer.
+*
+* PUBLIC FUNCTIONS :
+*       uint8_t     spsc_init(spsc_t* ring, void* buf, uint32_t elem_size, uint32_t capacity)
+*       uint32_t    spsc_push(spsc_t* ring, const void* elems, uint32_t count)
+*       uint32_t    spsc_pop(spsc_t* ring, void* elems, uint32_t count)
+*       uint32_t    spsc_peek(spsc_t* ring, void** elems)
+*       void        spsc_skip(spsc_t* ring, uint32_t count)
+*       uint32_t    spsc_count(const spsc_t* ring)
+*       uint32_t    spsc_space(const spsc_t* ring)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*       The own index is read with a plain load (only this side writes it), the other one with an
+*       acquire load; the own index is published with a release store after the copies.
+*
+**/
+
+#include "spsc.h"
+#include <stdint.h>
+#include <string.h>
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+uint8_t spsc_init(spsc_t* ring, void* buf, uint32_t elem_size, uint32_t capacity){
+
+    if((capacity == 0) || (capacity & (capacity - 1))){
+        return 1;
+    }
+
+    ring->buf = (uint8_t*)buf;
+    ring->elem_size = elem_size;
+    ring->mask = capacity - 1;
+    ring->head = 0;
+    ring->tail = 0;
+
+    return 0;
+}
+
+uint32_t spsc_push(spsc_t* ring, const void* elems, uint32_t count){
+
+    uint32_t head = ring->head;
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    uint32_t space = (ring->mask + 1) - (head - tail);
+    uint32_t start = head & ring->mask;
+    uint32_t first = 0;
+
+    if(count > space){
+        count = space;
+    }
+    if(count == 0){
+        return 0;
+    }
+
+    /* Up to the end of the buffer, then from the start */
+    first = ring->mask + 1 - start;
+    if(first > count){
+        first = count;
+    }
+    memcpy(&ring->buf[start * ring->elem_size], elems, first * ring->elem_size);
+    memcpy(ring->buf, (const uint8_t*)elems + (first * ring->elem_size), (count - first) * ring->elem_size);
+
+    __atomic_store_n(&ring->head, head + count, __ATOMIC_RELEASE);
+
+    return count;
+}
+
+uint32_t spsc_pop(spsc_t* ring, void* elems, uint32_t count){
+
+    uint32_t tail = ring->tail;
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    uint32_t start = tail & ring->mask;
+    uint32_t first = 0;
+
+    if(count > (head - tail)){
+        count = head - tail;
+    }
+    if(count == 0){
+        return 0;
+    }
+
+    first = ring->mask + 1 - start;
+    if(first > count){
+        first = count;
+    }
+    memcpy(elems, &ring->buf[start * ring->elem_size], first * ring->elem_size);
+    memcpy((uint8_t*)elems + (first * ring->elem_size), ring->buf, (count - first) * ring->elem_size);
+
+    __atomic_store_n(&ring->tail, tail + count, __ATOMIC_RELEASE);
+
+    return count;
+}
+
+uint32_t spsc_peek(spsc_t* ring, void** elems){
+
+    uint32_t tail = ring->tail;
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    uint32_t start = tail & ring->mask;
+    uint32_t count = head - tail;
+
+    if(count > (ring->mask + 1 - start)){
+        count = ring->mask + 1 - start;
+    }
+
+    *elems = &ring->buf[start * ring->elem_size];
+
+    return count;
+}
+
+void spsc_skip(spsc_t* ring, uint32_t count){
+
+    __atomic_store_n(&ring->tail, ring->tail + count, __ATOMIC_RELEASE);
+}
+
+uint32_t spsc_count(const spsc_t* ring){
+
+    return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+}
+
+uint32_t spsc_space(const spsc_t* ring){
+
+    return (ring->mask + 1) - spsc_count(ring);
+}
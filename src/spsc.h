@@ -0,0 +1,169 @@
+/*****************************************************************************************************
+* FILENAME :        spsc.h
+*
+* DESCRIPTION :
+*       Header file containing the single producer, single consumer lock-free ring buffer, used to
+*       hand data over between an interrupt handler and the main loop without disabling interrupts.
+*
+* PUBLIC FUNCTIONS :
+*       uint8_t     spsc_init(spsc_t* ring, void* buf, uint32_t elem_size, uint32_t capacity)
+*       uint32_t    spsc_push(spsc_t* ring, const void* elems, uint32_t count)
+*       uint32_t    spsc_pop(spsc_t* ring, void* elems, uint32_t count)
+*       uint32_t    spsc_peek(spsc_t* ring, void** elems)
+*       void        spsc_skip(spsc_t* ring, uint32_t count)
+*       uint32_t    spsc_count(const spsc_t* ring)
+*       uint32_t    spsc_space(const spsc_t* ring)
+*
+* NOTES :
+*       Example, bytes received by an interrupt handler and read by a task:
+*
+*           SPSC_DEFINE(rx_ring, uint8_t, 64);
+*
+*           void USART2_Handler(void){
+*               uint8_t c = USART2->DR;
+*               spsc_push(&rx_ring, &c, 1);
+*           }
+*
+*           void rx_task(void){
+*               uint8_t buf[16];
+*               uint32_t n = spsc_pop(&rx_ring, buf, sizeof(buf));
+*               ...
+*           }
+*
+*       Exactly one context pushes and one context pops (either of them can be a handler); the
+*       producer only writes head and the consumer only writes tail. Both indexes run freely and are
+*       masked on access, so the capacity must be a power of 2 and every slot is usable.
+*
+*       Each side loads the other index with acquire and publishes its own with release semantics
+*       (GCC atomic builtins, a DMB on the Cortex-M4), so the elements are written before the
+*       consumer can see them and read before the producer can reuse their slots, also when the
+*       other side is a DMA stream or the compiler reorders the copies. push and pop move a batch in
+*       at most two copies (before and after the end of the buffer) with one index update.
+*
+*       spsc_peek and spsc_skip give the consumer the contiguous elements in place, e.g. to start a
+*       DMA transfer from the buffer and release the slots in the transfer complete interrupt.
+*
+**/
+
+#ifndef SPSC_H
+#define SPSC_H
+
+#include <stdint.h>
+
+/**
+ * Ring buffer, the producer and consumer indexes are in separate words so each side only writes
+ * its own.
+ */
+typedef struct
+{
+    uint8_t* buf;                   /* capacity * elem_size bytes */
+    uint32_t elem_size;             /* Element size in bytes */
+    uint32_t mask;                  /* capacity - 1 */
+    volatile uint32_t head;         /* Elements pushed, written by the producer only */
+    volatile uint32_t tail;         /* Elements popped, written by the consumer only */
+}spsc_t;
+
+/**
+ * Define a ring buffer with a static, word aligned buffer of capacity elements of type.
+ */
+#define SPSC_DEFINE(name, type, capacity)                                                           \
+    _Static_assert(((capacity) != 0) && (((capacity) & ((capacity) - 1)) == 0),                     \
+                   #name " capacity must be a power of 2");                                         \
+    static type name##_buf[(capacity)] __attribute__((aligned(4)));                                 \
+    static spsc_t name = {(uint8_t*)name##_buf, sizeof(type), (capacity) - 1, 0, 0}
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn spsc_init
+ *
+ * @brief function to initialize an empty ring buffer.
+ *
+ * @param[out] ring is the ring buffer.
+ * @param[in] buf is the storage, capacity * elem_size bytes.
+ * @param[in] elem_size is the element size in bytes.
+ * @param[in] capacity is the number of elements, power of 2.
+ *
+ * @return 0 if OK, 1 if the capacity is not a power of 2.
+ *
+ * @note it must be called before the producer and the consumer start.
+ */
+uint8_t spsc_init(spsc_t* ring, void* buf, uint32_t elem_size, uint32_t capacity);
+
+/**
+ * @fn spsc_push
+ *
+ * @brief function to add elements at the head, producer side.
+ *
+ * @param[in] ring is the ring buffer.
+ * @param[in] elems is the first element to add.
+ * @param[in] count is the number of elements.
+ *
+ * @return number of elements added, less than count if the ring buffer is full.
+ */
+uint32_t spsc_push(spsc_t* ring, const void* elems, uint32_t count);
+
+/**
+ * @fn spsc_pop
+ *
+ * @brief function to remove elements from the tail, consumer side.
+ *
+ * @param[in] ring is the ring buffer.
+ * @param[out] elems is where the elements are copied.
+ * @param[in] count is the maximum number of elements.
+ *
+ * @return number of elements removed.
+ */
+uint32_t spsc_pop(spsc_t* ring, void* elems, uint32_t count);
+
+/**
+ * @fn spsc_peek
+ *
+ * @brief function to get the elements at the tail which are contiguous in the buffer, consumer side.
+ *
+ * @param[in] ring is the ring buffer.
+ * @param[out] elems is set to the first element.
+ *
+ * @return number of contiguous elements, 0 if the ring buffer is empty.
+ *
+ * @note the elements stay in the ring buffer until spsc_skip.
+ */
+uint32_t spsc_peek(spsc_t* ring, void** elems);
+
+/**
+ * @fn spsc_skip
+ *
+ * @brief function to remove elements from the tail without copying them, consumer side.
+ *
+ * @param[in] ring is the ring buffer.
+ * @param[in] count is the number of elements, at most spsc_count.
+ *
+ * @return void
+ */
+void spsc_skip(spsc_t* ring, uint32_t count);
+
+/**
+ * @fn spsc_count
+ *
+ * @brief function to get the number of elements in the ring buffer.
+ *
+ * @param[in] ring is the ring buffer.
+ *
+ * @return number of elements, exact for the consumer, a lower bound for the producer.
+ */
+uint32_t spsc_count(const spsc_t* ring);
+
+/**
+ * @fn spsc_space
+ *
+ * @brief function to get the number of free slots in the ring buffer.
+ *
+ * @param[in] ring is the ring buffer.
+ *
+ * @return number of free slots, exact for the producer, a lower bound for the consumer.
+ */
+uint32_t spsc_space(const spsc_t* ring);
+
+#endif /* SPSC_H */
@@ -0,0 +1,91 @@
+/*****************************************************************************************************
+* FILENAME :        stack.c
+*
+* DESCRIPTION :
+*       File containing the stack overflow guard and the stack usage measurement.
+*
+* PUBLIC FUNCTIONS :
+*       void        stack_paint(void)
+*       void        stack_guard_init(void)
+*       uint32_t    stack_get_size(void)
+*       uint32_t    stack_get_used(void)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+**/
+
+#include "stack.h"
+#include "stm32f446xx.h"
+#include <stdint.h>
+
+#define STACK_GUARD_REGION      0   /* MPU region number */
+
+/* Defined by the linker script */
+extern uint32_t _sguard;
+extern uint32_t _sstack;
+extern uint32_t _estack;
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void stack_paint(void){
+
+    uint32_t* pDst = &_sstack;
+    uint32_t* sp = 0;
+
+    __asm volatile("mov %0, sp" : "=r" (sp));
+
+    /* Nothing below the stack pointer is in use */
+    while(pDst < sp){
+        *pDst++ = STACK_PAINT_PATTERN;
+    }
+}
+
+void stack_guard_init(void){
+
+    uint32_t size = (uint32_t)&_sstack - (uint32_t)&_sguard;
+
+    *MPU_CTRL = 0;
+
+    /* Region size is 2^(SIZE + 1) bytes, the linker script checks size and alignment */
+    *MPU_RNR = STACK_GUARD_REGION;
+    *MPU_RBAR = (uint32_t)&_sguard;
+    *MPU_RASR = (1 << MPU_RASR_XN) | (0 << MPU_RASR_AP) |
+                ((uint32_t)(__builtin_ctz(size) - 1) << MPU_RASR_SIZE) | (1 << MPU_RASR_ENABLE);
+
+    /* Default memory map for everything else, MPU off in HardFault so the fault can be handled */
+    *MPU_CTRL = (1 << MPU_CTRL_PRIVDEFENA) | (1 << MPU_CTRL_ENABLE);
+    *SCB_SHCSR |= (1 << SCB_SHCSR_MEMFAULTENA);
+
+    __asm volatile("dsb\n\tisb" ::: "memory");
+}
+
+uint32_t stack_get_size(void){
+
+    return (uint32_t)&_estack - (uint32_t)&_sstack;
+}
+
+uint32_t stack_get_used(void){
+
+    uint32_t* pWord = &_sstack;
+
+    while((pWord < &_estack) && (*pWord == STACK_PAINT_PATTERN)){
+        pWord++;
+    }
+
+    return (uint32_t)&_estack - (uint32_t)pWord;
+}
+
+/*****************************************************************************************************/
+/*                                       Interrupt Handlers                                          */
+/*****************************************************************************************************/
+
+__attribute__((naked)) void MemManage_Handler(void){
+
+    /* Stack overflow into the guard region (SCB_CFSR MSTKERR or DACCVIOL with SCB_MMFAR in the guard)
+     * or another MPU violation. The stack cannot be trusted anymore, so nothing is pushed: stop here
+     * for the debugger */
+    __asm volatile("b .");
+}
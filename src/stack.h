@@ -0,0 +1,85 @@
+/*****************************************************************************************************
+* FILENAME :        stack.h
+*
+* DESCRIPTION :
+*       Header file containing the prototypes of the APIs for the stack overflow guard and the stack
+*       usage measurement.
+*
+* PUBLIC FUNCTIONS :
+*       void        stack_paint(void)
+*       void        stack_guard_init(void)
+*       uint32_t    stack_get_size(void)
+*       uint32_t    stack_get_used(void)
+*
+* NOTES :
+*       The stack and heap regions are defined by the linker script (STACK_SIZE, HEAP_SIZE), which
+*       fails the link if they do not fit in SRAM. An MPU region with no access (STACK_GUARD_SIZE
+*       bytes) sits just below the stack, so an overflow raises a MemManage fault instead of writing
+*       into the heap.
+*
+*       Reset_Handler fills the unused stack with STACK_PAINT_PATTERN, the high-water mark is the
+*       deepest word which does not hold the pattern anymore. A function which reserves space without
+*       writing all of it may be missed, so keep a margin.
+*
+**/
+
+#ifndef STACK_H
+#define STACK_H
+
+#include <stdint.h>
+
+#define STACK_PAINT_PATTERN     0xA5A5A5A5U
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn stack_paint
+ *
+ * @brief function to fill the stack below the current stack pointer with STACK_PAINT_PATTERN.
+ *
+ * @param[in] void
+ *
+ * @return void
+ *
+ * @note it uses neither .data nor .bss, it is called by Reset_Handler.
+ */
+void stack_paint(void);
+
+/**
+ * @fn stack_guard_init
+ *
+ * @brief function to configure the MPU guard region below the stack and enable the MemManage fault.
+ *
+ * @param[in] void
+ *
+ * @return void
+ *
+ * @note the rest of the memory map keeps the default attributes (PRIVDEFENA).
+ */
+void stack_guard_init(void);
+
+/**
+ * @fn stack_get_size
+ *
+ * @brief function to get the size of the stack region.
+ *
+ * @param[in] void
+ *
+ * @return size in bytes.
+ */
+uint32_t stack_get_size(void);
+
+/**
+ * @fn stack_get_used
+ *
+ * @brief function to get the stack high-water mark since reset.
+ *
+ * @param[in] void
+ *
+ * @return deepest stack usage in bytes.
+ */
+uint32_t stack_get_used(void);
+
+#endif /* STACK_H */
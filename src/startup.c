@@ -10,14 +10,16 @@
 **/
 
 #include <stdint.h>
-
-#define SRAM_START      0x20000000U
-#define SRAM_SIZE       (128U * 1024U) /* memory of 128Kb */
-#define SRAM_END        ((SRAM_START) + (SRAM_SIZE))
-
-#define STACK_START     SRAM_END
+#include "stm32f446xx.h"
+#include "boot.h"
+#include "sysclk.h"
+#include "stack.h"
 
 extern uint32_t _etext;
+extern uint32_t _estack;
+extern uint32_t _sramfunc;
+extern uint32_t _eramfunc;
+extern uint32_t _la_ramfunc;
 extern uint32_t _sdata;
 extern uint32_t _edata;
 extern uint32_t _la_data;
@@ -28,6 +30,7 @@ int main(void);
 void __libc_init_array(void);
 
 void Reset_Handler(void);
+static void copy_words(uint32_t* pDst, const uint32_t* pSrc, const uint32_t* pEnd);
 void NMI_Handler(void)                  __attribute__((weak, alias("Default_Handler")));
 void HardFault_Handler(void)            __attribute__((weak, alias("Default_Handler")));
 void MemManage_Handler(void)            __attribute__((weak, alias("Default_Handler")));
@@ -124,8 +127,8 @@ void SPDIF_Rx_Handler(void)             __attribute__((weak, alias("Default_Hand
 void FMPI2C1_Handler(void)              __attribute__((weak, alias("Default_Handler")));
 void FMPI2C1_error_Handler(void)        __attribute__((weak, alias("Default_Handler")));
 
-uint32_t vectors[] __attribute__((section(".isr_vector"))) = {
-    STACK_START,
+uint32_t vectors[] __attribute__((section(".isr_vector"), used)) = {
+    (uint32_t)&_estack,
     (uint32_t)Reset_Handler,
     (uint32_t)NMI_Handler,
     (uint32_t)HardFault_Handler,
@@ -245,24 +248,60 @@ void Default_Handler(void){
 }
 
 void Reset_Handler(void){
-    /* copy .data section to SRAM */
-    uint32_t size = (uint32_t)&_edata - (uint32_t)&_sdata;
-    uint8_t *pDst = (uint8_t*)&_sdata; /* sram */
-    uint8_t *pSrc = (uint8_t*)&_la_data; /* flash */
+    uint32_t *pDst = &_sbss; /* sram */
+    uint32_t data_cycles = 0;
 
-    for(uint32_t i = 0; i < size; i++){
-        *pDst++ = *pSrc++;
-    }
+    /* 180 MHz before anything else, so the initialization runs at full speed */
+    sysclk_init();
+
+    /* fill the unused stack for measuring its usage, and trap overflows with the MPU */
+    stack_paint();
+    stack_guard_init();
+
+    /* start the cycle counter, it timestamps the boot phases */
+    *DEMCR |= (1 << DEMCR_TRCENA);
+    *DWT_CYCCNT = 0;
+    *DWT_CTRL |= (1 << DWT_CTRL_CYCCNTENA);
+
+    /* copy .ramfunc and .data sections from flash to SRAM */
+    copy_words(&_sramfunc, &_la_ramfunc, &_eramfunc);
+    copy_words(&_sdata, &_la_data, &_edata);
+    data_cycles = *DWT_CYCCNT;
 
-    /* init the .bss section to zero in SRAM */
-    size = (uint32_t)&_ebss - (uint32_t)&_sbss;
-    pDst = (uint8_t*)&_sbss;
+    /* the copied code is fetched through another bus, complete the writes before it is called */
+    __asm volatile("dsb\n\tisb" ::: "memory");
 
-    for(uint32_t i = 0; i < size; i++){
-        *pDst++ = 0;
+    /* init the .bss section to zero in SRAM, four words at a time */
+    while(pDst < &_ebss){
+        pDst[0] = 0;
+        pDst[1] = 0;
+        pDst[2] = 0;
+        pDst[3] = 0;
+        pDst += 4;
     }
 
+    /* the clock source found by sysclk_init is kept in .bss too */
+    sysclk_save();
+
+    /* boot_cycles is in .bss, so the first timestamps are stored once it is zeroed */
+    boot_cycles[BOOT_PHASE_DATA] = data_cycles;
+    boot_mark(BOOT_PHASE_BSS);
+
     __libc_init_array();
 
+    boot_mark(BOOT_PHASE_MAIN);
+
     main();
 }
+
+static void copy_words(uint32_t* pDst, const uint32_t* pSrc, const uint32_t* pEnd){
+    /* four words at a time, start and end aligned by the linker script */
+    while(pDst < pEnd){
+        pDst[0] = pSrc[0];
+        pDst[1] = pSrc[1];
+        pDst[2] = pSrc[2];
+        pDst[3] = pSrc[3];
+        pDst += 4;
+        pSrc += 4;
+    }
+}
@@ -55,6 +55,9 @@
 #include <time.h>
 #include <sys/time.h>
 #include <sys/times.h>
+#include <stdint.h>
+#include "rtt.h"
+#include "uart_console.h"
 
 /* Variables */
 //#undef errno
@@ -103,13 +106,10 @@ return len;
 
 __attribute__((weak)) int _write(int file, char *ptr, int len)
 {
-	int DataIdx;
+	/* The whole buffer goes to the RTT and UART consoles at once, bytes which do not fit are dropped */
+	rtt_write(ptr, (uint32_t)len);
+	uart_console_write(ptr, (uint32_t)len);
 
-	for (DataIdx = 0; DataIdx < len; DataIdx++)
-	{
-		__io_putchar(*ptr++);
-		//ITM_SendChar(*ptr++);
-	}
 	return len;
 }
 
@@ -188,6 +188,7 @@ int _execve(char *name, char **argv, char **env)
 caddr_t _sbrk(int incr)
 {
 	extern char end asm("end");
+	extern char _eheap;
 	static char *heap_end;
 	char *prev_heap_end;
 
@@ -195,7 +196,8 @@ caddr_t _sbrk(int incr)
 		heap_end = &end;
 
 	prev_heap_end = heap_end;
-	if (heap_end + incr > stack_ptr)
+	/* Heap region defined by the linker script, it never reaches the stack */
+	if (heap_end + incr > &_eheap)
 	{
 		errno = ENOMEM;
 		return (caddr_t) -1;
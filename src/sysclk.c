@@ -0,0 +1,92 @@
+/*****************************************************************************************************
+* FILENAME :        sysclk.c
+*
+* DESCRIPTION :
+*       File containing the system clock configuration.
+*
+* PUBLIC FUNCTIONS :
+*       uint8_t sysclk_init(void)
+*       void    sysclk_save(void)
+*       uint8_t sysclk_restore(void)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+**/
+
+#include "sysclk.h"
+#include "rcc_driver.h"
+#include "stm32f446xx.h"
+#include <stdint.h>
+#include <stddef.h>
+
+/* HSE 8 MHz / 4 = 2 MHz VCO input, * 180 = 360 MHz VCO output, / 2 = 180 MHz */
+static const RCC_Config_t sysclk_hse_cfg = {
+    .RCC_ClkSource = RCC_CLK_SOURCE_PLL,
+    .RCC_PLLSource = RCC_CLK_SOURCE_HSE,
+    .RCC_HSEBypass = ENABLE,
+    .RCC_PLLM = 4,
+    .RCC_PLLN = 180,
+    .RCC_PLLP = 2,
+    .RCC_PLLQ = 8,
+    .RCC_AHBPrescaler = RCC_AHB_DIV1,
+    .RCC_APB1Prescaler = RCC_APB_DIV4,
+    .RCC_APB2Prescaler = RCC_APB_DIV2
+};
+
+/* HSI 16 MHz / 8 = 2 MHz VCO input, same PLL output */
+static const RCC_Config_t sysclk_hsi_cfg = {
+    .RCC_ClkSource = RCC_CLK_SOURCE_PLL,
+    .RCC_PLLSource = RCC_CLK_SOURCE_HSI,
+    .RCC_HSEBypass = DISABLE,
+    .RCC_PLLM = 8,
+    .RCC_PLLN = 180,
+    .RCC_PLLP = 2,
+    .RCC_PLLQ = 8,
+    .RCC_AHBPrescaler = RCC_AHB_DIV1,
+    .RCC_APB1Prescaler = RCC_APB_DIV4,
+    .RCC_APB2Prescaler = RCC_APB_DIV2
+};
+
+/* Configuration selected at boot, NULL until sysclk_save as it is in .bss */
+static const RCC_Config_t* sysclk_cfg = NULL;
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+uint8_t sysclk_init(void){
+
+    uint8_t status = RCC_ERR_HSE;
+
+    /* HSE is not probed again, a missing clock would cost RCC_READY_TIMEOUT on every call */
+    if(sysclk_cfg != NULL){
+        return RCC_ClockConfig(sysclk_cfg);
+    }
+
+    if(SYSCLK_USE_HSE){
+        status = RCC_ClockConfig(&sysclk_hse_cfg);
+    }
+
+    /* The ST-LINK MCO is not fitted on every board revision */
+    if(status == RCC_ERR_HSE){
+        status = RCC_ClockConfig(&sysclk_hsi_cfg);
+    }
+
+    return status;
+}
+
+uint8_t sysclk_restore(void){
+
+    if(sysclk_cfg == NULL){
+        return sysclk_init();
+    }
+
+    return RCC_ClockRestore(sysclk_cfg);
+}
+
+void sysclk_save(void){
+
+    /* PLLSRC is written by RCC_ClockConfig only once the PLL source is ready */
+    sysclk_cfg = (RCC->PLLCFGR & (1 << RCC_PLLCFGR_PLLSRC)) ? &sysclk_hse_cfg : &sysclk_hsi_cfg;
+}
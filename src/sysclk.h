@@ -0,0 +1,82 @@
+/*****************************************************************************************************
+* FILENAME :        sysclk.h
+*
+* DESCRIPTION :
+*       Header file containing the prototypes of the APIs for the system clock configuration.
+*
+* PUBLIC FUNCTIONS :
+*       uint8_t sysclk_init(void)
+*       void    sysclk_save(void)
+*       uint8_t sysclk_restore(void)
+*
+* NOTES :
+*       The core runs at 180 MHz from the main PLL, fed by the 8 MHz MCO of the ST-LINK (HSE bypass)
+*       or by HSI if there is no HSE clock. AHB 180 MHz, APB1 45 MHz (timers 90 MHz), APB2 90 MHz
+*       (timers 180 MHz), 5 flash wait states with prefetch and caches enabled.
+*
+*       sysclk_init is called by Reset_Handler, before .data and .bss are initialized. HSE bypass is
+*       probed once, at boot: Reset_Handler calls sysclk_save once .bss is initialized, and the later
+*       calls apply the configuration found then, without waiting for a missing HSE again. Every
+*       wakeup from Stop mode, which leaves HSI as system clock, calls sysclk_restore, which only
+*       starts that clock source and the PLL again. The frequencies are got from the RCC driver
+*       (RCC_GetHCLKValue and so on), never assumed.
+*
+**/
+
+#ifndef SYSCLK_H
+#define SYSCLK_H
+
+#include <stdint.h>
+
+/**
+ * Application configurable items
+ */
+#define SYSCLK_USE_HSE      1       /* Try HSE bypass first, 0 for always using HSI */
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn sysclk_init
+ *
+ * @brief function to configure the clock tree for running the core at 180 MHz.
+ *
+ * @param[in] void
+ *
+ * @return result of the last configuration tried, possible values from @RCC_STATUS.
+ *
+ * @note on error the system clock is HSI (16 MHz), every user of the clocks still works as the
+ *       frequencies are read from RCC.
+ */
+uint8_t sysclk_init(void);
+
+/**
+ * @fn sysclk_save
+ *
+ * @brief function to store the clock source selected by the first sysclk_init, HSE or HSI, so the
+ *        next calls of sysclk_init apply it without probing HSE.
+ *
+ * @param[in] void
+ *
+ * @return void
+ *
+ * @note it is called by Reset_Handler once .bss is initialized.
+ */
+void sysclk_save(void);
+
+/**
+ * @fn sysclk_restore
+ *
+ * @brief function to run the core at 180 MHz again after Stop mode, from the clock source stored by
+ *        sysclk_save.
+ *
+ * @param[in] void
+ *
+ * @return possible values from @RCC_STATUS.
+ *
+ * @note before sysclk_save it is sysclk_init.
+ */
+uint8_t sysclk_restore(void);
+
+#endif /* SYSCLK_H */
@@ -0,0 +1,171 @@
+/*****************************************************************************************************
+* FILENAME :        tickmon.c
+*
+* DESCRIPTION :
+*       File containing the tick monitor.
+*
+* PUBLIC FUNCTIONS :
+*       void    tickmon_init(uint32_t period_cycles)
+*       void    tickmon_entry(void)
+*       void    tickmon_exit(void)
+*       void    tickmon_resync(void)
+*       void    tickmon_get_stats(tickmon_stats_t* stats)
+*       void    tickmon_dump(fmt_sink_t* sink)
+*       void    tickmon_reset(void)
+*       void    tickmon_command(char cmd, fmt_sink_t* sink)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+**/
+
+#include "tickmon.h"
+#include "fmt.h"
+#include "stm32f446xx.h"
+#include <stdint.h>
+
+#if TICKMON_ENABLE
+
+static tickmon_stats_t tickmon_stats;
+static uint32_t tickmon_period = 1;
+
+/* Reference of the next tick, set by the handler */
+static uint8_t tickmon_synced = 0;
+static uint32_t tickmon_ideal = 0;          /* DWT value at the ideal time of the last tick */
+static uint32_t tickmon_latency = 0;        /* Entry latency of the last tick */
+static uint32_t tickmon_start = 0;          /* DWT value at the entry of the running handler */
+static uint8_t tickmon_counted = 0;         /* 1 if the running handler is counted in the stats */
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void tickmon_init(uint32_t period_cycles){
+
+    tickmon_period = period_cycles ? period_cycles : 1;
+    tickmon_reset();
+}
+
+__RAMFUNC void tickmon_entry(void){
+
+    uint32_t now = *DWT_CYCCNT;
+    uint32_t latency = *SYST_RVR - *SYST_CVR;
+    uint32_t ideal = now - latency;
+    uint32_t ticks = 0;
+    uint32_t jitter = 0;
+
+    tickmon_start = now;
+    tickmon_counted = tickmon_synced;
+
+    if(!tickmon_synced){
+        tickmon_synced = 1;
+        tickmon_stats.resyncs++;
+    }
+    else{
+        /* Ticks since the last handler, rounded, more than one means ticks were lost */
+        ticks = (ideal - tickmon_ideal + (tickmon_period / 2)) / tickmon_period;
+        if(ticks > 1){
+            tickmon_stats.missed += ticks - 1;
+        }
+
+        jitter = (latency > tickmon_latency) ? (latency - tickmon_latency) : (tickmon_latency - latency);
+        if(jitter > tickmon_stats.jitter_max){
+            tickmon_stats.jitter_max = jitter;
+        }
+
+        tickmon_stats.ticks++;
+        tickmon_stats.latency_total += latency;
+        if(latency < tickmon_stats.latency_min){
+            tickmon_stats.latency_min = latency;
+        }
+        if(latency > tickmon_stats.latency_max){
+            tickmon_stats.latency_max = latency;
+        }
+    }
+
+    tickmon_ideal = ideal;
+    tickmon_latency = latency;
+}
+
+__RAMFUNC void tickmon_exit(void){
+
+    uint32_t now = *DWT_CYCCNT;
+    uint32_t duration = now - tickmon_start;
+
+    if(!tickmon_counted){
+        return;
+    }
+
+    tickmon_stats.duration_total += duration;
+    if(duration > tickmon_stats.duration_max){
+        tickmon_stats.duration_max = duration;
+    }
+    if((now - tickmon_ideal) >= tickmon_period){
+        tickmon_stats.overruns++;
+    }
+}
+
+void tickmon_resync(void){
+
+    tickmon_synced = 0;
+}
+
+void tickmon_get_stats(tickmon_stats_t* stats){
+
+    uint32_t primask = irq_lock();
+
+    *stats = tickmon_stats;
+
+    irq_unlock(primask);
+}
+
+void tickmon_dump(fmt_sink_t* sink){
+
+    tickmon_stats_t stats;
+
+    tickmon_get_stats(&stats);
+
+    if(stats.ticks == 0){
+        fmt_printf(sink, "Tick: no ticks, %u resyncs\n", (unsigned int)stats.resyncs);
+        return;
+    }
+
+    fmt_printf(sink, "Tick latency: %u ticks, min %u, max %u, mean %u, jitter %u cycles\n",
+               (unsigned int)stats.ticks, (unsigned int)stats.latency_min, (unsigned int)stats.latency_max,
+               (unsigned int)(stats.latency_total / stats.ticks), (unsigned int)stats.jitter_max);
+    fmt_printf(sink, "Tick handler: max %u, mean %u cycles, %u overruns, %u missed, %u resyncs\n",
+               (unsigned int)stats.duration_max, (unsigned int)(stats.duration_total / stats.ticks),
+               (unsigned int)stats.overruns, (unsigned int)stats.missed, (unsigned int)stats.resyncs);
+}
+
+void tickmon_reset(void){
+
+    uint32_t primask = irq_lock();
+
+    tickmon_stats.ticks = 0;
+    tickmon_stats.latency_min = UINT32_MAX;
+    tickmon_stats.latency_max = 0;
+    tickmon_stats.latency_total = 0;
+    tickmon_stats.jitter_max = 0;
+    tickmon_stats.duration_max = 0;
+    tickmon_stats.duration_total = 0;
+    tickmon_stats.overruns = 0;
+    tickmon_stats.missed = 0;
+    tickmon_stats.resyncs = 0;
+    tickmon_synced = 0;
+
+    irq_unlock(primask);
+}
+
+void tickmon_command(char cmd, fmt_sink_t* sink){
+
+    if(cmd == TICKMON_CMD_DUMP){
+        tickmon_dump(sink);
+    }
+    else if(cmd == TICKMON_CMD_RESET){
+        tickmon_reset();
+        fmt_printf(sink, "Tick: cleared\n");
+    }
+}
+
+#endif /* TICKMON_ENABLE */
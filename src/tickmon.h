@@ -0,0 +1,186 @@
+/*****************************************************************************************************
+* FILENAME :        tickmon.h
+*
+* DESCRIPTION :
+*       Header file containing the tick monitor: it compares the entry and exit of Systick_Handler
+*       with the ideal tick time, and keeps the latency, jitter, handler duration, overruns and
+*       missed ticks.
+*
+* PUBLIC FUNCTIONS :
+*       void    tickmon_init(uint32_t period_cycles)
+*       void    tickmon_entry(void)
+*       void    tickmon_exit(void)
+*       void    tickmon_resync(void)
+*       void    tickmon_get_stats(tickmon_stats_t* stats)
+*       void    tickmon_dump(fmt_sink_t* sink)
+*       void    tickmon_reset(void)
+*       void    tickmon_command(char cmd, fmt_sink_t* sink)
+*
+* NOTES :
+*       The ideal time of a tick is the SysTick reload, found at handler entry from the cycles counted
+*       down since then (SYST_RVR - SYST_CVR). The entry latency is the time from that reload to
+*       tickmon_entry, the jitter is the change of latency from one tick to the next, and the
+*       duration (tickmon_entry to tickmon_exit) is the time the handler blocks the interrupts of the
+*       same or lower priority. A tick is:
+*           - overrun if the handler exits after the next ideal tick.
+*           - missed if no handler ran for it: the SysTick pending bit only holds one tick, so a
+*             handler delayed by more than a period loses ticks of the scheduler time base. They are
+*             found from the DWT cycle counter between two ideal tick times.
+*
+*       The tickless idle manager (idle.c) reprograms SysTick and the counters stop in Stop mode, so
+*       it calls tickmon_resync and the next tick only sets the reference.
+*
+*       TICKMON_ENABLE 0 (default) removes the hooks, the stats and the console commands. When it is
+*       enabled the stats task prints the stats, and the RTT console commands 't' and 'r' print and
+*       clear them. It can also be set from the command line (-DTICKMON_ENABLE=1).
+*
+**/
+
+#ifndef TICKMON_H
+#define TICKMON_H
+
+#include <stdint.h>
+#include "fmt.h"
+#include "stm32f446xx.h"
+
+/**
+ * Application configurable items
+ */
+#ifndef TICKMON_ENABLE
+#define TICKMON_ENABLE          0       /* 1 instruments Systick_Handler */
+#endif
+
+/**
+ * @TICKMON_CMD
+ * Console commands handled by tickmon_command.
+ */
+#define TICKMON_CMD_DUMP        't'     /* Print the stats */
+#define TICKMON_CMD_RESET       'r'     /* Clear the stats, same key as PROF_CMD_RESET */
+
+/**
+ * Tick stats since tickmon_init or the last reset, times in CPU cycles.
+ */
+typedef struct
+{
+    uint32_t ticks;         /* Measured ticks */
+    uint32_t latency_min;   /* Shortest entry latency */
+    uint32_t latency_max;   /* Longest entry latency */
+    uint64_t latency_total; /* Sum of the entry latencies */
+    uint32_t jitter_max;    /* Largest latency change between two consecutive ticks */
+    uint32_t duration_max;  /* Longest handler run */
+    uint64_t duration_total;/* Sum of the handler runs */
+    uint32_t overruns;      /* Handlers which exit after the next ideal tick */
+    uint32_t missed;        /* Ticks without handler run */
+    uint32_t resyncs;       /* Ticks used as reference after tickmon_resync */
+}tickmon_stats_t;
+
+/**
+ * Hooks, removed when TICKMON_ENABLE is 0.
+ */
+#if TICKMON_ENABLE
+#define TICKMON_ENTRY()         tickmon_entry()
+#define TICKMON_EXIT()          tickmon_exit()
+#define TICKMON_RESYNC()        tickmon_resync()
+#else
+#define TICKMON_ENTRY()         do{}while(0)
+#define TICKMON_EXIT()          do{}while(0)
+#define TICKMON_RESYNC()        do{}while(0)
+#endif
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn tickmon_init
+ *
+ * @brief function to clear the stats and set the tick period.
+ *
+ * @param[in] period_cycles is the SysTick period in CPU cycles (SYST_RVR + 1).
+ *
+ * @return void
+ */
+void tickmon_init(uint32_t period_cycles);
+
+/**
+ * @fn tickmon_entry
+ *
+ * @brief function to timestamp the entry of Systick_Handler, it must be its first statement.
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+__RAMFUNC void tickmon_entry(void);
+
+/**
+ * @fn tickmon_exit
+ *
+ * @brief function to timestamp the exit of Systick_Handler, it must be its last statement.
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+__RAMFUNC void tickmon_exit(void);
+
+/**
+ * @fn tickmon_resync
+ *
+ * @brief function to discard the reference tick, called when SysTick is reprogrammed.
+ *
+ * @param[in] void
+ *
+ * @return void
+ *
+ * @note it must be called with the interrupts disabled, before Systick_Handler can run again.
+ */
+void tickmon_resync(void);
+
+/**
+ * @fn tickmon_get_stats
+ *
+ * @brief function to get a copy of the stats.
+ *
+ * @param[out] stats is the copy.
+ *
+ * @return void
+ */
+void tickmon_get_stats(tickmon_stats_t* stats);
+
+/**
+ * @fn tickmon_dump
+ *
+ * @brief function to print the stats, one line with the latency and jitter and one line with the
+ *        handler duration, overruns and missed ticks.
+ *
+ * @param[in] sink is the output.
+ *
+ * @return void
+ */
+void tickmon_dump(fmt_sink_t* sink);
+
+/**
+ * @fn tickmon_reset
+ *
+ * @brief function to clear the stats, the next tick only sets the reference.
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+void tickmon_reset(void);
+
+/**
+ * @fn tickmon_command
+ *
+ * @brief function to run a console command.
+ *
+ * @param[in] cmd is the command, from @TICKMON_CMD, other characters are ignored.
+ * @param[in] sink is the output of the dump.
+ *
+ * @return void
+ */
+void tickmon_command(char cmd, fmt_sink_t* sink);
+
+#endif /* TICKMON_H */
@@ -0,0 +1,66 @@
+/*****************************************************************************************************
+* FILENAME :        timesnap.c
+*
+* DESCRIPTION :
+*       File containing the published date and time snapshot.
+*
+* PUBLIC FUNCTIONS :
+*       void        timesnap_publish(const RTC_time_t* time, const RTC_date_t* date)
+*       uint32_t    timesnap_read(RTC_time_t* time, RTC_date_t* date)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*       The readers use the copy selected by the low bit of the sequence. The fences (a DMB on the
+*       Cortex-M4) keep the copy updates between the sequence updates, and the reader copy between
+*       its two sequence loads.
+*
+**/
+
+#include "timesnap.h"
+#include "ds1307.h"
+#include <stdint.h>
+
+typedef struct
+{
+    RTC_time_t time;
+    RTC_date_t date;
+}timesnap_t;
+
+static timesnap_t timesnap_copies[2];
+static volatile uint32_t timesnap_seq = 0;
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void timesnap_publish(const RTC_time_t* time, const RTC_date_t* date){
+
+    uint32_t seq = timesnap_seq;
+
+    /* Readers move to copy 1 while copy 0 is updated */
+    __atomic_store_n(&timesnap_seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    timesnap_copies[0].time = *time;
+    timesnap_copies[0].date = *date;
+
+    /* Then back to copy 0 while copy 1 is updated */
+    __atomic_store_n(&timesnap_seq, seq + 2, __ATOMIC_RELEASE);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    timesnap_copies[1].time = *time;
+    timesnap_copies[1].date = *date;
+}
+
+uint32_t timesnap_read(RTC_time_t* time, RTC_date_t* date){
+
+    uint32_t seq = 0;
+
+    do{
+        seq = __atomic_load_n(&timesnap_seq, __ATOMIC_ACQUIRE);
+        *time = timesnap_copies[seq & 0x1].time;
+        *date = timesnap_copies[seq & 0x1].date;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    }while(__atomic_load_n(&timesnap_seq, __ATOMIC_RELAXED) != seq);
+
+    /* An odd sequence selects the copy of the previous publication */
+    return seq / 2;
+}
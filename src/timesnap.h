@@ -0,0 +1,58 @@
+/*****************************************************************************************************
+* FILENAME :        timesnap.h
+*
+* DESCRIPTION :
+*       Header file containing the published date and time snapshot: the RTC task publishes the last
+*       date and time read from the DS1307, and any task or interrupt handler reads a consistent copy
+*       without using the I2C bus.
+*
+* PUBLIC FUNCTIONS :
+*       void        timesnap_publish(const RTC_time_t* time, const RTC_date_t* date)
+*       uint32_t    timesnap_read(RTC_time_t* time, RTC_date_t* date)
+*
+* NOTES :
+*       The snapshot is a sequence lock with two copies (latch): the writer increments the sequence,
+*       updates the copy the readers are not using, increments it again and updates the other one.
+*       A reader copies the slot selected by the sequence and retries only if the sequence changed
+*       in the meantime, so it never waits for a writer it preempted, and neither side masks
+*       interrupts. A reader preempted by the writer retries once.
+*
+*       A single context (the RTC task) may publish.
+*
+**/
+
+#ifndef TIMESNAP_H
+#define TIMESNAP_H
+
+#include <stdint.h>
+#include "ds1307.h"
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn timesnap_publish
+ *
+ * @brief function to publish a new date and time.
+ *
+ * @param[in] time is the time read from the RTC.
+ * @param[in] date is the date read from the RTC.
+ *
+ * @return void
+ */
+void timesnap_publish(const RTC_time_t* time, const RTC_date_t* date);
+
+/**
+ * @fn timesnap_read
+ *
+ * @brief function to get a copy of the last published date and time, from any context.
+ *
+ * @param[out] time is the copy of the time.
+ * @param[out] date is the copy of the date.
+ *
+ * @return number of publications so far, 0 if nothing was published (time and date are zero).
+ */
+uint32_t timesnap_read(RTC_time_t* time, RTC_date_t* date);
+
+#endif /* TIMESNAP_H */
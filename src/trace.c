@@ -0,0 +1,84 @@
+/*****************************************************************************************************
+* FILENAME :        trace.c
+*
+* DESCRIPTION :
+*       File containing the deferred formatting binary trace log.
+*
+* PUBLIC FUNCTIONS :
+*       void        trace_init(void)
+*       void        trace_write(uint32_t id, const uint32_t* args, uint32_t nargs)
+*       uint32_t    trace_get_dropped(void)
+*
+* NOTES :
+*       For further information about functions refer to the corresponding header file.
+*
+**/
+
+#include "trace.h"
+#include "rtt.h"
+#include "stm32f446xx.h"
+#include <stdint.h>
+
+#if (TRACE_BUFFER_WORDS & (TRACE_BUFFER_WORDS - 1))
+#error "TRACE_BUFFER_WORDS must be a power of 2"
+#endif
+
+static uint32_t trace_buf[TRACE_BUFFER_WORDS];
+static uint32_t trace_dropped = 0;
+
+/*****************************************************************************************************/
+/*                                       Public API Definitions                                      */
+/*****************************************************************************************************/
+
+void trace_init(void){
+
+    rtt_config_up(RTT_CHANNEL_TRACE, "Trace", trace_buf, sizeof(trace_buf), RTT_MODE_NO_BLOCK_SKIP);
+}
+
+void trace_write(uint32_t id, const uint32_t* args, uint32_t nargs){
+
+    rtt_buffer_t* up = &rtt_cb.aUp[RTT_CHANNEL_TRACE];
+    uint32_t primask = irq_lock();
+    uint32_t wr = 0;
+    uint32_t rd = 0;
+    uint32_t avail = 0;
+    uint32_t i = 0;
+
+    if(up->pBuffer != (char*)trace_buf){
+        trace_dropped++;
+        irq_unlock(primask);
+        return;
+    }
+
+    /* The target always writes whole words, the probe may leave RdOff in the middle of one */
+    wr = up->WrOff;
+    rd = up->RdOff;
+    avail = ((rd > wr) ? (rd - wr - 1) : (sizeof(trace_buf) - (wr - rd) - 1)) / sizeof(uint32_t);
+
+    if(avail < (nargs + 2)){
+        trace_dropped++;
+        irq_unlock(primask);
+        return;
+    }
+
+    wr /= sizeof(uint32_t);
+    trace_buf[wr] = (TRACE_SYNC << TRACE_SYNC_POS) | (nargs << TRACE_NARGS_POS) | (id & TRACE_ID_MASK);
+    wr = (wr + 1) & (TRACE_BUFFER_WORDS - 1);
+    trace_buf[wr] = *DWT_CYCCNT;
+    wr = (wr + 1) & (TRACE_BUFFER_WORDS - 1);
+    for(i = 0; i < nargs; i++){
+        trace_buf[wr] = args[i];
+        wr = (wr + 1) & (TRACE_BUFFER_WORDS - 1);
+    }
+
+    /* Publish the record before the new write offset */
+    __asm volatile("dmb" ::: "memory");
+    up->WrOff = wr * sizeof(uint32_t);
+
+    irq_unlock(primask);
+}
+
+uint32_t trace_get_dropped(void){
+
+    return trace_dropped;
+}
@@ -0,0 +1,115 @@
+/*****************************************************************************************************
+* FILENAME :        trace.h
+*
+* DESCRIPTION :
+*       Header file containing the deferred formatting binary trace log. TRACE records the message
+*       ID, a cycle counter timestamp and the raw arguments, the text is built on the host by
+*       host/trace_decode using the format strings kept in the ELF file.
+*
+* PUBLIC FUNCTIONS :
+*       void        trace_init(void)
+*       void        trace_write(uint32_t id, const uint32_t* args, uint32_t nargs)
+*       uint32_t    trace_get_dropped(void)
+*
+* NOTES :
+*       Example:
+*
+*           TRACE("rtc %02u:%02u:%02u", time.hours, time.minutes, time.seconds);
+*
+*       The format string is placed in the .trace_fmt section, which is not loaded in the target
+*       (see the linker script), and its address in that section is the message ID. The arguments
+*       are stored as 32 bit integers, so only the %d %i %u %x %X %c conversions (with the flags and
+*       width supported by fmt.h) can be decoded.
+*
+*       The records are streamed by the RTT up channel RTT_CHANNEL_TRACE (see rtt.h). A record is
+*       dropped as a whole when the buffer is full. Record layout (32 bit little endian words):
+*           header          TRACE_SYNC << 24 | nargs << 20 | message ID
+*           timestamp       DWT cycle counter
+*           args[nargs]
+*
+*       The cycle counter does not count in Stop mode (see idle.h), so the time spent there is
+*       missing from the timestamps.
+*
+**/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+/**
+ * Application configurable items
+ */
+#define TRACE_ENABLE            1       /* 0 removes every TRACE call */
+#define TRACE_BUFFER_WORDS      256     /* Ring buffer size, power of 2 */
+#define TRACE_MAX_ARGS          4
+
+/**
+ * Record header fields.
+ */
+#define TRACE_SYNC              0xA5
+#define TRACE_SYNC_POS          24
+#define TRACE_NARGS_POS         20
+#define TRACE_ID_MASK           0x000FFFFF
+
+/**
+ * Log a message, the format string must be a string literal.
+ */
+#if TRACE_ENABLE
+#define TRACE(fmt, ...)                                                                             \
+    do{                                                                                             \
+        static const char trace_fmt_str[] __attribute__((section(".trace_fmt"), used)) = fmt;     \
+        const uint32_t trace_args[] = {0, ##__VA_ARGS__};                                           \
+        _Static_assert(sizeof(trace_args) <= ((TRACE_MAX_ARGS + 1) * sizeof(uint32_t)),            \
+                       "TRACE: too many arguments");                                                \
+        trace_write((uint32_t)(uintptr_t)trace_fmt_str, &trace_args[1],                             \
+                    (sizeof(trace_args) / sizeof(uint32_t)) - 1);                                   \
+    }while(0)
+#else
+#define TRACE(fmt, ...)         do{}while(0)
+#endif
+
+/*****************************************************************************************************/
+/*                                       APIs Supported                                              */
+/*****************************************************************************************************/
+
+/**
+ * @fn trace_init
+ *
+ * @brief function to register the trace buffer as an RTT up channel.
+ *
+ * @param[in] void
+ *
+ * @return void
+ *
+ * @note the DWT cycle counter must be enabled for the timestamps.
+ */
+void trace_init(void);
+
+/**
+ * @fn trace_write
+ *
+ * @brief function to store a record, it is called by TRACE.
+ *
+ * @param[in] id is the address of the format string in the .trace_fmt section.
+ * @param[in] args are the arguments.
+ * @param[in] nargs is the number of arguments, up to TRACE_MAX_ARGS.
+ *
+ * @return void
+ *
+ * @note it never waits and it can be called from interrupt handlers.
+ */
+void trace_write(uint32_t id, const uint32_t* args, uint32_t nargs);
+
+/**
+ * @fn trace_get_dropped
+ *
+ * @brief function to get the number of records dropped because the buffer was full.
+ *
+ * @param[in] void
+ *
+ * @return number of dropped records.
+ */
+uint32_t trace_get_dropped(void);
+
+#endif /* TRACE_H */